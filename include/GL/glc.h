@@ -323,6 +323,57 @@ GLCAPI void APIENTRY glcRenderParameterfQSO(GLenum inAttrib, GLfloat inVal);
 #define GLC_QSO_render_pixmap
 #define GLC_PIXMAP_QSO                            0x8011
 
+#define GLC_QSO_buffer_sub_data                   1
+#define GLC_BUFFER_SUB_DATA_QSO                   0x8012
+
+#define GLC_QSO_texture_budget                    1
+#define GLC_TEXTURE_BUDGET_QSO                    0x8013
+
+#define GLC_QSO_bitmap_cache                      1
+#define GLC_BITMAP_CACHE_SIZE_QSO                 0x8014
+
+#define GLC_QSO_composite_pixmap                  1
+#define GLC_COMPOSITE_PIXMAP_QSO                  0x8015
+
+#define GLC_QSO_user_transform                    1
+#define GLC_USER_TRANSFORM_QSO                    0x8016
+GLCAPI void APIENTRY glcLoadTransformQSO(const GLint* inViewport,
+					 const GLfloat* inModelview,
+					 const GLfloat* inProjection);
+
+#define GLC_QSO_embedded_bitmap                   1
+#define GLC_EMBEDDED_BITMAP_QSO                   0x8017
+
+#define GLC_QSO_hinting_profile                   1
+#define GLC_HINTING_PROFILE_QSO                   0x8018
+#define GLC_HINTING_NATIVE_QSO                    0x8019
+#define GLC_HINTING_LIGHT_AUTO_QSO                0x801A
+#define GLC_HINTING_FULL_AUTO_QSO                 0x801B
+#define GLC_HINTING_NONE_QSO                      0x801C
+
+#define GLC_QSO_render_buffer                     1
+GLCAPI void APIENTRY glcRenderStringToBufferQSO(const GLCchar* inString,
+						GLfloat inX, GLfloat inY,
+						GLenum inFormat,
+						GLint inWidth,
+						GLint inHeight,
+						GLint inStride,
+						GLvoid* outBuffer,
+						const GLfloat* inColor);
+
+#define GLC_QSO_render_strings                    1
+GLCAPI void APIENTRY glcRenderStringsQSO(GLint inCount,
+					 const GLCchar** inStrings,
+					 const GLfloat* inOrigins,
+					 const GLfloat* inColors);
+
+#define GLC_QSO_text_object                       1
+GLCAPI GLuint APIENTRY glcGenTextObjectQSO(void);
+GLCAPI void APIENTRY glcDeleteTextObjectQSO(GLuint inTextObject);
+GLCAPI void APIENTRY glcCompileStringQSO(GLuint inTextObject,
+					 const GLCchar* inString);
+GLCAPI void APIENTRY glcCallTextObjectQSO(GLuint inTextObject);
+
 #if defined (__cplusplus)
 }
 #endif
@@ -0,0 +1,398 @@
+/* QuesoGLC
+ * A free implementation of the OpenGL Character Renderer (GLC)
+ * Copyright (c) 2002, 2004-2009, Bertrand Coconnier
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+/* $Id$ */
+
+/** \file
+ *  defines the cache of the bitmaps used to render characters with GLC_BITMAP
+ *  and GLC_PIXMAP_QSO.
+ *
+ *  Rasterizing a glyph with FreeType is much more expensive than drawing it
+ *  with glBitmap() or glDrawPixels(). The bitmaps are then kept in a cache
+ *  which size is bounded by GLC_BITMAP_CACHE_SIZE_QSO : when the cache is
+ *  full, the bitmaps that have been the least recently used are released.
+ *  The bitmaps are looked up in a hash table and are linked in a LRU list
+ *  (the most recently used bitmaps are stored at the head of the list).
+ */
+
+#include "internal.h"
+#include "bitmap.h"
+
+
+
+/* Amount of memory used by a bitmap of the cache */
+static GLint __glcBitmapCacheMemory(const __GLCbitmap* This)
+{
+  GLint width = This->width;
+
+  /* GLC_BITMAP uses 1 bit per pixel */
+  if (This->key.renderStyle == GLC_BITMAP)
+    width >>= 3;
+
+  return sizeof(__GLCbitmap) + width * This->height;
+}
+
+
+
+/* Return the size in pixels of the embedded bitmaps that are used to render
+ * the glyphes in the current state of the context, or 0 if the glyphes must be
+ * rasterized from their outlines. The embedded bitmaps are only used by
+ * GLC_BITMAP when the bitmap matrix scales the glyphes uniformly to an integer
+ * number of pixels.
+ */
+static GLint __glcBitmapCacheGetStrikeSize(const __GLCcontext* inContext)
+{
+  const GLfloat* transform = inContext->bitmapMatrix;
+  FT_F26Dot6 size = 0;
+
+  if (!inContext->enableState.embeddedBitmap
+      || (inContext->renderState.renderStyle != GLC_BITMAP)
+      || (transform[1] != 0.f) || (transform[2] != 0.f)
+      || (transform[0] != transform[3]) || (transform[0] <= 0.f))
+    return 0;
+
+  /* See __glcFaceDescPrepareFont() for the resolution */
+  if (inContext->enableState.glObjects)
+    size = (FT_F26Dot6)(transform[0] * 64. + 0.5);
+  else
+    size = (FT_F26Dot6)(transform[0] * 64. * inContext->renderState.resolution
+			/ 72. + 0.5);
+
+  /* The strikes have an integer number of pixels per EM */
+  if (size & 63)
+    return 0;
+
+  return (GLint)(size >> 6);
+}
+
+
+
+/* Build the key of the bitmap of the glyph 'inGlyphIndex' for the current
+ * state of the context.
+ */
+static void __glcBitmapCacheMakeKey(const __GLCcontext* inContext,
+				    const __GLCfont* inFont,
+				    const GLCulong inGlyphIndex,
+				    const GLfloat inScaleX,
+				    const GLfloat inScaleY,
+				    __GLCbitmapKey* outKey)
+{
+  const GLfloat* transform = inContext->bitmapMatrix;
+
+  /* Clear the padding bytes so that the keys can be compared with memcmp() */
+  memset(outKey, 0, sizeof(__GLCbitmapKey));
+
+  outKey->faceDesc = inFont->faceDesc;
+  outKey->glyphIndex = inGlyphIndex;
+  outKey->renderStyle = inContext->renderState.renderStyle;
+
+  /* See __glcFaceDescPrepareGlyph() and __glcFaceDescPrepareFont() */
+  outKey->hinting = GLC_GET_HINTING_PROFILE(inContext);
+  outKey->resolution = inContext->enableState.glObjects ? 72
+    : (GLint)inContext->renderState.resolution;
+  outKey->size[0] = (FT_F26Dot6)(inScaleX * 64.);
+  outKey->size[1] = (FT_F26Dot6)(inScaleY * 64.);
+  outKey->strikeSize = __glcBitmapCacheGetStrikeSize(inContext);
+
+  /* See __glcFaceDescGetBitmapSize() */
+  outKey->matrix[0] = (FT_Fixed)(transform[0] * 65536. / inScaleX);
+  outKey->matrix[1] = (FT_Fixed)(transform[2] * 65536. / inScaleY);
+  outKey->matrix[2] = (FT_Fixed)(transform[1] * 65536. / inScaleX);
+  outKey->matrix[3] = (FT_Fixed)(transform[3] * 65536. / inScaleY);
+}
+
+
+
+/* Compute the index of the hash bucket of a key */
+static GLuint __glcBitmapCacheHash(const __GLCbitmapKey* inKey)
+{
+  GLuint hash = (GLuint)((size_t)inKey->faceDesc >> 4);
+  int i = 0;
+
+  hash = hash * 31 + (GLuint)inKey->glyphIndex;
+  hash = hash * 31 + (GLuint)inKey->size[0];
+  hash = hash * 31 + (GLuint)inKey->size[1];
+  for (i = 0; i < 4; i++)
+    hash = hash * 31 + (GLuint)inKey->matrix[i];
+  hash = hash * 31 + (GLuint)inKey->renderStyle;
+
+  hash ^= hash >> 16;
+  hash ^= hash >> 8;
+
+  return hash & (GLC_BITMAP_HASH_SIZE - 1);
+}
+
+
+
+/* Remove a bitmap from the cache and release its memory */
+static void __glcBitmapCacheRemove(__GLCcontext* inContext,
+				   __GLCbitmap* This)
+{
+  __GLCbitmap** bucket =
+    &inContext->bitmapHash[__glcBitmapCacheHash(&This->key)];
+
+  while (*bucket != This) {
+    assert(*bucket);
+    bucket = &(*bucket)->next;
+  }
+  *bucket = This->next;
+
+  FT_List_Remove(&inContext->bitmapList, (FT_ListNode)This);
+  inContext->bitmapCacheUsed -= __glcBitmapCacheMemory(This);
+  __glcFree(This);
+}
+
+
+
+/* Look for the bitmap of the glyph 'inGlyphIndex' in the cache. If it is found
+ * then it is moved to the head of the LRU list and returned. Otherwise the
+ * function returns NULL. The glyph does not need to be loaded in the face.
+ */
+__GLCbitmap* __glcBitmapCacheLookup(__GLCcontext* inContext,
+				    const __GLCfont* inFont,
+				    const GLCulong inGlyphIndex,
+				    const GLfloat inScaleX,
+				    const GLfloat inScaleY)
+{
+  __GLCbitmapKey key;
+  __GLCbitmap* bitmap = NULL;
+
+  if (!inContext->bitmapList.head)
+    return NULL;
+
+  __glcBitmapCacheMakeKey(inContext, inFont, inGlyphIndex, inScaleX, inScaleY,
+			  &key);
+
+  for (bitmap = inContext->bitmapHash[__glcBitmapCacheHash(&key)]; bitmap;
+       bitmap = bitmap->next) {
+    if (!memcmp(&bitmap->key, &key, sizeof(__GLCbitmapKey))) {
+      FT_List_Up(&inContext->bitmapList, (FT_ListNode)bitmap);
+      return bitmap;
+    }
+  }
+
+  return NULL;
+}
+
+
+
+/* Store the bitmap 'This' in the cache. If the bitmap does not fit in the
+ * cache, it is not stored and it must be released by __glcBitmapCacheRelease()
+ * once it has been drawn.
+ */
+static __GLCbitmap* __glcBitmapCacheInsert(__GLCcontext* inContext,
+					   __GLCbitmap* This)
+{
+  const GLint memory = __glcBitmapCacheMemory(This);
+  __GLCbitmap** bucket = NULL;
+
+  if (memory > inContext->renderState.bitmapCacheSize)
+    return This;
+
+  /* Release the least recently used bitmaps to make room for the new one */
+  __glcBitmapCacheTrim(inContext,
+		       inContext->renderState.bitmapCacheSize - memory);
+
+  bucket = &inContext->bitmapHash[__glcBitmapCacheHash(&This->key)];
+  This->next = *bucket;
+  *bucket = This;
+
+  This->node.data = This;
+  FT_List_Insert(&inContext->bitmapList, (FT_ListNode)This);
+  inContext->bitmapCacheUsed += memory;
+  This->isCached = GL_TRUE;
+
+  return This;
+}
+
+
+
+/* Render the glyph 'inGlyphIndex' in a new bitmap and store it in the cache.
+ * The glyph must have been loaded in the face. If the bitmap does not fit in
+ * the cache, it is not stored and it must be released by
+ * __glcBitmapCacheRelease() once it has been drawn.
+ */
+__GLCbitmap* __glcBitmapCacheRender(__GLCcontext* inContext,
+				    const __GLCfont* inFont,
+				    const GLCulong inGlyphIndex,
+				    const GLfloat inScaleX,
+				    const GLfloat inScaleY)
+{
+  __GLCbitmap* This = NULL;
+  GLint pixWidth = 0, pixHeight = 0;
+  GLint pixBoundingBox[4] = {0, 0, 0, 0};
+  GLint memory = 0;
+
+  __glcFontGetBitmapSize(inFont, &pixWidth, &pixHeight, inScaleX, inScaleY, 0,
+			 pixBoundingBox, inContext);
+
+  memory = (inContext->renderState.renderStyle == GLC_BITMAP) ?
+    (pixWidth >> 3) * pixHeight : pixWidth * pixHeight;
+
+  This = (__GLCbitmap*)__glcMalloc(sizeof(__GLCbitmap) + memory);
+  if (!This) {
+    __glcRaiseError(GLC_RESOURCE_ERROR);
+    return NULL;
+  }
+
+  __glcBitmapCacheMakeKey(inContext, inFont, inGlyphIndex, inScaleX, inScaleY,
+			  &This->key);
+  This->width = pixWidth;
+  This->height = pixHeight;
+  memcpy(This->boundingBox, pixBoundingBox, 4 * sizeof(GLint));
+  This->buffer = (GLubyte*)(This + 1);
+  This->next = NULL;
+  This->isCached = GL_FALSE;
+
+  /* render the glyph */
+  if (!__glcFontGetBitmap(inFont, pixWidth, pixHeight, This->buffer,
+			  inContext)) {
+    __glcFree(This);
+    return NULL;
+  }
+
+  return __glcBitmapCacheInsert(inContext, This);
+}
+
+
+
+/* Copy the embedded bitmap of the glyph 'inGlyphIndex' in a new bitmap and
+ * store it in the cache. NULL is returned if the embedded bitmaps can not be
+ * used in the current state of the context or if the face has no embedded
+ * bitmap of the glyph at the current size : the glyph must then be rendered by
+ * __glcBitmapCacheRender(). The glyph does not need to be loaded in the face.
+ */
+__GLCbitmap* __glcBitmapCacheRenderStrike(__GLCcontext* inContext,
+					  const __GLCfont* inFont,
+					  const GLCulong inGlyphIndex,
+					  const GLfloat inScaleX,
+					  const GLfloat inScaleY)
+{
+  const GLint strikeSize = __glcBitmapCacheGetStrikeSize(inContext);
+  __GLCfaceDescriptor* faceDesc = inFont->faceDesc;
+  FT_GlyphSlot slot = NULL;
+  __GLCbitmap* This = NULL;
+  GLint pitch = 0;
+  GLint i = 0, j = 0;
+
+  if (!strikeSize || !__glcFaceDescLoadStrike(faceDesc, inContext,
+					      inGlyphIndex, strikeSize))
+    return NULL;
+
+  slot = faceDesc->face->glyph;
+  pitch = (slot->bitmap.width + 7) >> 3;
+
+  This = (__GLCbitmap*)__glcMalloc(sizeof(__GLCbitmap)
+				   + pitch * slot->bitmap.rows);
+  if (!This) {
+#ifndef GLC_FT_CACHE
+    __glcFaceDescClose(faceDesc);
+#endif
+    __glcRaiseError(GLC_RESOURCE_ERROR);
+    return NULL;
+  }
+
+  __glcBitmapCacheMakeKey(inContext, inFont, inGlyphIndex, inScaleX, inScaleY,
+			  &This->key);
+  This->width = pitch << 3;
+  This->height = slot->bitmap.rows;
+  This->boundingBox[0] = slot->bitmap_left << 6;
+  This->boundingBox[1] = (slot->bitmap_top - This->height) << 6;
+  This->boundingBox[2] = (slot->bitmap_left + slot->bitmap.width) << 6;
+  This->boundingBox[3] = slot->bitmap_top << 6;
+  This->buffer = (GLubyte*)(This + 1);
+  This->next = NULL;
+  This->isCached = GL_FALSE;
+
+  memset(This->buffer, 0, pitch * This->height);
+
+  /* glBitmap() expects the rows from the bottom to the top with 1 bit per
+   * pixel : the rows of the strike are flipped and the gray levels are
+   * thresholded.
+   */
+  for (i = 0; i < This->height; i++) {
+    GLubyte* row = This->buffer + i * pitch;
+    const GLubyte* source = slot->bitmap.buffer;
+
+    if (slot->bitmap.pitch > 0)
+      source += (This->height - 1 - i) * slot->bitmap.pitch;
+    else
+      source -= i * slot->bitmap.pitch;
+
+    if (slot->bitmap.pixel_mode == FT_PIXEL_MODE_MONO) {
+      memcpy(row, source, pitch);
+      /* Clear the padding bits of the last byte of the row */
+      if (slot->bitmap.width & 7)
+	row[pitch - 1] &= (GLubyte)(0xff << (8 - (slot->bitmap.width & 7)));
+    }
+    else {
+      for (j = 0; j < (GLint)slot->bitmap.width; j++) {
+	if (source[j] >= (slot->bitmap.num_grays >> 1))
+	  row[j >> 3] |= (GLubyte)(0x80 >> (j & 7));
+      }
+    }
+  }
+
+#ifndef GLC_FT_CACHE
+  __glcFaceDescClose(faceDesc);
+#endif
+
+  return __glcBitmapCacheInsert(inContext, This);
+}
+
+
+
+/* Release a bitmap that has been returned by __glcBitmapCacheRender() and
+ * which is not stored in the cache.
+ */
+void __glcBitmapCacheRelease(__GLCbitmap* This)
+{
+  if (!This->isCached)
+    __glcFree(This);
+}
+
+
+
+/* Release the least recently used bitmaps until the memory used by the cache
+ * is lower or equal to 'inSize'. A size of 0 empties the cache.
+ */
+void __glcBitmapCacheTrim(__GLCcontext* inContext, const GLint inSize)
+{
+  while ((inContext->bitmapCacheUsed > inSize) && inContext->bitmapList.tail)
+    __glcBitmapCacheRemove(inContext,
+			   (__GLCbitmap*)inContext->bitmapList.tail);
+}
+
+
+
+/* Release the bitmaps of the face 'inFaceDesc'. This function is called when
+ * the face is destroyed since its address may be reused by another face.
+ */
+void __glcBitmapCacheRemoveFace(__GLCcontext* inContext,
+				const __GLCfaceDescriptor* inFaceDesc)
+{
+  FT_ListNode node = inContext->bitmapList.head;
+
+  while (node) {
+    __GLCbitmap* bitmap = (__GLCbitmap*)node;
+
+    node = node->next;
+    if (bitmap->key.faceDesc == inFaceDesc)
+      __glcBitmapCacheRemove(inContext, bitmap);
+  }
+}
@@ -0,0 +1,80 @@
+/* QuesoGLC
+ * A free implementation of the OpenGL Character Renderer (GLC)
+ * Copyright (c) 2002, 2004-2008, Bertrand Coconnier
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+/* $Id$ */
+
+/** \file
+ *  header of the cache of the bitmaps used to render characters with
+ *  GLC_BITMAP and GLC_PIXMAP_QSO.
+ */
+
+#ifndef __glc_bitmap_h
+#define __glc_bitmap_h
+
+#include "ofont.h"
+
+/* Default value of GLC_BITMAP_CACHE_SIZE_QSO */
+#define GLC_BITMAP_CACHE_DEFAULT_SIZE	(1 << 20)
+
+typedef struct __GLCbitmapKeyRec __GLCbitmapKey;
+
+/* The bitmap of a glyph depends on the face, the glyph, the size of the font,
+ * the bitmap matrix, the hinting profile and the use of the embedded bitmaps.
+ * The matrix is quantized to the FT_Fixed values that are given to FreeType.
+ */
+struct __GLCbitmapKeyRec {
+  const __GLCfaceDescriptor* faceDesc;
+  GLCulong glyphIndex;
+  GLint renderStyle;		/* GLC_BITMAP or GLC_PIXMAP_QSO */
+  GLint hinting;		/* See GLC_GET_HINTING_PROFILE() */
+  GLint resolution;
+  GLint strikeSize;		/* Size of the embedded bitmap or 0 */
+  FT_F26Dot6 size[2];
+  FT_Fixed matrix[4];
+};
+
+struct __GLCbitmapRec {
+  FT_ListNodeRec node;		/* Node of the LRU list */
+  __GLCbitmap* next;		/* Next bitmap in the same hash bucket */
+  __GLCbitmapKey key;
+  GLint width, height;		/* Dimensions of the bitmap */
+  GLint boundingBox[4];		/* Location of the bitmap (26.6 format) */
+  GLboolean isCached;		/* GL_FALSE if the bitmap is not in the cache */
+  GLubyte* buffer;
+};
+
+__GLCbitmap* __glcBitmapCacheLookup(__GLCcontext* inContext,
+				    const __GLCfont* inFont,
+				    const GLCulong inGlyphIndex,
+				    const GLfloat inScaleX,
+				    const GLfloat inScaleY);
+__GLCbitmap* __glcBitmapCacheRender(__GLCcontext* inContext,
+				    const __GLCfont* inFont,
+				    const GLCulong inGlyphIndex,
+				    const GLfloat inScaleX,
+				    const GLfloat inScaleY);
+__GLCbitmap* __glcBitmapCacheRenderStrike(__GLCcontext* inContext,
+					  const __GLCfont* inFont,
+					  const GLCulong inGlyphIndex,
+					  const GLfloat inScaleX,
+					  const GLfloat inScaleY);
+void __glcBitmapCacheRelease(__GLCbitmap* This);
+void __glcBitmapCacheTrim(__GLCcontext* inContext, const GLint inSize);
+void __glcBitmapCacheRemoveFace(__GLCcontext* inContext,
+				const __GLCfaceDescriptor* inFaceDesc);
+#endif /* __glc_bitmap_h */
@@ -47,6 +47,8 @@
 #include <string.h>
 
 #include "internal.h"
+#include "texture.h"
+#include "otextobj.h"
 
 
 
@@ -170,6 +172,20 @@ void APIENTRY glcDeleteGLObjects(void)
   for(node = ctx->fontList.head; node; node = node->next)
     __glcFaceDescDestroyGLObjects(((__GLCfont*)(node->data))->faceDesc, ctx);
 
+  /* Delete the buffer objects of the text objects : they will be compiled
+   * again the next time they are rendered.
+   */
+  if (ctx->textObjects) {
+    __GLCtextObject** textObjects =
+      (__GLCtextObject**)GLC_ARRAY_DATA(ctx->textObjects);
+    int i = 0;
+
+    for (i = 0; i < GLC_ARRAY_LENGTH(ctx->textObjects); i++) {
+      if (textObjects[i])
+	__glcTextObjectDestroyGLObjects(textObjects[i], ctx);
+    }
+  }
+
   /* Delete the texture used for immediate texture mode */
   if (ctx->texture.id) {
     glDeleteTextures(1, &ctx->texture.id);
@@ -188,6 +204,8 @@ void APIENTRY glcDeleteGLObjects(void)
   if (GLEW_ARB_vertex_buffer_object && ctx->atlas.bufferObjectID) {
     glDeleteBuffersARB(1, &ctx->atlas.bufferObjectID);
     ctx->atlas.bufferObjectID = 0;
+    ctx->atlasBufferCount = 0;
+    ctx->atlasBufferOffset = 0;
   }
 }
 
@@ -211,6 +229,10 @@ static void __glcChangeState(const GLCenum inAttrib, const GLboolean value)
   case GLC_HINTING_QSO: /* QuesoGLC Extension */
   case GLC_EXTRUDE_QSO: /* QuesoGLC Extension */
   case GLC_KERNING_QSO: /* QuesoGLC Extension */
+  case GLC_BUFFER_SUB_DATA_QSO: /* QuesoGLC Extension */
+  case GLC_COMPOSITE_PIXMAP_QSO: /* QuesoGLC Extension */
+  case GLC_USER_TRANSFORM_QSO: /* QuesoGLC Extension */
+  case GLC_EMBEDDED_BITMAP_QSO: /* QuesoGLC Extension */
     break;
   default:
     __glcRaiseError(GLC_PARAMETER_ERROR);
@@ -234,17 +256,22 @@ static void __glcChangeState(const GLCenum inAttrib, const GLboolean value)
     break;
   case GLC_MIPMAP:
     ctx->enableState.mipmap = value;
-    /* Update the mipmap setting of the texture atlas */
-    if (ctx->atlas.id) {
+    /* Update the mipmap setting of the pages of the texture atlas */
+    if (ctx->atlasPages && GLC_ARRAY_LENGTH(ctx->atlasPages)) {
+      __GLCatlasPage* pages = (__GLCatlasPage*)GLC_ARRAY_DATA(ctx->atlasPages);
       GLuint boundTexture = 0;
+      int i = 0;
+
       glGetIntegerv(GL_TEXTURE_BINDING_2D, (GLint*)&boundTexture);
-      glBindTexture(GL_TEXTURE_2D, ctx->atlas.id);
-      if (ctx->enableState.mipmap)
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER,
-			GL_LINEAR_MIPMAP_LINEAR);
-      else
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER,
-			GL_LINEAR);
+      for (i = 0; i < GLC_ARRAY_LENGTH(ctx->atlasPages); i++) {
+	glBindTexture(GL_TEXTURE_2D, pages[i].id);
+	if (ctx->enableState.mipmap)
+	  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER,
+			  GL_LINEAR_MIPMAP_LINEAR);
+	else
+	  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER,
+			  GL_LINEAR);
+      }
       glBindTexture(GL_TEXTURE_2D, boundTexture);
     }
     break;
@@ -255,8 +282,22 @@ static void __glcChangeState(const GLCenum inAttrib, const GLboolean value)
     ctx->enableState.extrude = value;
     break;
   case GLC_KERNING_QSO:
+    if (ctx->enableState.kerning != value)
+      __glcTextObjectInvalidateLayouts(ctx);
     ctx->enableState.kerning = value;
     break;
+  case GLC_BUFFER_SUB_DATA_QSO:
+    ctx->enableState.bufferSubData = value;
+    break;
+  case GLC_COMPOSITE_PIXMAP_QSO:
+    ctx->enableState.compositePixmap = value;
+    break;
+  case GLC_USER_TRANSFORM_QSO:
+    ctx->enableState.userTransform = value;
+    break;
+  case GLC_EMBEDDED_BITMAP_QSO:
+    ctx->enableState.embeddedBitmap = value;
+    break;
   }
 }
 
@@ -295,6 +336,26 @@ static void __glcChangeState(const GLCenum inAttrib, const GLboolean value)
  *      <td>0x8007</td>
  *      <td><b>GL_FALSE</b></td>
  *    </tr>
+ *    <tr>
+ *      <td><b>GLC_BUFFER_SUB_DATA_QSO</b></td>
+ *      <td>0x8012</td>
+ *      <td><b>GL_TRUE</b></td>
+ *    </tr>
+ *    <tr>
+ *      <td><b>GLC_COMPOSITE_PIXMAP_QSO</b></td>
+ *      <td>0x8015</td>
+ *      <td><b>GL_FALSE</b></td>
+ *    </tr>
+ *    <tr>
+ *      <td><b>GLC_USER_TRANSFORM_QSO</b></td>
+ *      <td>0x8016</td>
+ *      <td><b>GL_FALSE</b></td>
+ *    </tr>
+ *    <tr>
+ *      <td><b>GLC_EMBEDDED_BITMAP_QSO</b></td>
+ *      <td>0x8017</td>
+ *      <td><b>GL_FALSE</b></td>
+ *    </tr>
  *  </table>
  *  </center>
  *  \param inAttrib A symbolic constant indicating a GLC capability.
@@ -332,6 +393,24 @@ void APIENTRY glcDisable(GLCenum inAttrib)
  *    before the rendering commands in order to obtain the desired thickness.
  *  - \b GLC_KERNING_QSO : if enabled, GLC uses kerning information when
  *    rendering or measuring a string. Not all fonts have kerning informations.
+ *  - \b GLC_BUFFER_SUB_DATA_QSO : if enabled, GLC re-uses the storage of the
+ *    vertex buffer object of the texture atlas to upload the vertices of each
+ *    string. Some GL drivers have a buggy implementation of
+ *    \c glBufferSubData : if this attribute is disabled, GLC re-allocates the
+ *    buffer object for each string instead.
+ *  - \b GLC_COMPOSITE_PIXMAP_QSO : if enabled and \b GLC_RENDER_STYLE is
+ *    \b GLC_PIXMAP_QSO then GLC composites the pixmaps of all the glyphes of a
+ *    string in a single pixmap which is drawn by a single call to
+ *    \c glDrawPixels rather than one call per glyph.
+ *  - \b GLC_USER_TRANSFORM_QSO : if enabled, GLC uses the viewport and the
+ *    matrices given by glcLoadTransformQSO() to compute the size of the
+ *    glyphes instead of querying them from GL for each glyph.
+ *  - \b GLC_EMBEDDED_BITMAP_QSO : if enabled and \b GLC_RENDER_STYLE is
+ *    \b GLC_BITMAP then GLC draws the bitmaps that are embedded in the font
+ *    (the so-called "strikes") when the bitmap matrix is a uniform scale and
+ *    the font has a strike of the corresponding size in pixels. The outlines
+ *    of the glyphes are then neither loaded nor rasterized. The advances of the
+ *    characters are still computed from the outlines.
  *
  *  \param inAttrib A symbolic constant indicating a GLC attribute.
  *  \sa glcDisable()
@@ -619,31 +698,22 @@ GLint APIENTRY glcGetListi(GLCenum inAttrib, GLint inIndex)
     }
     break;
   case GLC_TEXTURE_OBJECT_LIST:
-    switch(inIndex) {
-      /* QuesoGLC uses at most 2 textures : one for immediate mode rendering and
-       * another one for the texture atlas. That's all. They are virtually
-       * stored in the following order : texture for immediate mode first, then
-       * texture atlas.
-       */
-      case 0:
-	if (ctx->texture.id)
-	  return ctx->texture.id;
-	/* If the texture for immediate mode does not exist, then the first
-	 * texture is the texture atlas.
-	 * FIXME: if the texture atlas is created first and the texture for
-	 * immediate mode is created after then this algorithm leads to a
-	 * modification of the order which is not satisfying...
-	 */
-	if (ctx->atlas.id)
-	  return ctx->atlas.id;
-	break;
-      case 1:
-	if ((ctx->texture.id) && (ctx->atlas.id))
-	  return ctx->atlas.id;
-	break;
-      default:
-	break;
+    /* QuesoGLC uses one texture for immediate mode rendering and one texture
+     * for each page of the texture atlas. They are virtually stored in the
+     * following order : texture for immediate mode first, then the pages of
+     * the texture atlas.
+     * FIXME: if the texture atlas is created first and the texture for
+     * immediate mode is created after then this algorithm leads to a
+     * modification of the order which is not satisfying...
+     */
+    if (ctx->texture.id) {
+      if (!inIndex)
+	return ctx->texture.id;
+      inIndex--;
     }
+
+    if (ctx->atlasPages && (inIndex < GLC_ARRAY_LENGTH(ctx->atlasPages)))
+      return ((__GLCatlasPage*)GLC_ARRAY_DATA(ctx->atlasPages))[inIndex].id;
     break;
   case GLC_BUFFER_OBJECT_LIST_QSO: /* QuesoGLC extension */
     switch(inIndex) {
@@ -706,6 +776,26 @@ GLint APIENTRY glcGetListi(GLCenum inAttrib, GLint inIndex)
 	  inIndex -= count;
       }
     }
+
+    /* The buffer objects of the text objects are stored last */
+    if (ctx->textObjects) {
+      __GLCtextObject** textObjects =
+	(__GLCtextObject**)GLC_ARRAY_DATA(ctx->textObjects);
+      int i = 0;
+
+      for (i = 0; i < GLC_ARRAY_LENGTH(ctx->textObjects); i++) {
+	int count = 0;
+
+	if (!textObjects[i])
+	  continue;
+
+	count = __glcTextObjectGetBufferObjectCount(textObjects[i]);
+	if (inIndex < count)
+	  return __glcTextObjectGetBufferObject(textObjects[i], inIndex);
+	else
+	  inIndex -= count;
+      }
+    }
     break;
   }
 
@@ -788,11 +878,16 @@ GLvoid* APIENTRY glcGetPointer(GLCenum inAttrib)
  */
 const GLCchar* APIENTRY glcGetc(GLCenum inAttrib)
 {
-  static const char* __glcExtensions1 = "GLC_QSO_attrib_stack";
-  static const char* __glcExtensions2 = " GLC_QSO_buffer_object";
-  static const char* __glcExtensions3 = " GLC_QSO_extrude GLC_QSO_hinting"
-    " GLC_QSO_kerning GLC_QSO_matrix_stack GLC_QSO_render_parameter"
-    " GLC_QSO_render_pixmap GLC_QSO_utf8 GLC_SGI_full_name";
+  static const char* __glcExtensions1 = "GLC_QSO_attrib_stack"
+    " GLC_QSO_bitmap_cache";
+  static const char* __glcExtensions2 = " GLC_QSO_buffer_object"
+    " GLC_QSO_buffer_sub_data";
+  static const char* __glcExtensions3 = " GLC_QSO_composite_pixmap"
+    " GLC_QSO_embedded_bitmap GLC_QSO_extrude GLC_QSO_hinting"
+    " GLC_QSO_hinting_profile GLC_QSO_kerning GLC_QSO_matrix_stack"
+    " GLC_QSO_render_buffer GLC_QSO_render_parameter GLC_QSO_render_pixmap"
+    " GLC_QSO_render_strings GLC_QSO_text_object GLC_QSO_texture_budget"
+    " GLC_QSO_user_transform GLC_QSO_utf8 GLC_SGI_full_name";
   static const GLCchar8* __glcVendor = (const GLCchar8*) "The QuesoGLC Project";
 #ifdef HAVE_CONFIG_H
   static const GLCchar8* __glcRelease = (const GLCchar8*) PACKAGE_VERSION;
@@ -826,14 +921,14 @@ const GLCchar* APIENTRY glcGetc(GLCenum inAttrib)
   switch(inAttrib) {
   case GLC_EXTENSIONS:
     {
-      GLCchar8 __glcExtensions[256];
+      GLCchar8 __glcExtensions[512];
 
       /* This assertion checks that the fixed sized array __glcExtensions is
        * large enough to store the extensions name. If this is not the case
        * then the size must be updated.
        */
       assert((strlen(__glcExtensions1) + strlen(__glcExtensions2)
-	      + strlen(__glcExtensions3)) <= 256);
+	      + strlen(__glcExtensions3)) < sizeof(__glcExtensions));
 
       /* Build the extensions string depending on the available GL extensions */
       strcpy((char*)__glcExtensions, __glcExtensions1);
@@ -1038,6 +1133,17 @@ GLfloat* APIENTRY glcGetfv(GLCenum inAttrib, GLfloat* outVec)
  *  <tr>
  *    <td><b>GLC_BUFFER_OBJECT_COUNT_QSO</b></td> <td>0x800E</td> <td>0</td>
  *  </tr>
+ *  <tr>
+ *    <td><b>GLC_TEXTURE_BUDGET_QSO</b></td> <td>0x8013</td> <td>8388608</td>
+ *  </tr>
+ *  <tr>
+ *    <td><b>GLC_BITMAP_CACHE_SIZE_QSO</b></td> <td>0x8014</td> <td>1048576</td>
+ *  </tr>
+ *  <tr>
+ *    <td><b>GLC_HINTING_PROFILE_QSO</b></td>
+ *    <td>0x8018</td>
+ *    <td><b>GLC_HINTING_FULL_AUTO_QSO</b></td>
+ *  </tr>
  *  </table>
  *  </center>
  *  \param inAttrib Attribute for which an integer variable is requested.
@@ -1073,6 +1179,9 @@ GLint APIENTRY glcGeti(GLCenum inAttrib)
   case GLC_MAX_MATRIX_STACK_DEPTH_QSO: /* QuesoGLC extension */
   case GLC_ATTRIB_STACK_DEPTH_QSO:     /* QuesoGLC extension */
   case GLC_MAX_ATTRIB_STACK_DEPTH_QSO: /* QuesoGLC extension */
+  case GLC_TEXTURE_BUDGET_QSO:         /* QuesoGLC extension */
+  case GLC_BITMAP_CACHE_SIZE_QSO:      /* QuesoGLC extension */
+  case GLC_HINTING_PROFILE_QSO:        /* QuesoGLC extension */
     break;
   case GLC_BUFFER_OBJECT_COUNT_QSO:    /* QuesoGLC extension */
     /* This parameter is available only if the corresponding GL extensions are
@@ -1099,7 +1208,7 @@ GLint APIENTRY glcGeti(GLCenum inAttrib)
   /* Returns the requested value */
   switch(inAttrib) {
   case GLC_CATALOG_COUNT:
-    return GLC_ARRAY_LENGTH(ctx->catalogList);
+    return GLC_ARRAY_LENGTH(ctx->database->catalogList);
   case GLC_CURRENT_FONT_COUNT:
     for (node = ctx->currentFontList.head, count = 0; node;
 	 node = node->next, count++);
@@ -1123,7 +1232,7 @@ GLint APIENTRY glcGeti(GLCenum inAttrib)
     }
     return count;
   case GLC_MASTER_COUNT:
-    return GLC_ARRAY_LENGTH(ctx->masterHashTable);
+    return GLC_ARRAY_LENGTH(ctx->database->masterHashTable);
   case GLC_MEASURED_CHAR_COUNT:
     return GLC_ARRAY_LENGTH(ctx->measurementBuffer);
   case GLC_RENDER_STYLE:
@@ -1135,7 +1244,7 @@ GLint APIENTRY glcGeti(GLCenum inAttrib)
     return ctx->stringState.stringType;
   case GLC_TEXTURE_OBJECT_COUNT:
     count += (ctx->texture.id ? 1 : 0);
-    count += (ctx->atlas.id ? 1 : 0);
+    count += (ctx->atlasPages ? GLC_ARRAY_LENGTH(ctx->atlasPages) : 0);
     return count;
   case GLC_VERSION_MAJOR:
     return __glcCommonArea.versionMajor;
@@ -1149,6 +1258,12 @@ GLint APIENTRY glcGeti(GLCenum inAttrib)
     return ctx->attribStackDepth;
   case GLC_MAX_ATTRIB_STACK_DEPTH_QSO: /* QuesoGLC extension */
     return GLC_MAX_ATTRIB_STACK_DEPTH;
+  case GLC_TEXTURE_BUDGET_QSO:         /* QuesoGLC extension */
+    return ctx->renderState.textureBudget;
+  case GLC_BITMAP_CACHE_SIZE_QSO:      /* QuesoGLC extension */
+    return ctx->renderState.bitmapCacheSize;
+  case GLC_HINTING_PROFILE_QSO:        /* QuesoGLC extension */
+    return ctx->renderState.hintingProfile;
   case GLC_BUFFER_OBJECT_COUNT_QSO:    /* QuesoGLC extension */
     count += (ctx->texture.bufferObjectID ? 1 : 0);
     count += (ctx->atlas.bufferObjectID ? 1 : 0);
@@ -1164,6 +1279,16 @@ GLint APIENTRY glcGeti(GLCenum inAttrib)
 	count += __glcGlyphGetBufferObjectCount(glyph);
       }
     }
+    if (ctx->textObjects) {
+      __GLCtextObject** textObjects =
+	(__GLCtextObject**)GLC_ARRAY_DATA(ctx->textObjects);
+      int i = 0;
+
+      for (i = 0; i < GLC_ARRAY_LENGTH(ctx->textObjects); i++) {
+	if (textObjects[i])
+	  count += __glcTextObjectGetBufferObjectCount(textObjects[i]);
+      }
+    }
     return count;
   }
 
@@ -1197,6 +1322,10 @@ GLboolean APIENTRY glcIsEnabled(GLCenum inAttrib)
   case GLC_HINTING_QSO: /* QuesoGLC Extension */
   case GLC_EXTRUDE_QSO: /* QuesoGLC Extension */
   case GLC_KERNING_QSO: /* QuesoGLC Extension */
+  case GLC_BUFFER_SUB_DATA_QSO: /* QuesoGLC Extension */
+  case GLC_COMPOSITE_PIXMAP_QSO: /* QuesoGLC Extension */
+  case GLC_USER_TRANSFORM_QSO: /* QuesoGLC Extension */
+  case GLC_EMBEDDED_BITMAP_QSO: /* QuesoGLC Extension */
     break;
   default:
     __glcRaiseError(GLC_PARAMETER_ERROR);
@@ -1224,6 +1353,14 @@ GLboolean APIENTRY glcIsEnabled(GLCenum inAttrib)
     return ctx->enableState.extrude;
   case GLC_KERNING_QSO: /* QuesoGLC Extension */
     return ctx->enableState.kerning;
+  case GLC_BUFFER_SUB_DATA_QSO: /* QuesoGLC Extension */
+    return ctx->enableState.bufferSubData;
+  case GLC_COMPOSITE_PIXMAP_QSO: /* QuesoGLC Extension */
+    return ctx->enableState.compositePixmap;
+  case GLC_USER_TRANSFORM_QSO: /* QuesoGLC Extension */
+    return ctx->enableState.userTransform;
+  case GLC_EMBEDDED_BITMAP_QSO: /* QuesoGLC Extension */
+    return ctx->enableState.embeddedBitmap;
   }
 
   return GL_FALSE;
@@ -1524,8 +1661,11 @@ void APIENTRY glcPopAttribQSO(void)
   mask = level->attribBits;
 
   /* Restore the context state with respect to the bitfield mask */
-  if (mask & GLC_ENABLE_BIT_QSO)
+  if (mask & GLC_ENABLE_BIT_QSO) {
+    if (ctx->enableState.kerning != level->enableState.kerning)
+      __glcTextObjectInvalidateLayouts(ctx);
     memcpy(&ctx->enableState, &level->enableState, sizeof(__GLCenableState));
+  }
 
   if (mask & GLC_RENDER_BIT_QSO)
     memcpy(&ctx->renderState, &level->renderState, sizeof(__GLCrenderState));
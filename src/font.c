@@ -125,6 +125,7 @@ void __glcAppendFont(__GLCcontext* inContext, __GLCfont* inFont)
   /* Add the font to GLC_CURRENT_FONT_LIST */
   node->data = inFont;
   FT_List_Add(&inContext->currentFontList, node);
+  __glcContextFlushFontCache(inContext);
 }
 
 
@@ -354,6 +355,8 @@ void APIENTRY glcFont(GLint inFont)
     node->data = font;
     FT_List_Add(&ctx->currentFontList, node);
   }
+
+  __glcContextFlushFontCache(ctx);
 }
 
 
@@ -475,7 +478,9 @@ GLboolean APIENTRY glcFontFace(GLint inFont, const GLCchar* inFace)
  *
  *  The command raises \b GLC_PARAMETER_ERROR if \e inCharName is not
  *  \b GLC_NONE or an element of the font string's list attribute
- *  \b GLC_CHAR_LIST.
+ *  \b GLC_CHAR_LIST. It also raises \b GLC_PARAMETER_ERROR if \e inCode is
+ *  higher than 0x10FFFF, the highest code point of Unicode, since the
+ *  character map can not store such a code.
  *  \param inFont The ID of the font
  *  \param inCode The integer ID of a character
  *  \param inCharName The string name of a character
@@ -501,6 +506,15 @@ void APIENTRY glcFontMap(GLint inFont, GLint inCode, const GLCchar* inCharName)
   if (code < 0)
     return;
 
+  /* Only the codes of the Unicode range can be stored in the character map */
+  if (code > GLC_CHARMAP_MAX_CODE) {
+    __glcRaiseError(GLC_PARAMETER_ERROR);
+    return;
+  }
+
+  /* The character may now be mapped by another font */
+  __glcContextFlushFontCache(ctx);
+
   if (!inCharName)
     /* Remove the character from the map */
     __glcCharMapRemoveChar(font->charMap, code);
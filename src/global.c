@@ -167,6 +167,8 @@ void _fini(void)
     node = next;
   }
 
+  __glcMetricCacheFinalize(&__glcCommonArea.metricCache);
+
 #if FC_MINOR > 2 && defined(DEBUGMODE)
   FcFini();
 #endif
@@ -262,6 +264,16 @@ void _init(void)
   __glcCommonArea.contextList.head = NULL;
   __glcCommonArea.contextList.tail = NULL;
 
+  /* The font database is created by the first context */
+  __glcCommonArea.fontDatabase = NULL;
+
+  /* Initialize the list of the font files mapped in memory */
+  __glcCommonArea.fontFiles.head = NULL;
+  __glcCommonArea.fontFiles.tail = NULL;
+
+  if (!__glcMetricCacheInit(&__glcCommonArea.metricCache))
+    goto FatalError;
+
   /* Initialize the mutex for access to the contextList array */
 #ifdef __WIN32__
   InitializeCriticalSection(&__glcCommonArea.section);
@@ -116,6 +116,14 @@
 #define GLC_CEIL_26_6(x) (((x) < 0) ? ((x) & -64) : ((x) + 63) & -64)
 #define GLC_FLOOR_26_6(x) (((x) < 0) ? (((x) - 63) & -64) : ((x) & -64))
 
+/* Hinting profile that FreeType uses to load the glyphes : the glyphes are
+ * always hinted when GLC_GL_OBJECTS is enabled, otherwise they are hinted only
+ * if GLC_HINTING_QSO is enabled (see __glcFaceDescPrepareGlyph()).
+ */
+#define GLC_GET_HINTING_PROFILE(ctx) \
+  (((ctx)->enableState.hinting || (ctx)->enableState.glObjects) ? \
+    (ctx)->renderState.hintingProfile : GLC_HINTING_NONE_QSO)
+
 typedef struct __GLCdataCodeFromNameRec __GLCdataCodeFromName;
 typedef struct __GLCcharacterRec __GLCcharacter;
 
@@ -192,7 +200,8 @@ extern void __glcRenderCharScalable(const __GLCfont* inFont,
 				    GLfloat* inTransformMatrix,
 				    const GLfloat inScaleX,
 				    const GLfloat inScaleY,
-				    __GLCglyph* inGlyph);
+				    __GLCglyph* inGlyph,
+				    const GLboolean inDraw);
 
 /* QuesoGLC own allocation and memory management routines */
 #ifdef DEBUGMODE
@@ -323,6 +332,19 @@ extern void __glcRaiseError(GLCenum inError);
 extern __GLCcontext* __glcGetCurrent(void);
 #endif
 
+/* Get the viewport either from GL or from the values given to
+ * glcLoadTransformQSO() if GLC_USER_TRANSFORM_QSO is enabled.
+ */
+extern void __glcGetViewport(const __GLCcontext* inContext,
+			     GLint* outViewport);
+
+/* Move the pen or scale the modelview matrix. The matrices given to
+ * glcLoadTransformQSO() are updated accordingly.
+ */
+extern void __glcTranslate(__GLCcontext* inContext, const GLfloat inX,
+			   const GLfloat inY);
+extern void __glcScale(__GLCcontext* inContext, const GLfloat inScale);
+
 /* Compute an optimal size for the glyph to be rendered on the screen (if no
  * display list is currently building).
  */
@@ -78,7 +78,7 @@ __GLCmaster* __glcVerifyMasterParameters(const GLint inMaster)
   }
 
   /* Verify if the master identifier is in legal bounds */
-  if (inMaster >= GLC_ARRAY_LENGTH(ctx->masterHashTable)) {
+  if (inMaster >= GLC_ARRAY_LENGTH(ctx->database->masterHashTable)) {
     __glcRaiseError(GLC_PARAMETER_ERROR);
     return NULL;
   }
@@ -359,8 +359,72 @@ static void __glcMultMatrices(const GLfloat* inMatrix1,
 
 
 
+/* Get the viewport. If GLC_USER_TRANSFORM_QSO is enabled, the viewport given
+ * by glcLoadTransformQSO() is returned and GL is not queried.
+ */
+void __glcGetViewport(const __GLCcontext* inContext, GLint* outViewport)
+{
+  if (inContext->enableState.userTransform)
+    memcpy(outViewport, inContext->userViewport, 4 * sizeof(GLint));
+  else
+    glGetIntegerv(GL_VIEWPORT, outViewport);
+}
+
+
+
+/* Multiply the matrix 'inMatrix' on the right by a translation of
+ * (inX, inY) : only the last column of the matrix is modified.
+ */
+static void __glcTranslateMatrix(GLfloat* inMatrix, const GLfloat inX,
+				 const GLfloat inY)
+{
+  int i = 0;
+
+  for (i = 0; i < 4; i++)
+    inMatrix[12+i] += inX * inMatrix[i] + inY * inMatrix[4+i];
+}
+
+
+
+/* Move the pen of (inX, inY) in object space. The modelview matrix given by
+ * glcLoadTransformQSO() and the transformation matrix cached for the current
+ * string are translated as well so that they still match the GL matrices.
+ */
+void __glcTranslate(__GLCcontext* inContext, const GLfloat inX,
+		    const GLfloat inY)
+{
+  glTranslatef(inX, inY, 0.f);
+
+  if (inContext->enableState.userTransform)
+    __glcTranslateMatrix(inContext->userModelview, inX, inY);
+  if (inContext->isScaleCached)
+    __glcTranslateMatrix(inContext->cachedTransform, inX, inY);
+}
+
+
+
+/* Scale the modelview matrix of 'inScale' along the X and Y axis. The matrices
+ * given by glcLoadTransformQSO() are updated like in __glcTranslate().
+ */
+void __glcScale(__GLCcontext* inContext, const GLfloat inScale)
+{
+  int i = 0;
+
+  glScalef(inScale, inScale, 1.f);
+
+  for (i = 0; i < 8; i++) {
+    if (inContext->enableState.userTransform)
+      inContext->userModelview[i] *= inScale;
+    if (inContext->isScaleCached)
+      inContext->cachedTransform[i] *= inScale;
+  }
+}
+
+
+
 /* Compute an optimal size for the glyph to be rendered on the screen if no
- * display list is planned to be built.
+ * display list is planned to be built. If GLC_USER_TRANSFORM_QSO is enabled,
+ * the matrices given by glcLoadTransformQSO() are used instead of the GL ones.
  */
 void __glcGetScale(const __GLCcontext* inContext, GLfloat* outTransformMatrix,
 		   GLfloat* outScaleX, GLfloat* outScaleY)
@@ -377,11 +441,17 @@ void __glcGetScale(const __GLCcontext* inContext, GLfloat* outTransformMatrix,
     GLfloat modelviewMatrix[16];
     GLint viewport[4];
 
-    glGetIntegerv(GL_VIEWPORT, viewport);
-    glGetFloatv(GL_MODELVIEW_MATRIX, modelviewMatrix);
-    glGetFloatv(GL_PROJECTION_MATRIX, projectionMatrix);
+    __glcGetViewport(inContext, viewport);
+
+    if (inContext->enableState.userTransform)
+      __glcMultMatrices(inContext->userModelview, inContext->userProjection,
+			outTransformMatrix);
+    else {
+      glGetFloatv(GL_MODELVIEW_MATRIX, modelviewMatrix);
+      glGetFloatv(GL_PROJECTION_MATRIX, projectionMatrix);
 
-    __glcMultMatrices(modelviewMatrix, projectionMatrix, outTransformMatrix);
+      __glcMultMatrices(modelviewMatrix, projectionMatrix, outTransformMatrix);
+    }
 
     if (!inContext->enableState.glObjects && inContext->enableState.hinting) {
       GLfloat rs[16], m[16];
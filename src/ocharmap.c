@@ -49,133 +49,30 @@ __GLCcharMap* __glcCharMapCreate(const __GLCmaster* inMaster,
   }
   memset(This, 0, sizeof(__GLCcharMap));
 
-  This->charSet = FcCharSetCreate();
-  if (!This->charSet) {
-    __glcRaiseError(GLC_RESOURCE_ERROR);
-    __glcFree(This);
-    return NULL;
-  }
-
+  /* The character set of a master is shared by all its character maps */
   if (inMaster) {
-    FcCharSet* charSet = NULL;
-    FcFontSet* fontSet = NULL;
-    int i = 0;
-    FcObjectSet* objectSet = NULL;
-    FcPattern* pattern = FcPatternCreate();
+    FcCharSet* charSet = __glcMasterGetCharSet(inMaster, inContext);
 
-    if (!pattern) {
-      __glcRaiseError(GLC_RESOURCE_ERROR);
-      FcCharSetDestroy(This->charSet);
+    if (!charSet) {
       __glcFree(This);
       return NULL;
     }
 
-    objectSet = FcObjectSetBuild(FC_FAMILY, FC_FOUNDRY, FC_SPACING, FC_OUTLINE,
-				 FC_CHARSET, NULL);
-    if (!objectSet) {
-      __glcRaiseError(GLC_RESOURCE_ERROR);
-      FcPatternDestroy(pattern);
-      FcCharSetDestroy(This->charSet);
-      __glcFree(This);
-      return NULL;
-    }
-
-    fontSet = FcFontList(inContext->config, pattern, objectSet);
-    FcObjectSetDestroy(objectSet);
-    FcPatternDestroy(pattern);
-    if (!fontSet) {
-      __glcRaiseError(GLC_RESOURCE_ERROR);
-      FcCharSetDestroy(This->charSet);
-      __glcFree(This);
-      return NULL;
-    }
-
-    for (i = 0; i < fontSet->nfont; i++) {
-      FcChar8* family = NULL;
-      int fixed = 0;
-      FcChar8* foundry = NULL;
-      FcBool outline = FcFalse;
-      FcBool equal = FcFalse;
-#ifdef DEBUGMODE
-      FcResult result = FcResultMatch;
-
-      result = FcPatternGetBool(fontSet->fonts[i], FC_OUTLINE, 0, &outline);
-      assert(result != FcResultTypeMismatch);
-#else
-      FcPatternGetBool(fontSet->fonts[i], FC_OUTLINE, 0, &outline);
-#endif
-
-      /* Check whether the glyphs are outlines */
-      if (!outline)
-	continue;
-
-#ifdef DEBUGMODE
-      result = FcPatternGetString(fontSet->fonts[i], FC_FAMILY, 0, &family);
-      assert(result != FcResultTypeMismatch);
-      result = FcPatternGetString(fontSet->fonts[i], FC_FOUNDRY, 0, &foundry);
-      assert(result != FcResultTypeMismatch);
-      result = FcPatternGetInteger(fontSet->fonts[i], FC_SPACING, 0, &fixed);
-      assert(result != FcResultTypeMismatch);
-#else
-      FcPatternGetString(fontSet->fonts[i], FC_FAMILY, 0, &family);
-      FcPatternGetString(fontSet->fonts[i], FC_FOUNDRY, 0, &foundry);
-      FcPatternGetInteger(fontSet->fonts[i], FC_SPACING, 0, &fixed);
-#endif
-
-      if (foundry)
-	pattern = FcPatternBuild(NULL, FC_FAMILY, FcTypeString, family,
-				 FC_FOUNDRY, FcTypeString, foundry, FC_SPACING,
-				 FcTypeInteger, fixed, NULL);
-      else
-	pattern = FcPatternBuild(NULL, FC_FAMILY, FcTypeString, family,
-				 FC_SPACING, FcTypeInteger, fixed, NULL);
-
-      if (!pattern) {
-	__glcRaiseError(GLC_RESOURCE_ERROR);
-	FcCharSetDestroy(This->charSet);
-	FcFontSetDestroy(fontSet);
-	__glcFree(This);
-	return NULL;
-      }
-
-      equal = FcPatternEqual(pattern, inMaster->pattern);
-      FcPatternDestroy(pattern);
-      if (equal) {
-        FcCharSet* newCharSet = NULL;
-
-#ifdef DEBUGMODE
-        result = FcPatternGetCharSet(fontSet->fonts[i], FC_CHARSET, 0,
-				     &charSet);
-        assert(result != FcResultTypeMismatch);
-#else
-	FcPatternGetCharSet(fontSet->fonts[i], FC_CHARSET, 0, &charSet);
-#endif
-
-        newCharSet = FcCharSetUnion(This->charSet, charSet);
-	if (!newCharSet) {
-          __glcRaiseError(GLC_RESOURCE_ERROR);
-          FcCharSetDestroy(This->charSet);
-          FcFontSetDestroy(fontSet);
-          __glcFree(This);
-          return NULL;
-	}
-
-	FcCharSetDestroy(This->charSet);
-	This->charSet = newCharSet;
-      }
-    }
-
-    FcFontSetDestroy(fontSet);
+    This->charSet = FcCharSetCopy(charSet);
   }
+  else
+    This->charSet = FcCharSetCreate();
 
-  /* The array 'map' will contain the actual character map */
-  This->map = __glcArrayCreate(sizeof(__GLCcharMapElement));
-  if (!This->map) {
-    FcCharSetDestroy(This->charSet);
+  if (!This->charSet) {
+    __glcRaiseError(GLC_RESOURCE_ERROR);
     __glcFree(This);
     return NULL;
   }
 
+  /* The pages of the actual character map are allocated on demand */
+  This->pages = NULL;
+  This->pageCount = 0;
+
   return This;
 }
 
@@ -184,8 +81,15 @@ __GLCcharMap* __glcCharMapCreate(const __GLCmaster* inMaster,
 /* Destructor of the object */
 void __glcCharMapDestroy(__GLCcharMap* This)
 {
-  if (This->map)
-    __glcArrayDestroy(This->map);
+  int i = 0;
+
+  for (i = 0; i < This->pageCount; i++) {
+    if (This->pages[i])
+      __glcFree(This->pages[i]);
+  }
+
+  if (This->pages)
+    __glcFree(This->pages);
 
   FcCharSetDestroy(This->charSet);
 
@@ -194,58 +98,78 @@ void __glcCharMapDestroy(__GLCcharMap* This)
 
 
 
+/* Return the address of the cell where the glyph of the character 'inCode'
+ * is stored, or NULL if the page of the character has not been allocated.
+ */
+static __GLCglyph** __glcCharMapGetCell(const __GLCcharMap* This,
+					const GLint inCode)
+{
+  const GLint page = inCode >> GLC_CHARMAP_PAGE_SHIFT;
+
+  if ((page >= This->pageCount) || !This->pages[page])
+    return NULL;
+
+  return &This->pages[page]->glyph[inCode & (GLC_CHARMAP_PAGE_SIZE - 1)];
+}
+
+
+
 /* Add a given character to the character map. Afterwards, the character map
  * will associate the glyph 'inGlyph' to the Unicode codepoint 'inCode'.
+ * GLC_PARAMETER_ERROR is raised if 'inCode' is beyond the Unicode range.
  */
 void __glcCharMapAddChar(__GLCcharMap* This, const GLint inCode,
 			 __GLCglyph* inGlyph)
 {
-  __GLCcharMapElement* element = NULL;
-  __GLCcharMapElement* newElement = NULL;
-  int start = 0, middle = 0, end = 0;
+  const GLint page = inCode >> GLC_CHARMAP_PAGE_SHIFT;
+  __GLCglyph** cell = NULL;
 
   assert(This);
-  assert(This->map);
-  assert(GLC_ARRAY_DATA(This->map));
+  assert(inGlyph);
   assert(inCode >= 0);
 
-  /* Characters are stored by ascending order of their mapped code */
-  element = (__GLCcharMapElement*)GLC_ARRAY_DATA(This->map);
+  /* Only the codes of the Unicode range can be stored */
+  if (inCode > GLC_CHARMAP_MAX_CODE) {
+    __glcRaiseError(GLC_PARAMETER_ERROR);
+    return;
+  }
 
-  end = GLC_ARRAY_LENGTH(This->map) - 1;
+  /* Grow the table of the pages so that it contains the page of inCode */
+  if (page >= This->pageCount) {
+    __GLCcharMapPage** pages = (__GLCcharMapPage**)__glcRealloc(This->pages,
+				(page + 1) * sizeof(__GLCcharMapPage*));
 
-  /* Parse the array by dichotomy to look for the place where to add the new
-   * character.
-   */
-  while (start <= end) {
-    middle = (start + end) >> 1;
-    /* If the character map already contains the new character then update the
-     * glyph then return.
-     */
-    if (element[middle].mappedCode == (GLCulong)inCode) {
-      element[middle].glyph = inGlyph;
+    if (!pages) {
+      __glcRaiseError(GLC_RESOURCE_ERROR);
       return;
     }
-    else if (element[middle].mappedCode > (GLCulong)inCode)
-      end = middle - 1;
-    else
-      start = middle + 1;
+
+    memset(pages + This->pageCount, 0,
+	   (page + 1 - This->pageCount) * sizeof(__GLCcharMapPage*));
+    This->pages = pages;
+    This->pageCount = page + 1;
   }
 
-  /* If we have reached the end of the array then update the rank 'middle'
-   * accordingly.
-   */
-  if ((end >= 0) && (element[middle].mappedCode < (GLCulong)inCode))
-    middle++;
+  /* Allocate the page if needed */
+  if (!This->pages[page]) {
+    __GLCcharMapPage* newPage =
+      (__GLCcharMapPage*)__glcMalloc(sizeof(__GLCcharMapPage));
 
-  /* Insert the new character in the character map */
-  newElement = (__GLCcharMapElement*)__glcArrayInsertCell(This->map, middle, 1);
-  if (!newElement)
-    return;
+    if (!newPage) {
+      __glcRaiseError(GLC_RESOURCE_ERROR);
+      return;
+    }
+    memset(newPage, 0, sizeof(__GLCcharMapPage));
+    This->pages[page] = newPage;
+  }
 
-  newElement->mappedCode = inCode;
-  newElement->glyph = inGlyph;
-  return;
+  /* If the character map already contains the new character then the glyph is
+   * just updated.
+   */
+  cell = &This->pages[page]->glyph[inCode & (GLC_CHARMAP_PAGE_SIZE - 1)];
+  if (!*cell)
+    This->pages[page]->count++;
+  *cell = inGlyph;
 }
 
 
@@ -253,33 +177,22 @@ void __glcCharMapAddChar(__GLCcharMap* This, const GLint inCode,
 /* Remove a character from the character map */
 void __glcCharMapRemoveChar(__GLCcharMap* This, const GLint inCode)
 {
-  __GLCcharMapElement* element = NULL;
-  int start = 0, middle = 0, end = 0;
+  const GLint page = inCode >> GLC_CHARMAP_PAGE_SHIFT;
+  __GLCglyph** cell = NULL;
 
   assert(This);
-  assert(This->map);
-  assert(GLC_ARRAY_DATA(This->map));
   assert(inCode >= 0);
 
-  /* Characters are stored by ascending order of their mapped code */
-  element = (__GLCcharMapElement*)GLC_ARRAY_DATA(This->map);
+  cell = __glcCharMapGetCell(This, inCode);
+  if (!cell || !*cell)
+    return;
 
-  end = GLC_ARRAY_LENGTH(This->map) - 1;
+  *cell = NULL;
 
-  /* Parse the array by dichotomy to look for the place where to add the new
-   * character.
-   */
-  while (start <= end) {
-    middle = (start + end) >> 1;
-    /* When the character is found remove it from the array and return */
-    if (element[middle].mappedCode == (GLCulong)inCode) {
-      __glcArrayRemove(This->map, middle);
-      break;
-    }
-    else if (element[middle].mappedCode > (GLCulong)inCode)
-      end = middle - 1;
-    else
-      start = middle + 1;
+  /* Release the page when its last character is removed */
+  if (!(--This->pages[page]->count)) {
+    __glcFree(This->pages[page]);
+    This->pages[page] = NULL;
   }
 }
 
@@ -293,34 +206,16 @@ void __glcCharMapRemoveChar(__GLCcharMap* This, const GLint inCode)
 const GLCchar8* __glcCharMapGetCharName(const __GLCcharMap* This,
 					const GLint inCode)
 {
-  __GLCcharMapElement* element = NULL;
-  int start = 0, middle = 0, end = 0;
+  __GLCglyph** cell = NULL;
   GLint code = 0;
 
   assert(This);
-  assert(This->map);
-  assert(GLC_ARRAY_DATA(This->map));
   assert(inCode >= 0);
 
-  /* Characters are stored by ascending order of their mapped code */
-  element = (__GLCcharMapElement*)GLC_ARRAY_DATA(This->map);
-
-  end = GLC_ARRAY_LENGTH(This->map) - 1;
-
-  /* Parse the array by dichotomy to look for the Unicode codepoint that the
-   * request character maps to.
-   */
-  while (start <= end) {
-    middle = (start + end) >> 1;
-    if (element[middle].mappedCode == (GLCulong)inCode) {
-      code = element[middle].glyph->codepoint;
-      break;
-    }
-    else if (element[middle].mappedCode > (GLCulong)inCode)
-      end = middle - 1;
-    else
-      start = middle + 1;
-  }
+  /* Look for the Unicode codepoint that the request character maps to. */
+  cell = __glcCharMapGetCell(This, inCode);
+  if (cell && *cell)
+    code = (*cell)->codepoint;
 
   if (!code) {
     if (FcCharSetHasChar(This->charSet, inCode))
@@ -337,35 +232,17 @@ const GLCchar8* __glcCharMapGetCharName(const __GLCcharMap* This,
 /* Get the glyph corresponding to codepoint 'inCode' */
 __GLCglyph* __glcCharMapGetGlyph(const __GLCcharMap* This, const GLint inCode)
 {
-  __GLCcharMapElement* element = NULL;
-  int start = 0, middle = 0, end = 0;
+  __GLCglyph** cell = NULL;
 
   assert(This);
-  assert(This->map);
-  assert(GLC_ARRAY_DATA(This->map));
   assert(inCode >= 0);
 
-  /* Characters are stored by ascending order of their mapped code */
-  element = (__GLCcharMapElement*)GLC_ARRAY_DATA(This->map);
-
-  end = GLC_ARRAY_LENGTH(This->map) - 1;
+  cell = __glcCharMapGetCell(This, inCode);
 
-  /* Parse the array by dichotomy to find the glyph of the requested
-   * character.
+  /* If no glyph has been defined yet for the requested character, NULL is
+   * returned.
    */
-  while (start <= end) {
-    middle = (start + end) >> 1;
-    if (element[middle].mappedCode == (GLCulong)inCode)
-      /* When the character is found return the corresponding glyph */
-      return element[middle].glyph;
-    else if (element[middle].mappedCode > (GLCulong)inCode)
-      end = middle - 1;
-    else
-      start = middle + 1;
-  }
-
-  /* No glyph has been defined yet for the requested character */
-  return NULL;
+  return cell ? *cell : NULL;
 }
 
 
@@ -373,30 +250,14 @@ __GLCglyph* __glcCharMapGetGlyph(const __GLCcharMap* This, const GLint inCode)
 /* Check if a character is in the character map */
 GLboolean __glcCharMapHasChar(const __GLCcharMap* This, const GLint inCode)
 {
-  __GLCcharMapElement* element = NULL;
-  int start = 0, middle = 0, end = 0;
+  __GLCglyph** cell = NULL;
 
   assert(This);
-  assert(This->map);
-  assert(GLC_ARRAY_DATA(This->map));
   assert(inCode >= 0);
 
-  /* Characters are stored by ascending order of their mapped code */
-  element = (__GLCcharMapElement*)GLC_ARRAY_DATA(This->map);
-
-  end = GLC_ARRAY_LENGTH(This->map) - 1;
-
-  /* Parse the array by dichotomy to find the requested character. */
-  while (start <= end) {
-    middle = (start + end) >> 1;
-    /* The character has been found : return GL_TRUE */
-    if (element[middle].mappedCode == (GLCulong)inCode)
-      return GL_TRUE;
-    else if (element[middle].mappedCode > (GLCulong)inCode)
-      end = middle - 1;
-    else
-      start = middle + 1;
-  }
+  cell = __glcCharMapGetCell(This, inCode);
+  if (cell && *cell)
+    return GL_TRUE;
 
   /* Check if the character identified by inCode exists in the font */
   return FcCharSetHasChar(This->charSet, inCode);
@@ -495,12 +356,8 @@ GLint __glcCharMapGetMaxMappedCode(const __GLCcharMap* This)
   GLCchar32 map[FC_CHARSET_MAP_SIZE];
   int i = 0, j = 0;
   GLCulong maxMappedCode = 0;
-  __GLCcharMapElement* element = NULL;
-  int length = 0;
 
   assert(This);
-  assert(This->map);
-  assert(GLC_ARRAY_DATA(This->map));
 
   /* Look for the last block of pages of the FcCharSet structure */
   base = FcCharSetFirstPage(This->charSet, map, &next);
@@ -532,17 +389,24 @@ GLint __glcCharMapGetMaxMappedCode(const __GLCcharMap* This)
   maxMappedCode = prev_base + (i << 5) + j;
 
   /* Check that a code greater than the one found in the FcCharSet is not
-   * stored in the array 'map'.
+   * stored in the pages of the character map.
    */
-  element = (__GLCcharMapElement*)GLC_ARRAY_DATA(This->map);
-  length = GLC_ARRAY_LENGTH(This->map);
+  for (i = This->pageCount - 1; i >= 0; i--) {
+    if (!This->pages[i])
+      continue;
 
-  /* Return the greater of the code of both the FcCharSet and the array 'map'*/
-  if (length)
-    return element[length-1].mappedCode > maxMappedCode ?
-      element[length-1].mappedCode : maxMappedCode;
-  else
-    return maxMappedCode;
+    for (j = GLC_CHARMAP_PAGE_SIZE - 1; j >= 0; j--)
+      if (This->pages[i]->glyph[j]) break;
+
+    assert(j >= 0);
+
+    /* Return the greater of the code of both the FcCharSet and the pages */
+    if ((GLCulong)((i << GLC_CHARMAP_PAGE_SHIFT) + j) > maxMappedCode)
+      return (i << GLC_CHARMAP_PAGE_SHIFT) + j;
+    break;
+  }
+
+  return maxMappedCode;
 }
 
 
@@ -555,12 +419,8 @@ GLint __glcCharMapGetMinMappedCode(const __GLCcharMap* This)
   GLCchar32 map[FC_CHARSET_MAP_SIZE];
   int i = 0, j = 0;
   GLCulong minMappedCode = 0xffffffff;
-  __GLCcharMapElement* element = NULL;
-  int length = 0;
 
   assert(This);
-  assert(This->map);
-  assert(GLC_ARRAY_DATA(This->map));
 
   /* Get the first block of pages of the FcCharSet structure */
   base = FcCharSetFirstPage(This->charSet, map, &next);
@@ -585,15 +445,22 @@ GLint __glcCharMapGetMinMappedCode(const __GLCcharMap* This)
   minMappedCode = base + (i << 5) + j;
 
   /* Check that a code lower than the one found in the FcCharSet is not
-   * stored in the array 'map'.
+   * stored in the pages of the character map.
    */
-  element = (__GLCcharMapElement*)GLC_ARRAY_DATA(This->map);
-  length = GLC_ARRAY_LENGTH(This->map);
+  for (i = 0; i < This->pageCount; i++) {
+    if (!This->pages[i])
+      continue;
 
-  /* Return the lower of the code of both the FcCharSet and the array 'map'*/
-  if (length)
-    return element[0].mappedCode < minMappedCode ?
-      element[0].mappedCode : minMappedCode;
-  else
-    return minMappedCode;
+    for (j = 0; j < GLC_CHARMAP_PAGE_SIZE; j++)
+      if (This->pages[i]->glyph[j]) break;
+
+    assert(j < GLC_CHARMAP_PAGE_SIZE);
+
+    /* Return the lower of the code of both the FcCharSet and the pages */
+    if ((GLCulong)((i << GLC_CHARMAP_PAGE_SHIFT) + j) < minMappedCode)
+      return (i << GLC_CHARMAP_PAGE_SHIFT) + j;
+    break;
+  }
+
+  return minMappedCode;
 }
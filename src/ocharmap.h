@@ -29,18 +29,27 @@
 #include "ocontext.h"
 #include "oglyph.h"
 
-typedef struct __GLCcharMapElementRec __GLCcharMapElement;
+#define GLC_CHARMAP_PAGE_SHIFT	8
+#define GLC_CHARMAP_PAGE_SIZE	(1 << GLC_CHARMAP_PAGE_SHIFT)
+#define GLC_CHARMAP_MAX_CODE	0x10ffff
+
+typedef struct __GLCcharMapPageRec __GLCcharMapPage;
 typedef struct __GLCcharMapRec __GLCcharMap;
 typedef struct __GLCmasterRec __GLCmaster;
 
-struct __GLCcharMapElementRec {
-  GLCulong mappedCode;
-  __GLCglyph* glyph;
+/* The glyphes are stored in a two-level table : the codes are split in pages
+ * of 256 characters, and a page is allocated the first time that one of its
+ * characters is added to the map.
+ */
+struct __GLCcharMapPageRec {
+  __GLCglyph* glyph[GLC_CHARMAP_PAGE_SIZE];
+  GLint count;			/* Number of characters stored in the page */
 };
 
 struct __GLCcharMapRec {
   FcCharSet* charSet;
-  __GLCarray* map;
+  __GLCcharMapPage** pages;	/* Pages indexed by 'code >> 8' */
+  GLint pageCount;		/* Number of entries of 'pages' */
 };
 
 __GLCcharMap* __glcCharMapCreate(const __GLCmaster* inMaster,
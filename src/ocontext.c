@@ -31,6 +31,8 @@
 
 #include "internal.h"
 #include "texture.h"
+#include "otextobj.h"
+#include "bitmap.h"
 #include FT_MODULE_H
 
 __GLCcommonArea __glcCommonArea;
@@ -41,30 +43,7 @@ __GLCthreadArea* __glcThreadArea = NULL;
 #endif
 
 static GLboolean __glcContextUpdateHashTable(__GLCcontext *This);
-
-
-
-/* Find a token in a list of tokens separated by 'separator' */
-static GLCchar8* __glcFindIndexList(GLCchar8* inString, const GLuint inIndex,
-				    const GLCchar8* inSeparator)
-{
-  GLuint occurence = 0;
-  GLCchar8* s = inString;
-  const GLCchar8* sep = inSeparator;
-
-  if (!inIndex)
-    return s;
-
-  for (; *s != '\0'; s++) {
-    if (*s == *sep) {
-      occurence++;
-      if (occurence == inIndex)
-	break;
-    }
-  }
-
-  return (GLCchar8 *) s;
-}
+static void __glcContextFlushUnmappedCodes(__GLCcontext* This);
 
 
 
@@ -100,50 +79,15 @@ __GLCcontext* __glcContextCreate(const GLint inContext)
   }
 #endif
 
-  __glcLock();
-  This->config = FcInitLoadConfigAndFonts();
-  __glcUnlock();
-  if (!This->config) {
-    __glcRaiseError(GLC_RESOURCE_ERROR);
-#ifdef GLC_FT_CACHE
-    FTC_Manager_Done(This->cache);
-#endif
-    FT_Done_Library(This->library);
-    __glcFree(This);
-    return NULL;
-  }
-
-  This->catalogList = __glcArrayCreate(sizeof(GLCchar8*));
-  if (!This->catalogList) {
-#ifdef GLC_FT_CACHE
-    FTC_Manager_Done(This->cache);
-#endif
-    FT_Done_Library(This->library);
-    FcConfigDestroy(This->config);
-    __glcFree(This);
-    return NULL;
-  }
-
-  This->masterHashTable = __glcArrayCreate(sizeof(GLCchar32));
-  if (!This->masterHashTable) {
-    __glcArrayDestroy(This->catalogList);
-#ifdef GLC_FT_CACHE
-    FTC_Manager_Done(This->cache);
-#endif
-    FT_Done_Library(This->library);
-    FcConfigDestroy(This->config);
-    __glcFree(This);
-    return NULL;
-  }
-
-  if (!__glcContextUpdateHashTable(This)) {
-    __glcArrayDestroy(This->masterHashTable);
-    __glcArrayDestroy(This->catalogList);
+  /* The fonts and the masters are shared with the other contexts as long as
+   * the catalogs are not modified.
+   */
+  This->database = __glcFontDatabaseGetDefault();
+  if (!This->database) {
 #ifdef GLC_FT_CACHE
     FTC_Manager_Done(This->cache);
 #endif
     FT_Done_Library(This->library);
-    FcConfigDestroy(This->config);
     __glcFree(This);
     return NULL;
   }
@@ -168,22 +112,27 @@ __GLCcontext* __glcContextCreate(const GLint inContext)
   This->enableState.hinting = GL_FALSE;
   This->enableState.extrude = GL_FALSE;
   This->enableState.kerning = GL_FALSE;
+  This->enableState.bufferSubData = GL_TRUE;
+  This->enableState.compositePixmap = GL_FALSE;
+  This->enableState.userTransform = GL_FALSE;
+  This->enableState.embeddedBitmap = GL_FALSE;
   This->renderState.resolution = 72.;
   This->renderState.renderStyle = GLC_BITMAP;
   This->renderState.tolerance = 0.005;
+  This->renderState.textureBudget = GLC_ATLAS_DEFAULT_BUDGET;
+  This->renderState.bitmapCacheSize = GLC_BITMAP_CACHE_DEFAULT_SIZE;
+  This->renderState.hintingProfile = GLC_HINTING_FULL_AUTO_QSO;
   This->bitmapMatrixStackDepth = 1;
   This->bitmapMatrix = This->bitmapMatrixStack;
   This->bitmapMatrix[0] = 1.;
   This->bitmapMatrix[3] = 1.;
   This->measurementBuffer = __glcArrayCreate(12 * sizeof(GLfloat));
   if (!This->measurementBuffer) {
-    __glcArrayDestroy(This->masterHashTable);
-    __glcArrayDestroy(This->catalogList);
+    __glcFontDatabaseRelease(This->database);
 #ifdef GLC_FT_CACHE
     FTC_Manager_Done(This->cache);
 #endif
     FT_Done_Library(This->library);
-    FcConfigDestroy(This->config);
     __glcFree(This);
     return NULL;
   }
@@ -191,13 +140,11 @@ __GLCcontext* __glcContextCreate(const GLint inContext)
   This->vertexArray = __glcArrayCreate(2 * sizeof(GLfloat));
   if (!This->vertexArray) {
     __glcArrayDestroy(This->measurementBuffer);
-    __glcArrayDestroy(This->masterHashTable);
-    __glcArrayDestroy(This->catalogList);
+    __glcFontDatabaseRelease(This->database);
 #ifdef GLC_FT_CACHE
     FTC_Manager_Done(This->cache);
 #endif
     FT_Done_Library(This->library);
-    FcConfigDestroy(This->config);
     __glcFree(This);
     return NULL;
   }
@@ -205,13 +152,11 @@ __GLCcontext* __glcContextCreate(const GLint inContext)
   if (!This->controlPoints) {
     __glcArrayDestroy(This->vertexArray);
     __glcArrayDestroy(This->measurementBuffer);
-    __glcArrayDestroy(This->masterHashTable);
-    __glcArrayDestroy(This->catalogList);
+    __glcFontDatabaseRelease(This->database);
 #ifdef GLC_FT_CACHE
     FTC_Manager_Done(This->cache);
 #endif
     FT_Done_Library(This->library);
-    FcConfigDestroy(This->config);
     __glcFree(This);
     return NULL;
   }
@@ -220,13 +165,11 @@ __GLCcontext* __glcContextCreate(const GLint inContext)
     __glcArrayDestroy(This->controlPoints);
     __glcArrayDestroy(This->vertexArray);
     __glcArrayDestroy(This->measurementBuffer);
-    __glcArrayDestroy(This->masterHashTable);
-    __glcArrayDestroy(This->catalogList);
+    __glcFontDatabaseRelease(This->database);
 #ifdef GLC_FT_CACHE
     FTC_Manager_Done(This->cache);
 #endif
     FT_Done_Library(This->library);
-    FcConfigDestroy(This->config);
     __glcFree(This);
     return NULL;
   }
@@ -237,13 +180,11 @@ __GLCcontext* __glcContextCreate(const GLint inContext)
     __glcArrayDestroy(This->controlPoints);
     __glcArrayDestroy(This->vertexArray);
     __glcArrayDestroy(This->measurementBuffer);
-    __glcArrayDestroy(This->masterHashTable);
-    __glcArrayDestroy(This->catalogList);
+    __glcFontDatabaseRelease(This->database);
 #ifdef GLC_FT_CACHE
     FTC_Manager_Done(This->cache);
 #endif
     FT_Done_Library(This->library);
-    FcConfigDestroy(This->config);
     __glcFree(This);
     return NULL;
   }
@@ -255,110 +196,15 @@ __GLCcontext* __glcContextCreate(const GLint inContext)
     __glcArrayDestroy(This->controlPoints);
     __glcArrayDestroy(This->vertexArray);
     __glcArrayDestroy(This->measurementBuffer);
-    __glcArrayDestroy(This->masterHashTable);
-    __glcArrayDestroy(This->catalogList);
+    __glcFontDatabaseRelease(This->database);
 #ifdef GLC_FT_CACHE
     FTC_Manager_Done(This->cache);
 #endif
     FT_Done_Library(This->library);
-    FcConfigDestroy(This->config);
     __glcFree(This);
     return NULL;
   }
 
-  /* The environment variable GLC_PATH is an alternate way to allow QuesoGLC
-   * to access to fonts catalogs/directories.
-   */
-  /*Check if the GLC_PATH environment variables are exported */
-  if (getenv("GLC_CATALOG_LIST") || getenv("GLC_PATH")) {
-    GLCchar8 *path = NULL;
-    GLCchar8 *begin = NULL;
-    GLCchar8 *sepPos = NULL;
-    const GLCchar8 *separator = (GLCchar8*)getenv("GLC_LIST_SEPARATOR");
-
-    /* Get the list separator */
-    if (!separator) {
-#ifdef __WIN32__
-      /* Windows can not use a colon-separated list since the colon sign is
-       * used after the drive letter. The semicolon is used by Windows for its
-       * PATH variable, so we use it for consistency.
-       */
-      separator = (const GLCchar8*)";";
-#else
-      /* POSIX platforms use colon-separated lists for the paths variables
-       * so we keep with it for consistency.
-       */
-      separator = (const GLCchar8*)":";
-#endif
-    }
-
-    /* Read the paths of fonts file.
-     * First, try GLC_CATALOG_LIST...
-     */
-    if (getenv("GLC_CATALOG_LIST"))
-#ifdef __WIN32__
-      path = (GLCchar8*)_strdup(getenv("GLC_CATALOG_LIST"));
-#else
-      path = (GLCchar8*)strdup(getenv("GLC_CATALOG_LIST"));
-#endif
-    /* Then try GLC_PATH */
-    else if (getenv("GLC_PATH")) {
-#ifdef __WIN32__
-      path = (GLCchar8*)_strdup(getenv("GLC_PATH"));
-#else
-      path = (GLCchar8*)strdup(getenv("GLC_PATH"));
-#endif
-    }
-
-    if (path) {
-      /* Get each path and add the corresponding masters to the current
-       * context */
-      GLCchar8* duplicated = NULL;
-
-      begin = path;
-      do {
-	sepPos = __glcFindIndexList(begin, 1, separator);
-
-        if (*sepPos)
-	  *(sepPos++) = 0;
-
-#ifdef __WIN32__
-        duplicated = (GLCchar8*)_strdup((char*)begin);
-#else
-        duplicated = (GLCchar8*)strdup((char*)begin);
-#endif
-        if (!duplicated) {
-	  __glcRaiseError(GLC_RESOURCE_ERROR);
-	}
-        else {
-	  if (!__glcArrayAppend(This->catalogList, &duplicated))
-            free(duplicated);
-          else if (!FcConfigAppFontAddDir(This->config,
-                                          (const unsigned char*)begin)) {
-            __glcArrayRemove(This->catalogList,
-                             GLC_ARRAY_LENGTH(This->catalogList));
-	    __glcRaiseError(GLC_RESOURCE_ERROR);
-            free(duplicated);
-          }
-	  else if (!__glcContextUpdateHashTable(This)) {
-	    /* For some reason the update of the master hash table has failed :
-	     * the new catalog must then be removed from GLC_CATALOG_LIST.
-	     */
-	    __glcContextRemoveCatalog(This,
-				      GLC_ARRAY_LENGTH(This->catalogList));
-	  }
-        }
-
-        begin = sepPos;
-      } while (*sepPos);
-      free(path);
-    }
-    else {
-      /* strdup has failed to allocate memory to duplicate GLC_PATH => ERROR */
-      __glcRaiseError(GLC_RESOURCE_ERROR);
-    }
-  }
-
   return This;
 }
 
@@ -411,15 +257,6 @@ void __glcContextDestroy(__GLCcontext *This)
 
   assert(This);
 
-  /* Destroy the list of catalogs */
-  for (i = 0; i < GLC_ARRAY_LENGTH(This->catalogList); i++) {
-    GLCchar8* string = ((GLCchar8**)GLC_ARRAY_DATA(This->catalogList))[i];
-
-    assert(string);
-    free(string);
-  }
-  __glcArrayDestroy(This->catalogList);
-
   /* Destroy GLC_CURRENT_FONT_LIST */
 #ifdef GLC_FT_CACHE
   FT_List_Finalize(&This->currentFontList, NULL,
@@ -436,11 +273,30 @@ void __glcContextDestroy(__GLCcontext *This)
   FT_List_Finalize(&This->genFontList, __glcFontDestructor,
 		   &__glcCommonArea.memoryManager, This);
 
-  if (This->masterHashTable)
-    __glcArrayDestroy(This->masterHashTable);
+  __glcFontDatabaseRelease(This->database);
 
-  FT_List_Finalize(&This->atlasList, NULL,
-		   &__glcCommonArea.memoryManager, NULL);
+  __glcContextFlushUnmappedCodes(This);
+
+  /* Destroy the text objects */
+  if (This->textObjects) {
+    __GLCtextObject** textObjects =
+      (__GLCtextObject**)GLC_ARRAY_DATA(This->textObjects);
+
+    for (i = 0; i < GLC_ARRAY_LENGTH(This->textObjects); i++) {
+      if (textObjects[i])
+	__glcTextObjectDestroy(textObjects[i], This);
+    }
+    __glcArrayDestroy(This->textObjects);
+  }
+
+  __glcTextureAtlasDestroy(This);
+  __glcBitmapCacheTrim(This, 0);
+
+  if (This->pixmapGlyphs)
+    __glcArrayDestroy(This->pixmapGlyphs);
+
+  if (This->pixmapBufferSize)
+    __glcFree(This->pixmapBuffer);
 
   if (This->bufferSize)
     __glcFree(This->buffer);
@@ -467,12 +323,70 @@ void __glcContextDestroy(__GLCcontext *This)
   FTC_Manager_Done(This->cache);
 #endif
   FT_Done_Library(This->library);
-  FcConfigDestroy(This->config);
   __glcFree(This);
 }
 
 
 
+/* Record that no master maps the character 'inCode'. The codes are stored in
+ * one bitset per Unicode plane which is allocated the first time that a code
+ * of the plane is recorded. If the allocation fails, the code is simply not
+ * recorded.
+ */
+void __glcContextSetUnmappedCode(__GLCcontext* This, const GLint inCode)
+{
+  const GLint plane = inCode >> 16;
+
+  if ((inCode < 0) || (plane >= GLC_UNICODE_PLANE_COUNT))
+    return;
+
+  if (!This->unmappedCodes[plane]) {
+    This->unmappedCodes[plane] = (GLubyte*)__glcMalloc(0x10000 >> 3);
+    if (!This->unmappedCodes[plane])
+      return;
+    memset(This->unmappedCodes[plane], 0, 0x10000 >> 3);
+  }
+
+  This->unmappedCodes[plane][(inCode & 0xffff) >> 3] |= 1 << (inCode & 7);
+}
+
+
+
+/* Check if the character 'inCode' has been recorded as unmapped by
+ * __glcContextSetUnmappedCode().
+ */
+static GLboolean __glcContextIsUnmappedCode(const __GLCcontext* This,
+					    const GLint inCode)
+{
+  const GLint plane = inCode >> 16;
+
+  if ((inCode < 0) || (plane >= GLC_UNICODE_PLANE_COUNT)
+      || !This->unmappedCodes[plane])
+    return GL_FALSE;
+
+  return (This->unmappedCodes[plane][(inCode & 0xffff) >> 3]
+	  & (1 << (inCode & 7))) ? GL_TRUE : GL_FALSE;
+}
+
+
+
+/* Forget the characters recorded by __glcContextSetUnmappedCode(). This
+ * function must be called each time that the catalogs are modified.
+ */
+static void __glcContextFlushUnmappedCodes(__GLCcontext* This)
+{
+  int i = 0;
+
+  for (i = 0; i < GLC_UNICODE_PLANE_COUNT; i++) {
+    if (This->unmappedCodes[i]) {
+      __glcFree(This->unmappedCodes[i]);
+      This->unmappedCodes[i] = NULL;
+    }
+  }
+}
+
+
+
 /* Return the first font in GLC_CURRENT_FONT_LIST that maps 'inCode'.
  * If there is no such font, the function returns NULL.
  * 'inCode' must be given in UCS-4 format.
@@ -539,12 +453,21 @@ static GLboolean __glcCallCallbackFunc(__GLCcontext *inContext,
 __GLCfont* __glcContextGetFont(__GLCcontext *This, const GLint inCode)
 {
   __GLCfont* font = NULL;
+  const int slot = inCode & (GLC_FONT_CACHE_SIZE - 1);
+
+  /* Look for the code in the cache of the characters resolved recently */
+  font = This->fontCache[slot];
+  if (font && (This->fontCacheCode[slot] == inCode))
+    return font;
 
   /* Look for a font in the current font list */
   font = __glcLookupFont(&This->currentFontList, inCode);
-  /* If a font has been found return */
-  if (font)
+  /* If a font has been found, store it in the cache and return */
+  if (font) {
+    This->fontCacheCode[slot] = inCode;
+    This->fontCache[slot] = font;
     return font;
+  }
 
   /* If a callback function is defined for GLC_OP_glcUnmappedCode then call it.
    * The callback function should return GL_TRUE if it succeeds in appending to
@@ -569,6 +492,10 @@ __GLCfont* __glcContextGetFont(__GLCcontext *This, const GLint inCode)
       return font;
     }
 
+    /* Do not query Fontconfig again for a code that no master maps */
+    if (__glcContextIsUnmappedCode(This, inCode))
+      return NULL;
+
     master = __glcMasterMatchCode(This, inCode);
     if (!master)
       return NULL;
@@ -586,6 +513,19 @@ __GLCfont* __glcContextGetFont(__GLCcontext *This, const GLint inCode)
 
 
 
+/* Empty the cache of the characters resolved by __glcContextGetFont(). This
+ * function must be called each time that GLC_CURRENT_FONT_LIST, the character
+ * map of a font or the catalogs are modified. The layout of the text objects
+ * may have changed as well.
+ */
+void __glcContextFlushFontCache(__GLCcontext* This)
+{
+  memset(This->fontCache, 0, GLC_FONT_CACHE_SIZE * sizeof(__GLCfont*));
+  __glcTextObjectInvalidateLayouts(This);
+}
+
+
+
 /* Sometimes informations may need to be stored temporarily by a thread.
  * The so-called 'buffer' is created for that purpose. Notice that it is a
  * component of the GLC state struct hence its lifetime is the same as the
@@ -618,122 +558,29 @@ GLCchar* __glcContextQueryBuffer(__GLCcontext *This, const size_t inSize)
 
 
 
-/* Update the hash table that which is used to convert master IDs into
- * FontConfig patterns.
+/* Return the ID of the master which hash value is 'inHashValue' or -1 if no
+ * master has such a hash value.
  */
-static GLboolean __glcContextUpdateHashTable(__GLCcontext *This)
+GLint __glcContextGetMasterID(const __GLCcontext* This,
+			      const GLCchar32 inHashValue)
 {
-  FcPattern* pattern = NULL;
-  FcObjectSet* objectSet = NULL;
-  FcFontSet *fontSet = NULL;
-  int i = 0;
-  __GLCarray *updatedHashTable = NULL;
-
-  /* Use Fontconfig to get the default font files */
-  pattern = FcPatternCreate();
-  if (!pattern) {
-    __glcRaiseError(GLC_RESOURCE_ERROR);
-    return GL_FALSE;
-  }
-  objectSet = FcObjectSetBuild(FC_FAMILY, FC_FOUNDRY, FC_OUTLINE, FC_SPACING,
-			       NULL);
-  if (!objectSet) {
-    __glcRaiseError(GLC_RESOURCE_ERROR);
-    FcPatternDestroy(pattern);
-    return GL_FALSE;
-  }
-  fontSet = FcFontList(This->config, pattern, objectSet);
-  FcPatternDestroy(pattern);
-  FcObjectSetDestroy(objectSet);
-  if (!fontSet) {
-    __glcRaiseError(GLC_RESOURCE_ERROR);
-    return GL_FALSE;
-  }
-
-  updatedHashTable = __glcArrayDuplicate(This->masterHashTable);
-  if (!updatedHashTable) {
-    FcFontSetDestroy(fontSet);
-    return GL_FALSE;
-  }
-
-  /* Parse the font set looking for fonts that are not already registered in the
-   * hash table.
-   */
-  for (i = 0; i < fontSet->nfont; i++) {
-    GLCchar32 hashValue = 0;
-    int j = 0;
-    const int length = GLC_ARRAY_LENGTH(updatedHashTable);
-    GLCchar32* hashTable = (GLCchar32*)GLC_ARRAY_DATA(updatedHashTable);
-    FcBool outline = FcFalse;
-    FcChar8* family = NULL;
-    int fixed = 0;
-    FcChar8* foundry = NULL;
-#ifdef DEBUGMODE
-    FcResult result = FcResultMatch;
-
-    result = FcPatternGetBool(fontSet->fonts[i], FC_OUTLINE, 0, &outline);
-    assert(result != FcResultTypeMismatch);
-#else
-    FcPatternGetBool(fontSet->fonts[i], FC_OUTLINE, 0, &outline);
-#endif
-
-    /* Check whether the glyphs are outlines */
-    if (!outline)
-      continue;
-
-#ifdef DEBUGMODE
-    result = FcPatternGetString(fontSet->fonts[i], FC_FAMILY, 0, &family);
-    assert(result != FcResultTypeMismatch);
-    result = FcPatternGetString(fontSet->fonts[i], FC_FOUNDRY, 0, &foundry);
-    assert(result != FcResultTypeMismatch);
-    result = FcPatternGetInteger(fontSet->fonts[i], FC_SPACING, 0, &fixed);
-    assert(result != FcResultTypeMismatch);
-#else
-    FcPatternGetString(fontSet->fonts[i], FC_FAMILY, 0, &family);
-    FcPatternGetString(fontSet->fonts[i], FC_FOUNDRY, 0, &foundry);
-    FcPatternGetInteger(fontSet->fonts[i], FC_SPACING, 0, &fixed);
-#endif
-
-    if (foundry)
-      pattern = FcPatternBuild(NULL, FC_FAMILY, FcTypeString, family,
-			       FC_FOUNDRY, FcTypeString, foundry, FC_SPACING,
-			       FcTypeInteger, fixed, NULL);
-    else
-      pattern = FcPatternBuild(NULL, FC_FAMILY, FcTypeString, family,
-			       FC_SPACING, FcTypeInteger, fixed, NULL);
+  return __glcFontDatabaseGetMasterID(This->database, inHashValue);
+}
 
-    if (!pattern) {
-      __glcRaiseError(GLC_RESOURCE_ERROR);
-      FcFontSetDestroy(fontSet);
-      __glcArrayDestroy(updatedHashTable);
-      return GL_FALSE;
-    }
 
-    /* Check if the font is already registered in the hash table */
-    hashValue = FcPatternHash(pattern);
-    FcPatternDestroy(pattern);
-    for (j = 0; j < length; j++) {
-      if (hashTable[j] == hashValue)
-	break;
-    }
 
-    /* If the font is already registered then parse the next one */
-    if (j != length)
-      continue;
-
-    /* Register the font (i.e. append its hash value to the hash table) */
-    if (!__glcArrayAppend(updatedHashTable, &hashValue)) {
-      FcFontSetDestroy(fontSet);
-      __glcArrayDestroy(updatedHashTable);
-      return GL_FALSE;
-    }
-  }
+/* Update the hash table that which is used to convert master IDs into
+ * FontConfig patterns. The database of the context must not be shared.
+ */
+static GLboolean __glcContextUpdateHashTable(__GLCcontext *This)
+{
+  assert(This->database->refCount == 1);
 
-  FcFontSetDestroy(fontSet);
-  __glcArrayDestroy(This->masterHashTable);
-  This->masterHashTable = updatedHashTable;
+  /* Fonts may be added or removed by the catalog change */
+  __glcContextFlushFontCache(This);
+  __glcContextFlushUnmappedCodes(This);
 
-  return GL_TRUE;
+  return __glcFontDatabaseUpdate(This->database);
 }
 
 
@@ -746,19 +593,30 @@ void __glcContextAppendCatalog(__GLCcontext* This, const GLCchar* inCatalog)
 #else
   GLCchar8* duplicated = (GLCchar8*)strdup((const char*)inCatalog);
 #endif
+  __GLCfontDatabase* database = NULL;
 
   if (!duplicated) {
     __glcRaiseError(GLC_RESOURCE_ERROR);
     return;
   }
 
-  if (!__glcArrayAppend(This->catalogList, &duplicated)) {
+  /* The database can not be modified while other contexts use it */
+  database = __glcFontDatabaseUnshare(This->database);
+  if (!database) {
+    free(duplicated);
+    return;
+  }
+  This->database = database;
+
+  if (!__glcArrayAppend(database->catalogList, &duplicated)) {
     free(duplicated);
     return;
   }
 
-  if (!FcConfigAppFontAddDir(This->config, (const unsigned char*)inCatalog)) {
-    __glcArrayRemove(This->catalogList, GLC_ARRAY_LENGTH(This->catalogList));
+  if (!FcConfigAppFontAddDir(database->config,
+			     (const unsigned char*)inCatalog)) {
+    __glcArrayRemove(database->catalogList,
+		     GLC_ARRAY_LENGTH(database->catalogList));
     __glcRaiseError(GLC_RESOURCE_ERROR);
     free(duplicated);
     return;
@@ -768,7 +626,7 @@ void __glcContextAppendCatalog(__GLCcontext* This, const GLCchar* inCatalog)
     /* For some reason the update of the master hash table has failed : the
      * new catalog must then be removed from GLC_CATALOG_LIST.
      */
-    __glcContextRemoveCatalog(This, GLC_ARRAY_LENGTH(This->catalogList));
+    __glcContextRemoveCatalog(This, GLC_ARRAY_LENGTH(database->catalogList));
     return;
   }
 }
@@ -783,19 +641,29 @@ void __glcContextPrependCatalog(__GLCcontext* This, const GLCchar* inCatalog)
 #else
   GLCchar8* duplicated = (GLCchar8*)strdup((const char*)inCatalog);
 #endif
+  __GLCfontDatabase* database = NULL;
 
   if (!duplicated) {
     __glcRaiseError(GLC_RESOURCE_ERROR);
     return;
   }
 
-  if (!__glcArrayInsert(This->catalogList, 0, &duplicated)) {
+  /* The database can not be modified while other contexts use it */
+  database = __glcFontDatabaseUnshare(This->database);
+  if (!database) {
+    free(duplicated);
+    return;
+  }
+  This->database = database;
+
+  if (!__glcArrayInsert(database->catalogList, 0, &duplicated)) {
     free(duplicated);
     return;
   }
 
-  if (!FcConfigAppFontAddDir(This->config, (const unsigned char*)inCatalog)) {
-    __glcArrayRemove(This->catalogList, 0);
+  if (!FcConfigAppFontAddDir(database->config,
+			     (const unsigned char*)inCatalog)) {
+    __glcArrayRemove(database->catalogList, 0);
     __glcRaiseError(GLC_RESOURCE_ERROR);
     free(duplicated);
     return;
@@ -816,12 +684,12 @@ void __glcContextPrependCatalog(__GLCcontext* This, const GLCchar* inCatalog)
 GLCchar8* __glcContextGetCatalogPath(const __GLCcontext* This,
 				     const GLint inIndex)
 {
-  if (inIndex >= GLC_ARRAY_LENGTH(This->catalogList)) {
+  if (inIndex >= GLC_ARRAY_LENGTH(This->database->catalogList)) {
     __glcRaiseError(GLC_PARAMETER_ERROR);
     return NULL;
   }
     
-  return ((GLCchar8**)GLC_ARRAY_DATA(This->catalogList))[inIndex];
+  return ((GLCchar8**)GLC_ARRAY_DATA(This->database->catalogList))[inIndex];
 }
 
 
@@ -834,6 +702,8 @@ void __glcContextDeleteFont(__GLCcontext* inContext, __GLCfont* font)
 {
   FT_ListNode node = NULL;
 
+  __glcContextFlushFontCache(inContext);
+
   /* Look for the font into GLC_CURRENT_FONT_LIST */
   node = FT_List_Find(&inContext->currentFontList, font);
 
@@ -856,24 +726,31 @@ void __glcContextRemoveCatalog(__GLCcontext* This, const GLint inIndex)
   FT_ListNode node = NULL;
   GLCchar8* catalog = NULL;
   int i = 0;
+  __GLCfontDatabase* database = NULL;
 
-  if (inIndex >= GLC_ARRAY_LENGTH(This->catalogList)) {
+  if (inIndex >= GLC_ARRAY_LENGTH(This->database->catalogList)) {
     __glcRaiseError(GLC_PARAMETER_ERROR);
     return;
   }
 
-  FcConfigAppFontClear(This->config);
-  catalog = ((GLCchar8**)GLC_ARRAY_DATA(This->catalogList))[inIndex];
+  /* The database can not be modified while other contexts use it */
+  database = __glcFontDatabaseUnshare(This->database);
+  if (!database)
+    return;
+  This->database = database;
+
+  FcConfigAppFontClear(database->config);
+  catalog = ((GLCchar8**)GLC_ARRAY_DATA(database->catalogList))[inIndex];
   assert(catalog);
-  __glcArrayRemove(This->catalogList, inIndex);
+  __glcArrayRemove(database->catalogList, inIndex);
   free(catalog);
 
-  for (i = 0; i < GLC_ARRAY_LENGTH(This->catalogList); i++) {
-    catalog = ((GLCchar8**)GLC_ARRAY_DATA(This->catalogList))[i];
+  for (i = 0; i < GLC_ARRAY_LENGTH(database->catalogList); i++) {
+    catalog = ((GLCchar8**)GLC_ARRAY_DATA(database->catalogList))[i];
     assert(catalog);
-    if (!FcConfigAppFontAddDir(This->config, catalog)) {
+    if (!FcConfigAppFontAddDir(database->config, catalog)) {
       __glcRaiseError(GLC_RESOURCE_ERROR);
-      __glcArrayRemove(This->catalogList, i);
+      __glcArrayRemove(database->catalogList, i);
       free(catalog);
       /* After the removal of the problematic catalog , indices are shifted by 1
        */
@@ -882,7 +759,7 @@ void __glcContextRemoveCatalog(__GLCcontext* This, const GLint inIndex)
   }
 
   /* Re-create the hash table from scratch */
-  GLC_ARRAY_LENGTH(This->masterHashTable) = 0;
+  GLC_ARRAY_LENGTH(database->masterHashTable) = 0;
   __glcContextUpdateHashTable(This);
 
   /* Remove from GLC_FONT_LIST the fonts that were defined in the catalog that
@@ -891,23 +768,13 @@ void __glcContextRemoveCatalog(__GLCcontext* This, const GLint inIndex)
    */
   for (node = This->fontList.head; node; node = node->next) {
     __GLCfont* font = (__GLCfont*)(node->data);
-    GLCchar32 hashValue = 0;
-    GLCchar32* hashTable = (GLCchar32*)GLC_ARRAY_DATA(This->masterHashTable);
-    const int length = GLC_ARRAY_LENGTH(This->masterHashTable);
     __GLCmaster* master = __glcMasterCreate(font->parentMasterID, This);
 
     if (!master)
       continue;
 
-    /* Check if the hash value of the master is in the hash table */
-    hashValue = GLC_MASTER_HASH_VALUE(master);
-    for (i = 0; i < length; i++) {
-      if (hashValue == hashTable[i])
-	break;
-    }
-
     /* The font is not contained in the hash table => remove it */
-    if (i == length) {
+    if (__glcContextGetMasterID(This, GLC_MASTER_HASH_VALUE(master)) < 0) {
       FT_List_Remove(&This->fontList, node);
       __glcContextDeleteFont(This, font);
     }
@@ -39,10 +39,16 @@
 #include FT_LIST_H
 
 #include "oarray.h"
+#include "ofontdb.h"
+#include "ometric.h"
+#include "ofile.h"
 #include "except.h"
 
 #define GLC_MAX_MATRIX_STACK_DEPTH	32
 #define GLC_MAX_ATTRIB_STACK_DEPTH	16
+#define GLC_UNICODE_PLANE_COUNT		17
+#define GLC_FONT_CACHE_SIZE		256	/* Must be a power of 2 */
+#define GLC_BITMAP_HASH_SIZE		256	/* Must be a power of 2 */
 
 typedef struct __GLCcontextRec __GLCcontext;
 typedef struct __GLCtextureRec __GLCtexture;
@@ -54,6 +60,8 @@ typedef struct __GLCattribStackLevelRec  __GLCattribStackLevel;
 typedef struct __GLCthreadAreaRec __GLCthreadArea;
 typedef struct __GLCcommonAreaRec  __GLCcommonArea;
 typedef struct __GLCfontRec __GLCfont;
+typedef struct __GLCbitmapRec __GLCbitmap;
+typedef struct __GLCoutlineRec __GLCoutline;
 
 struct __GLCtextureRec {
   GLuint id;
@@ -69,12 +77,19 @@ struct __GLCenableStateRec {
   GLboolean hinting;		/* GLC_HINTING_QSO */
   GLboolean extrude;		/* GLC_EXTRUDE_QSO */
   GLboolean kerning;		/* GLC_KERNING_QSO */
+  GLboolean bufferSubData;	/* GLC_BUFFER_SUB_DATA_QSO */
+  GLboolean compositePixmap;	/* GLC_COMPOSITE_PIXMAP_QSO */
+  GLboolean userTransform;	/* GLC_USER_TRANSFORM_QSO */
+  GLboolean embeddedBitmap;	/* GLC_EMBEDDED_BITMAP_QSO */
 };
 
 struct __GLCrenderStateRec {
   GLfloat resolution;		/* GLC_RESOLUTION */
   GLint renderStyle;		/* GLC_RENDER_STYLE */
   GLfloat tolerance;		/* GLC_PARAMETRIC_TOLERANCE_QSO */
+  GLint textureBudget;		/* GLC_TEXTURE_BUDGET_QSO */
+  GLint bitmapCacheSize;	/* GLC_BITMAP_CACHE_SIZE_QSO */
+  GLint hintingProfile;	/* GLC_HINTING_PROFILE_QSO */
 };
 
 struct __GLCstringStateRec {
@@ -135,7 +150,7 @@ struct __GLCcontextRec {
 #ifdef GLC_FT_CACHE
   FTC_Manager cache;
 #endif
-  FcConfig *config;
+  __GLCfontDatabase* database;	/* Fonts and masters (may be shared) */
 
   GLint id;			/* Context ID */
   GLboolean isInGlobalCommand;	/* Is in a global command ? */
@@ -146,8 +161,9 @@ struct __GLCcontextRec {
   FT_ListRec currentFontList;	/* GLC_CURRENT_FONT_LIST */
   FT_ListRec fontList;		/* GLC_FONT_LIST */
   FT_ListRec genFontList;       /* Fonts generated by glcGenFontID() */
-  __GLCarray* masterHashTable;
-  __GLCarray* catalogList;	/* GLC_CATALOG_LIST */
+  GLint fontCacheCode[GLC_FONT_CACHE_SIZE]; /* Codes resolved recently */
+  __GLCfont* fontCache[GLC_FONT_CACHE_SIZE]; /* Fonts that map those codes */
+  GLubyte* unmappedCodes[GLC_UNICODE_PLANE_COUNT]; /* Codes no master maps */
   __GLCarray* measurementBuffer;
   GLfloat measurementStringBuffer[12];
   __GLCarray* vertexArray;	/* Array of vertices */
@@ -161,11 +177,36 @@ struct __GLCcontextRec {
 #endif
   __GLCtexture texture;		/* Texture for immediate mode rendering */
 
-  __GLCtexture atlas;
-  FT_ListRec atlasList;
-  int atlasWidth;
-  int atlasHeight;
+  __GLCtexture atlas;		/* Page size and VBO of the texture atlas */
+  __GLCarray* atlasPages;	/* Pages of the texture atlas */
+  __GLCarray* atlasFreeSlots;	/* Unused quads of the VBO of the atlas */
+  GLuint atlasStamp;		/* Incremented for each rendered string */
   int atlasCount;
+  __GLCarray* atlasVertices;	/* Quads of the glyphes of the atlas */
+  __GLCarray* atlasStream;	/* Quads of the string being rendered */
+  __GLCarray* atlasBatches;	/* Pages used by the stream */
+  int atlasBufferCount;		/* Number of quads allocated in the VBO */
+  int atlasBufferOffset;		/* First free quad of the VBO */
+
+  __GLCarray* textObjects;	/* Text objects (GLC_QSO_text_object) */
+
+  __GLCbitmap* bitmapHash[GLC_BITMAP_HASH_SIZE]; /* Cached bitmaps */
+  FT_ListRec bitmapList;	/* Cached bitmaps, most recently used first */
+  GLint bitmapCacheUsed;	/* Memory used by the cached bitmaps */
+
+  FT_ListRec outlineList;	/* Cached outlines, most recently used first */
+  GLint outlineCacheUsed;	/* Memory used by the cached outlines */
+
+  __GLCarray* pixmapGlyphs;	/* Glyphes of the composited pixmap */
+  GLubyte* pixmapBuffer;	/* Pixels of the composited pixmap */
+  size_t pixmapBufferSize;
+
+  GLint userViewport[4];	/* Transformation set by glcLoadTransformQSO */
+  GLfloat userModelview[16];
+  GLfloat userProjection[16];
+  GLboolean isScaleCached;	/* Scale already computed for the string ? */
+  GLfloat cachedTransform[16];
+  GLfloat cachedScale[2];
 
   GLfloat* bitmapMatrix;	/* GLC_BITMAP_MATRIX */
   GLfloat bitmapMatrixStack[4*GLC_MAX_MATRIX_STACK_DEPTH];
@@ -191,6 +232,9 @@ struct __GLCcommonAreaRec {
   GLint versionMinor;		/* GLC_VERSION_MINOR */
 
   FT_ListRec contextList;
+  __GLCfontDatabase* fontDatabase; /* Database of the default catalogs */
+  __GLCmetricCache metricCache;	/* Metrics of the glyphes of all contexts */
+  FT_ListRec fontFiles;		/* Font files mapped in memory */
 #ifndef __WIN32__
   pthread_mutex_t mutex;	/* For concurrent accesses to the common
 				   area */
@@ -232,4 +276,8 @@ void __glcContextRemoveCatalog(__GLCcontext* This, const GLint inIndex);
 GLCchar8* __glcContextGetCatalogPath(const __GLCcontext* This,
 				     const GLint inIndex);
 void __glcContextDeleteFont(__GLCcontext* inContext, __GLCfont* font);
+void __glcContextFlushFontCache(__GLCcontext* This);
+GLint __glcContextGetMasterID(const __GLCcontext* This,
+			      const GLCchar32 inHashValue);
+void __glcContextSetUnmappedCode(__GLCcontext* This, const GLint inCode);
 #endif /* __glc_ocontext_h */
@@ -31,6 +31,8 @@
 
 #include "internal.h"
 #include "texture.h"
+#include "bitmap.h"
+#include "outline.h"
 #include FT_GLYPH_H
 #ifdef GLC_FT_CACHE
 #include FT_CACHE_H
@@ -47,6 +49,19 @@
 #endif
 #include FT_SFNT_NAMES_H
 #include FT_TRUETYPE_IDS_H
+#include FT_TRUETYPE_TABLES_H
+#include FT_TRUETYPE_TAGS_H
+#ifdef FT_ADVANCES_H
+#include FT_ADVANCES_H
+#endif
+
+#if defined(GLC_FT_CACHE) \
+  && (FREETYPE_MAJOR > 2 \
+     || (FREETYPE_MAJOR == 2 \
+         && (FREETYPE_MINOR > 1 \
+             || (FREETYPE_MINOR == 1 && FREETYPE_PATCH >= 8))))
+#define GLC_FT_REMOVE_FACE_ID
+#endif
 
 
 
@@ -61,53 +76,26 @@ __GLCfaceDescriptor* __glcFaceDescCreate(const __GLCmaster* inMaster,
 					 const GLint inCode)
 {
   __GLCfaceDescriptor* This = NULL;
-  FcObjectSet* objectSet = NULL;
-  FcFontSet *fontSet = NULL;
-  int i = 0;
-  FcPattern* pattern = FcPatternCreate();
+  const __GLCmasterInfo* masterInfo = NULL;
+  FcFontSet *fontSet = inContext->database->masterFontSet;
+  const GLint* nextFace = inContext->database->masterNextFace;
+  GLint i = 0;
 
-  if (!pattern) {
-    __glcRaiseError(GLC_RESOURCE_ERROR);
-    return NULL;
-  }
-
-  objectSet = FcObjectSetBuild(FC_FAMILY, FC_FOUNDRY, FC_STYLE, FC_SPACING,
-			       FC_FILE, FC_INDEX, FC_OUTLINE, FC_CHARSET, NULL);
-  if (!objectSet) {
-    __glcRaiseError(GLC_RESOURCE_ERROR);
-    FcPatternDestroy(pattern);
-    return NULL;
-  }
-  fontSet = FcFontList(inContext->config, pattern, objectSet);
-  FcObjectSetDestroy(objectSet);
-  FcPatternDestroy(pattern);
-  if (!fontSet) {
+  /* The faces of the master are looked up in the table of the masters of the
+   * context rather than in a new list of the fonts installed.
+   */
+  masterInfo = __glcMasterLookup(inMaster, inContext);
+  if (!masterInfo) {
     __glcRaiseError(GLC_RESOURCE_ERROR);
     return NULL;
   }
 
-  for (i = 0; i < fontSet->nfont; i++) {
-    FcChar8* family = NULL;
-    int fixed = 0;
-    FcChar8* foundry = NULL;
+  for (i = masterInfo->firstFace; i >= 0; i = nextFace[i]) {
     FcChar8* style = NULL;
-    FcBool outline = FcFalse;
     FcCharSet* charSet = NULL;
-    FcBool equal = FcFalse;
 #ifdef DEBUGMODE
     FcResult result = FcResultMatch;
 
-    result = FcPatternGetBool(fontSet->fonts[i], FC_OUTLINE, 0, &outline);
-    assert(result != FcResultTypeMismatch);
-#else
-    FcPatternGetBool(fontSet->fonts[i], FC_OUTLINE, 0, &outline);
-#endif
-
-    /* Check whether the glyphs are outlines */
-    if (!outline)
-      continue;
-
-#ifdef DEBUGMODE
     result = FcPatternGetCharSet(fontSet->fonts[i], FC_CHARSET, 0, &charSet);
     assert(result != FcResultTypeMismatch);
 #else
@@ -118,66 +106,32 @@ __GLCfaceDescriptor* __glcFaceDescCreate(const __GLCmaster* inMaster,
     if (inCode && !FcCharSetHasChar(charSet, inCode))
       continue;
 
+    if (inFace) {
 #ifdef DEBUGMODE
-    result = FcPatternGetString(fontSet->fonts[i], FC_FAMILY, 0, &family);
-    assert(result != FcResultTypeMismatch);
-    result = FcPatternGetString(fontSet->fonts[i], FC_FOUNDRY, 0, &foundry);
-    assert(result != FcResultTypeMismatch);
-    result = FcPatternGetInteger(fontSet->fonts[i], FC_SPACING, 0, &fixed);
-    assert(result != FcResultTypeMismatch);
-#else
-    FcPatternGetString(fontSet->fonts[i], FC_FAMILY, 0, &family);
-    FcPatternGetString(fontSet->fonts[i], FC_FOUNDRY, 0, &foundry);
-    FcPatternGetInteger(fontSet->fonts[i], FC_SPACING, 0, &fixed);
-#endif
-
-    if (foundry)
-      pattern = FcPatternBuild(NULL, FC_FAMILY, FcTypeString, family,
-			       FC_FOUNDRY, FcTypeString, foundry, FC_SPACING,
-			       FcTypeInteger, fixed, NULL);
-    else
-      pattern = FcPatternBuild(NULL, FC_FAMILY, FcTypeString, family,
-			       FC_SPACING, FcTypeInteger, fixed, NULL);
-
-    if (!pattern) {
-      __glcRaiseError(GLC_RESOURCE_ERROR);
-      FcFontSetDestroy(fontSet);
-      return NULL;
-    }
-
-    equal = FcPatternEqual(pattern, inMaster->pattern);
-    FcPatternDestroy(pattern);
-    if (equal) {
-      if (inFace) {
-#ifdef DEBUGMODE
-	result = FcPatternGetString(fontSet->fonts[i], FC_STYLE, 0, &style);
-	assert(result != FcResultTypeMismatch);
+      result = FcPatternGetString(fontSet->fonts[i], FC_STYLE, 0, &style);
+      assert(result != FcResultTypeMismatch);
 #else
-	FcPatternGetString(fontSet->fonts[i], FC_STYLE, 0, &style);
+      FcPatternGetString(fontSet->fonts[i], FC_STYLE, 0, &style);
 #endif
-	if (strcmp((const char*)style, (const char*)inFace))
-	  continue;
-      }
-      break;
+      if (strcmp((const char*)style, (const char*)inFace))
+	continue;
     }
+    break;
   }
 
-  if (i == fontSet->nfont) {
-    FcFontSetDestroy(fontSet);
+  if (i < 0) {
     __glcRaiseError(GLC_RESOURCE_ERROR);
     return NULL;
   }
 
   This = (__GLCfaceDescriptor*)__glcMalloc(sizeof(__GLCfaceDescriptor));
   if (!This) {
-    FcFontSetDestroy(fontSet);
     __glcRaiseError(GLC_RESOURCE_ERROR);
     return NULL;
   }
   memset(This, 0, sizeof(__GLCfaceDescriptor));
 
   This->pattern = FcPatternDuplicate(fontSet->fonts[i]);
-  FcFontSetDestroy(fontSet);
   if (!This->pattern) {
     __glcRaiseError(GLC_RESOURCE_ERROR);
     __glcFree(This);
@@ -189,6 +143,21 @@ __GLCfaceDescriptor* __glcFaceDescCreate(const __GLCmaster* inMaster,
 
 
 
+/* Release the blocks of the table of the advances */
+static void __glcFaceDescFlushAdvances(__GLCfaceDescriptor* This)
+{
+  GLint i = 0;
+
+  for (i = 0; i < This->advanceBlockCount; i++) {
+    if (This->advanceTable[i]) {
+      __glcFree(This->advanceTable[i]);
+      This->advanceTable[i] = NULL;
+    }
+  }
+}
+
+
+
 /* Destructor of the object */
 void __glcFaceDescDestroy(__GLCfaceDescriptor* This, __GLCcontext* inContext)
 {
@@ -209,56 +178,103 @@ void __glcFaceDescDestroy(__GLCfaceDescriptor* This, __GLCcontext* inContext)
     node = next;
   }
 
-#if defined(GLC_FT_CACHE) \
-  && (FREETYPE_MAJOR > 2 \
-     || (FREETYPE_MAJOR == 2 \
-         && (FREETYPE_MINOR > 1 \
-             || (FREETYPE_MINOR == 1 && FREETYPE_PATCH >= 8))))
+  if (This->glyphHash)
+    __glcFree(This->glyphHash);
+
+  if (This->advanceTable) {
+    __glcFaceDescFlushAdvances(This);
+    __glcFree(This->advanceTable);
+  }
+
+  if (This->kerningPairs)
+    __glcFree(This->kerningPairs);
+
+  if (This->outlineBufferSize)
+    __glcFree(This->outline.points);
+
+  /* Release the bitmaps of the face that are stored in the cache */
+  __glcBitmapCacheRemoveFace(inContext, This);
+
+#ifdef GLC_FT_REMOVE_FACE_ID
   /* In order to make sure its ID is removed from the FreeType cache */
   FTC_Manager_RemoveFaceID(inContext->cache, (FTC_FaceID)This);
 #endif
 
+  /* The face has been closed, so the file is no longer needed */
+  if (This->file)
+    __glcFontFileRelease(This->file);
+
   FcPatternDestroy(This->pattern);
   __glcFree(This);
 }
 
 
 
-#ifndef GLC_FT_CACHE
-/* Open a face, select a Unicode charmap. __glcFaceDesc maintains a reference
- * count for each face so that the face is open only once.
+/* Create the FreeType face of the face descriptor and select a Unicode
+ * charmap. The face is created from the face file mapped in memory so that
+ * the file is read only once whatever the number of faces and contexts that
+ * use it. If the file can not be mapped, FreeType reads the file itself.
  */
-FT_Face __glcFaceDescOpen(__GLCfaceDescriptor* This,
-			  __GLCcontext* inContext)
+static FT_Error __glcFaceDescNewFace(__GLCfaceDescriptor* This,
+				     FT_Library inLibrary, FT_Face* outFace)
 {
-  if (!This->faceRefCount) {
-    GLCchar8 *fileName = NULL;
-    int index = 0;
+  GLCchar8 *fileName = NULL;
+  int index = 0;
+  FT_Error error;
 #ifdef DEBUGMODE
-    FcResult result = FcResultMatch;
+  FcResult result = FcResultMatch;
 
-    /* get the file name */
-    result = FcPatternGetString(This->pattern, FC_FILE, 0, &fileName);
-    assert(result != FcResultTypeMismatch);
-    /* get the index of the font in font file */
-    result = FcPatternGetInteger(This->pattern, FC_INDEX, 0, &index);
-    assert(result != FcResultTypeMismatch);
+  /* get the file name */
+  result = FcPatternGetString(This->pattern, FC_FILE, 0, &fileName);
+  assert(result != FcResultTypeMismatch);
+  /* get the index of the font in font file */
+  result = FcPatternGetInteger(This->pattern, FC_INDEX, 0, &index);
+  assert(result != FcResultTypeMismatch);
 #else
-    /* get the file name */
-    FcPatternGetString(This->pattern, FC_FILE, 0, &fileName);
-    /* get the index of the font in font file */
-    FcPatternGetInteger(This->pattern, FC_INDEX, 0, &index);
+  /* get the file name */
+  FcPatternGetString(This->pattern, FC_FILE, 0, &fileName);
+  /* get the index of the font in font file */
+  FcPatternGetInteger(This->pattern, FC_INDEX, 0, &index);
 #endif
 
-    if (FT_New_Face(inContext->library, (const char*)fileName, index,
-		    &This->face)) {
-      /* Unable to load the face file */
-      __glcRaiseError(GLC_RESOURCE_ERROR);
-      return NULL;
-    }
+#if !defined(GLC_FT_CACHE) || defined(GLC_FT_REMOVE_FACE_ID)
+  /* The file must not be unmapped before the face is done : when the face can
+   * not be removed from the FreeType cache, the file is not mapped.
+   */
+  if (!This->file)
+    This->file = __glcFontFileAcquire(fileName);
+#endif
+
+  if (This->file)
+    error = FT_New_Memory_Face(inLibrary, This->file->data, This->file->size,
+			       index, outFace);
+  else
+    error = FT_New_Face(inLibrary, (const char*)fileName, index, outFace);
+
+  if (error) {
+    /* Unable to load the face file */
+    __glcRaiseError(GLC_RESOURCE_ERROR);
+    return error;
+  }
 
-    /* select a Unicode charmap */
-    FT_Select_Charmap(This->face, ft_encoding_unicode);
+  /* select a Unicode charmap */
+  FT_Select_Charmap(*outFace, ft_encoding_unicode);
+
+  return error;
+}
+
+
+
+#ifndef GLC_FT_CACHE
+/* Open a face, select a Unicode charmap. __glcFaceDesc maintains a reference
+ * count for each face so that the face is open only once.
+ */
+FT_Face __glcFaceDescOpen(__GLCfaceDescriptor* This,
+			  const __GLCcontext* inContext)
+{
+  if (!This->faceRefCount) {
+    if (__glcFaceDescNewFace(This, inContext->library, &This->face))
+      return NULL;
 
     This->faceRefCount = 1;
   }
@@ -292,39 +308,66 @@ void __glcFaceDescClose(__GLCfaceDescriptor* This)
 FT_Error __glcFileOpen(FTC_FaceID inFile, FT_Library inLibrary,
 		       FT_Pointer GLC_UNUSED_ARG(inData), FT_Face* outFace)
 {
-  __GLCfaceDescriptor* file = (__GLCfaceDescriptor*)inFile;
-  GLCchar8 *fileName = NULL;
-  int fileIndex = 0;
-  FT_Error error;
-#ifdef DEBUGMODE
-  FcResult result = FcResultMatch;
+  return __glcFaceDescNewFace((__GLCfaceDescriptor*)inFile, inLibrary,
+			      outFace);
+}
+#endif /* GLC_FT_CACHE */
 
-  /* get the file name */
-  result = FcPatternGetString(file->pattern, FC_FILE, 0, &fileName);
-  assert(result != FcResultTypeMismatch);
-  /* get the index of the font in font file */
-  result = FcPatternGetInteger(file->pattern, FC_INDEX, 0, &fileIndex);
-  assert(result != FcResultTypeMismatch);
-#else
-  /* get the file name */
-  FcPatternGetString(file->pattern, FC_FILE, 0, &fileName);
-  /* get the index of the font in font file */
-  FcPatternGetInteger(file->pattern, FC_INDEX, 0, &fileIndex);
-#endif
 
-  error = FT_New_Face(inLibrary, (const char*)fileName, fileIndex, outFace);
 
-  if (error) {
+/* Return the slot of the index 'glyphHash' where the search of the glyph of
+ * codepoint 'inCode' begins. The slots are probed linearly from there.
+ */
+static GLuint __glcFaceDescHashCode(const __GLCfaceDescriptor* This,
+				    const GLCulong inCode)
+{
+  /* Fibonacci hashing : the upper bits of the product are the best mixed */
+  return ((GLCuint)inCode * 2654435761U) >> (32 - This->glyphHashBits);
+}
+
+
+
+/* Make sure that the index 'glyphHash' has room for a new glyph. The index is
+ * kept at most half full so that the linear probing remains short : when the
+ * limit is reached, the size of the index is doubled and the glyphes of
+ * glyphList are inserted in the new index.
+ */
+static GLboolean __glcFaceDescGrowGlyphHash(__GLCfaceDescriptor* This)
+{
+  __GLCglyph** glyphHash = NULL;
+  GLint bits = This->glyphHashBits;
+  FT_ListNode node = NULL;
+  GLuint mask = 0;
+
+  if (This->glyphHash && (2 * (This->glyphCount + 1) <= (1 << bits)))
+    return GL_TRUE;
+
+  bits = This->glyphHash ? bits + 1 : GLC_GLYPH_HASH_MIN_BITS;
+  glyphHash = (__GLCglyph**)__glcMalloc((1 << bits) * sizeof(__GLCglyph*));
+  if (!glyphHash) {
     __glcRaiseError(GLC_RESOURCE_ERROR);
-    return error;
+    return GL_FALSE;
   }
+  memset(glyphHash, 0, (1 << bits) * sizeof(__GLCglyph*));
 
-  /* select a Unicode charmap */
-  FT_Select_Charmap(*outFace, ft_encoding_unicode);
+  if (This->glyphHash)
+    __glcFree(This->glyphHash);
+  This->glyphHash = glyphHash;
+  This->glyphHashBits = bits;
 
-  return error;
+  /* Re-insert the glyphes in the new index */
+  mask = (1 << bits) - 1;
+  for (node = This->glyphList.head; node; node = node->next) {
+    __GLCglyph* glyph = (__GLCglyph*)node;
+    GLuint i = __glcFaceDescHashCode(This, glyph->codepoint);
+
+    while (glyphHash[i])
+      i = (i + 1) & mask;
+    glyphHash[i] = glyph;
+  }
+
+  return GL_TRUE;
 }
-#endif /* GLC_FT_CACHE */
 
 
 
@@ -335,16 +378,25 @@ __GLCglyph* __glcFaceDescGetGlyph(__GLCfaceDescriptor* This,
 {
   FT_Face face = NULL;
   __GLCglyph* glyph = NULL;
-  FT_ListNode node = NULL;
   FT_UInt index = 0;
+  GLuint mask = 0;
+  GLuint i = 0;
 
   /* Check if the glyph has already been added to the glyph list */
-  for (node = This->glyphList.head; node; node = node->next) {
-    glyph = (__GLCglyph*)node;
-    if (glyph->codepoint == (GLCulong)inCode)
-      return glyph;
+  if (This->glyphHash) {
+    mask = (1 << This->glyphHashBits) - 1;
+
+    for (i = __glcFaceDescHashCode(This, inCode); This->glyphHash[i];
+	 i = (i + 1) & mask) {
+      if (This->glyphHash[i]->codepoint == (GLCulong)inCode)
+	return This->glyphHash[i];
+    }
   }
 
+  /* Make room in the index for the new glyph */
+  if (!__glcFaceDescGrowGlyphHash(This))
+    return NULL;
+
   /* Open the face */
 #ifdef GLC_FT_CACHE
   if (FTC_Manager_LookupFace(inContext->cache, (FTC_FaceID)This, &face)) {
@@ -371,10 +423,15 @@ __GLCglyph* __glcFaceDescGetGlyph(__GLCfaceDescriptor* This,
 #endif
     return NULL;
   }
-  /* Append the new glyph to the list of the glyphes of the face and close the
-   * face.
+  /* Append the new glyph to the list of the glyphes of the face, insert it in
+   * the index and close the face.
    */
   FT_List_Add(&This->glyphList, (FT_ListNode)glyph);
+  mask = (1 << This->glyphHashBits) - 1;
+  for (i = __glcFaceDescHashCode(This, inCode); This->glyphHash[i];
+       i = (i + 1) & mask);
+  This->glyphHash[i] = glyph;
+  This->glyphCount++;
 #ifndef GLC_FT_CACHE
   __glcFaceDescClose(This);
 #endif
@@ -485,17 +542,30 @@ GLboolean __glcFaceDescPrepareGlyph(__GLCfaceDescriptor* This,
 				    const GLfloat inScaleY,
 				    const GLCulong inGlyphIndex)
 {
-  FT_Int32 loadFlags = FT_LOAD_NO_BITMAP | FT_LOAD_IGNORE_TRANSFORM
-                     | FT_LOAD_FORCE_AUTOHINT;
+  FT_Int32 loadFlags = FT_LOAD_NO_BITMAP | FT_LOAD_IGNORE_TRANSFORM;
 
   if (!__glcFaceDescPrepareFont(This, inContext, inScaleX, inScaleY))
     return GL_FALSE;
 
   /* If GLC_HINTING_QSO is enabled then perform hinting on the glyph while
-   * loading it.
+   * loading it, with the hinter selected by GLC_HINTING_PROFILE_QSO.
    */
-  if (!inContext->enableState.hinting && !inContext->enableState.glObjects)
+  switch(GLC_GET_HINTING_PROFILE(inContext)) {
+  case GLC_HINTING_NATIVE_QSO:
+    /* The bytecode interpreter is used if the face has hinting instructions,
+     * otherwise FreeType falls back to the auto-hinter.
+     */
+    break;
+  case GLC_HINTING_LIGHT_AUTO_QSO:
+    loadFlags |= FT_LOAD_FORCE_AUTOHINT | FT_LOAD_TARGET_LIGHT;
+    break;
+  case GLC_HINTING_FULL_AUTO_QSO:
+    loadFlags |= FT_LOAD_FORCE_AUTOHINT;
+    break;
+  default:
     loadFlags |= FT_LOAD_NO_HINTING;
+    break;
+  }
 
   /* Load the glyph */
   if (FT_Load_Glyph(This->face, inGlyphIndex, loadFlags)) {
@@ -511,6 +581,135 @@ GLboolean __glcFaceDescPrepareGlyph(__GLCfaceDescriptor* This,
 
 
 
+/* Load the glyph 'inGlyphIndex' from the bitmap strike of the face which size
+ * is 'inPixelSize' pixels. GL_FALSE is returned if the face has no such strike
+ * or if the glyph is not stored as a bitmap in the strike : no error is raised
+ * then since the caller must fall back to the outline of the glyph. If the
+ * bitmap is loaded, it is stored in the glyph slot of the face and, when the
+ * cache of FreeType is not used, the face must be closed by the caller.
+ */
+GLboolean __glcFaceDescLoadStrike(__GLCfaceDescriptor* This,
+				  __GLCcontext* inContext,
+				  const GLCulong inGlyphIndex,
+				  const GLint inPixelSize)
+{
+#ifdef GLC_FT_CACHE
+# if FREETYPE_MAJOR == 2 \
+     && (FREETYPE_MINOR < 1 \
+         || (FREETYPE_MINOR == 1 && FREETYPE_PATCH < 8))
+  FTC_FontRec font;
+# else
+  FTC_ScalerRec scaler;
+# endif
+  FT_Size size = NULL;
+#endif
+  FT_Face face = NULL;
+  FT_Int i = 0;
+
+  /* Look for a strike of the requested size in the face */
+#ifdef GLC_FT_CACHE
+  if (FTC_Manager_LookupFace(inContext->cache, (FTC_FaceID)This, &face))
+    return GL_FALSE;
+#else
+  face = __glcFaceDescOpen(This, inContext);
+  if (!face)
+    return GL_FALSE;
+#endif
+
+  if (FT_HAS_FIXED_SIZES(face)) {
+    for (i = 0; i < face->num_fixed_sizes; i++) {
+      if ((((face->available_sizes[i].x_ppem + 32) >> 6) == inPixelSize)
+	  && (((face->available_sizes[i].y_ppem + 32) >> 6) == inPixelSize))
+	break;
+    }
+  }
+
+  if (!FT_HAS_FIXED_SIZES(face) || (i == face->num_fixed_sizes)) {
+#ifndef GLC_FT_CACHE
+    __glcFaceDescClose(This);
+#endif
+    return GL_FALSE;
+  }
+
+  /* Select the strike : FreeType selects it when the size is given in pixels
+   * and matches the size of a strike.
+   */
+#ifdef GLC_FT_CACHE
+# if FREETYPE_MAJOR == 2 \
+     && (FREETYPE_MINOR < 1 \
+         || (FREETYPE_MINOR == 1 && FREETYPE_PATCH < 8))
+  font.face_id = (FTC_FaceID)This;
+  font.pix_width = (FT_UShort)inPixelSize;
+  font.pix_height = (FT_UShort)inPixelSize;
+
+  if (FTC_Manager_Lookup_Size(inContext->cache, &font, &This->face, &size))
+    return GL_FALSE;
+# else
+  scaler.face_id = (FTC_FaceID)This;
+  scaler.width = (FT_UInt)inPixelSize;
+  scaler.height = (FT_UInt)inPixelSize;
+  scaler.pixel = (FT_Int)1;
+  scaler.x_res = 0;
+  scaler.y_res = 0;
+
+  if (FTC_Manager_LookupSize(inContext->cache, &scaler, &size))
+    return GL_FALSE;
+
+  This->face = size->face;
+# endif /* FREETYPE_MAJOR */
+#else
+  if (FT_Set_Pixel_Sizes(This->face, (FT_UInt)inPixelSize,
+			 (FT_UInt)inPixelSize)) {
+    __glcFaceDescClose(This);
+    return GL_FALSE;
+  }
+#endif
+
+  /* FreeType loads the outline of the glyph if it is missing from the strike */
+  if (FT_Load_Glyph(This->face, inGlyphIndex,
+		    FT_LOAD_IGNORE_TRANSFORM | FT_LOAD_NO_HINTING)
+      || (This->face->glyph->format != FT_GLYPH_FORMAT_BITMAP)
+      || ((This->face->glyph->bitmap.pixel_mode != FT_PIXEL_MODE_MONO)
+	  && (This->face->glyph->bitmap.pixel_mode != FT_PIXEL_MODE_GRAY))) {
+#ifndef GLC_FT_CACHE
+    __glcFaceDescClose(This);
+#endif
+    return GL_FALSE;
+  }
+
+  return GL_TRUE;
+}
+
+
+
+/* Copy the outline 'inOutline' to the outline of the face descriptor. This is
+ * the outline that is decomposed or rasterized by the renderers, which may
+ * transform it : the cached outlines are then never given to them directly.
+ */
+GLboolean __glcFaceDescSetOutline(__GLCfaceDescriptor* This,
+				  const FT_Outline* inOutline)
+{
+  const size_t size = __glcOutlineGetSize(inOutline);
+
+  if (size > This->outlineBufferSize) {
+    void* buffer = __glcRealloc(This->outlineBufferSize ?
+				This->outline.points : NULL, size);
+
+    if (!buffer) {
+      __glcRaiseError(GLC_RESOURCE_ERROR);
+      return GL_FALSE;
+    }
+
+    This->outline.points = (FT_Vector*)buffer;
+    This->outlineBufferSize = size;
+  }
+
+  __glcOutlineCopy(&This->outline, This->outline.points, inOutline);
+  return GL_TRUE;
+}
+
+
+
 /* Destroy the GL objects of every glyph of the face */
 void __glcFaceDescDestroyGLObjects(const __GLCfaceDescriptor* This,
 				   __GLCcontext* inContext)
@@ -526,24 +725,68 @@ void __glcFaceDescDestroyGLObjects(const __GLCfaceDescriptor* This,
 
 
 
-/* Get the bounding box of a glyph according to the size given by inScaleX and
- * inScaleY. The result is returned in outVec. 'inGlyphIndex' contains the
- * index of the glyph in the font file.
+/* Get the advance and the bounding box of a glyph according to the size given
+ * by inScaleX and inScaleY. The metrics are looked up in the metric cache of
+ * the common area first : the glyph is only loaded by FreeType if no context
+ * has measured it with the same parameters yet.
  */
-GLfloat* __glcFaceDescGetBoundingBox(__GLCfaceDescriptor* This,
-				     const GLCulong inGlyphIndex,
-				     GLfloat* outVec, const GLfloat inScaleX,
-				     const GLfloat inScaleY,
-				     const __GLCcontext* inContext)
+static GLboolean __glcFaceDescGetMetrics(__GLCfaceDescriptor* This,
+					 const GLCulong inGlyphIndex,
+					 const GLfloat inScaleX,
+					 const GLfloat inScaleY,
+					 const __GLCcontext* inContext,
+					 __GLCmetric* outMetric)
 {
   FT_BBox boundBox;
   FT_Glyph glyph;
 
-  assert(outVec);
+  if (!This->metricFaceID) {
+    GLCchar8 *fileName = NULL;
+    int index = 0;
+#ifdef DEBUGMODE
+    FcResult result = FcResultMatch;
+
+    result = FcPatternGetString(This->pattern, FC_FILE, 0, &fileName);
+    assert(result != FcResultTypeMismatch);
+    result = FcPatternGetInteger(This->pattern, FC_INDEX, 0, &index);
+    assert(result != FcResultTypeMismatch);
+#else
+    FcPatternGetString(This->pattern, FC_FILE, 0, &fileName);
+    FcPatternGetInteger(This->pattern, FC_INDEX, 0, &index);
+#endif
+
+    This->metricFaceID =
+      __glcMetricCacheGetFaceID(&__glcCommonArea.metricCache, fileName,
+				index);
+  }
+
+  memset(outMetric, 0, sizeof(__GLCmetric));
+  outMetric->faceID = This->metricFaceID;
+  outMetric->glyphIndex = inGlyphIndex;
+  outMetric->scale[0] = inScaleX;
+  outMetric->scale[1] = inScaleY;
+
+  /* The resolution is only used by FreeType when GLC_GL_OBJECTS is disabled
+   * (see __glcFaceDescPrepareFont()).
+   */
+  outMetric->resolution = inContext->enableState.glObjects ? 72.f
+    : inContext->renderState.resolution;
+  outMetric->hinting = GLC_GET_HINTING_PROFILE(inContext);
+
+  if (__glcMetricCacheLookup(&__glcCommonArea.metricCache, outMetric))
+    return GL_TRUE;
 
   if (!__glcFaceDescPrepareGlyph(This, inContext, inScaleX, inScaleY,
 				 inGlyphIndex))
-    return NULL;
+    return GL_FALSE;
+
+  /* Transform the advance according to the conversion from FT_F26Dot6 to
+   * GLfloat.
+   */
+  outMetric->advance[0] = (GLfloat) This->face->glyph->advance.x / 64.
+    / inScaleX;
+  outMetric->advance[1] = (GLfloat) This->face->glyph->advance.y / 64.
+    / inScaleY;
 
   /* Get the bounding box of the glyph */
   FT_Get_Glyph(This->face->glyph, &glyph);
@@ -552,20 +795,161 @@ GLfloat* __glcFaceDescGetBoundingBox(__GLCfaceDescriptor* This,
   /* Transform the bounding box according to the conversion from FT_F26Dot6 to
    * GLfloat and the size in points of the glyph.
    */
-  outVec[0] = (GLfloat) boundBox.xMin / 64. / inScaleX;
-  outVec[2] = (GLfloat) boundBox.xMax / 64. / inScaleX;
-  outVec[1] = (GLfloat) boundBox.yMin / 64. / inScaleY;
-  outVec[3] = (GLfloat) boundBox.yMax / 64. / inScaleY;
+  outMetric->boundingBox[0] = (GLfloat) boundBox.xMin / 64. / inScaleX;
+  outMetric->boundingBox[2] = (GLfloat) boundBox.xMax / 64. / inScaleX;
+  outMetric->boundingBox[1] = (GLfloat) boundBox.yMin / 64. / inScaleY;
+  outMetric->boundingBox[3] = (GLfloat) boundBox.yMax / 64. / inScaleY;
 
   FT_Done_Glyph(glyph);
 #ifndef GLC_FT_CACHE
   __glcFaceDescClose(This);
 #endif
+
+  __glcMetricCacheInsert(&__glcCommonArea.metricCache, outMetric);
+  return GL_TRUE;
+}
+
+
+
+/* Get the bounding box of a glyph according to the size given by inScaleX and
+ * inScaleY. The result is returned in outVec. 'inGlyphIndex' contains the
+ * index of the glyph in the font file.
+ */
+GLfloat* __glcFaceDescGetBoundingBox(__GLCfaceDescriptor* This,
+				     const GLCulong inGlyphIndex,
+				     GLfloat* outVec, const GLfloat inScaleX,
+				     const GLfloat inScaleY,
+				     const __GLCcontext* inContext)
+{
+  __GLCmetric metric;
+
+  assert(outVec);
+
+  if (!__glcFaceDescGetMetrics(This, inGlyphIndex, inScaleX, inScaleY,
+			       inContext, &metric))
+    return NULL;
+
+  memcpy(outVec, metric.boundingBox, 4 * sizeof(GLfloat));
   return outVec;
 }
 
 
 
+#ifdef FT_ADVANCES_H
+/* Get the advance of a glyph without loading it. The advances of the glyphes
+ * are read by FreeType in bulk from the metrics tables of the face, by blocks
+ * of 2^GLC_ADVANCE_BLOCK_BITS consecutive glyph indices, and stored in the
+ * table 'advanceTable' for the last size that has been requested. This can
+ * only be done for unhinted glyphes, and only if the face format allows
+ * FreeType to read the advances quickly : GL_FALSE is returned otherwise and
+ * the glyph must be loaded.
+ */
+static GLboolean __glcFaceDescGetFastAdvance(__GLCfaceDescriptor* This,
+					     const GLCulong inGlyphIndex,
+					     GLfloat* outVec,
+					     const GLfloat inScaleX,
+					     const GLfloat inScaleY,
+					     const __GLCcontext* inContext)
+{
+  const GLfloat resolution = inContext->enableState.glObjects ? 72.f
+    : inContext->renderState.resolution;
+  const GLint block = (GLint)(inGlyphIndex >> GLC_ADVANCE_BLOCK_BITS);
+  const GLint blockSize = 1 << GLC_ADVANCE_BLOCK_BITS;
+  FT_Fixed* advances = NULL;
+
+  if (This->advanceBlockCount < 0)
+    return GL_FALSE;
+
+  /* The advances that have been read for another size are discarded */
+  if (This->advanceTable && ((This->advanceKey[0] != inScaleX)
+			     || (This->advanceKey[1] != inScaleY)
+			     || (This->advanceKey[2] != resolution)))
+    __glcFaceDescFlushAdvances(This);
+
+  This->advanceKey[0] = inScaleX;
+  This->advanceKey[1] = inScaleY;
+  This->advanceKey[2] = resolution;
+
+  if (!This->advanceTable || (block >= This->advanceBlockCount)
+      || !This->advanceTable[block]) {
+    FT_Int32 loadFlags = FT_LOAD_NO_HINTING | FT_LOAD_NO_BITMAP
+                       | FT_LOAD_IGNORE_TRANSFORM | FT_ADVANCE_FLAG_FAST_ONLY;
+    GLint first = block << GLC_ADVANCE_BLOCK_BITS;
+    FT_Error error;
+
+    if (!__glcFaceDescPrepareFont(This, inContext, inScaleX, inScaleY))
+      return GL_FALSE;
+
+    if (!This->advanceTable) {
+      This->advanceBlockCount = (This->face->num_glyphs + blockSize - 1)
+	>> GLC_ADVANCE_BLOCK_BITS;
+      This->advanceTable = (FT_Fixed**)__glcMalloc(This->advanceBlockCount
+						   * sizeof(FT_Fixed*));
+      if (!This->advanceTable) {
+	This->advanceBlockCount = 0;
+#ifndef GLC_FT_CACHE
+	__glcFaceDescClose(This);
+#endif
+	return GL_FALSE;
+      }
+      memset(This->advanceTable, 0,
+	     This->advanceBlockCount * sizeof(FT_Fixed*));
+    }
+
+    if (block >= This->advanceBlockCount) {
+#ifndef GLC_FT_CACHE
+      __glcFaceDescClose(This);
+#endif
+      return GL_FALSE;
+    }
+
+    advances = (FT_Fixed*)__glcMalloc(blockSize * sizeof(FT_Fixed));
+    if (!advances) {
+#ifndef GLC_FT_CACHE
+      __glcFaceDescClose(This);
+#endif
+      return GL_FALSE;
+    }
+
+    /* The last block of the face may be incomplete */
+    error = FT_Get_Advances(This->face, first,
+			    (blockSize < This->face->num_glyphs - first) ?
+			    blockSize : This->face->num_glyphs - first,
+			    loadFlags, advances);
+#ifndef GLC_FT_CACHE
+    __glcFaceDescClose(This);
+#endif
+
+    if (error) {
+      __glcFree(advances);
+
+      /* Don't try again if the face format does not allow it */
+      if (error == FT_Err_Unimplemented_Feature) {
+	__glcFaceDescFlushAdvances(This);
+	__glcFree(This->advanceTable);
+	This->advanceTable = NULL;
+	This->advanceBlockCount = -1;
+      }
+      return GL_FALSE;
+    }
+
+    This->advanceTable[block] = advances;
+  }
+
+  /* Transform the advance according to the conversion from FT_Fixed to
+   * GLfloat.
+   */
+  advances = This->advanceTable[block];
+  outVec[0] = (GLfloat)advances[inGlyphIndex & (blockSize - 1)] / 65536.
+    / inScaleX;
+  outVec[1] = 0.f;
+
+  return GL_TRUE;
+}
+#endif /* FT_ADVANCES_H */
+
+
+
 /* Get the advance of a glyph according to the size given by inScaleX and
  * inScaleY. The result is returned in outVec. 'inGlyphIndex' contains the
  * index of the glyph in the font file.
@@ -575,21 +959,25 @@ GLfloat* __glcFaceDescGetAdvance(__GLCfaceDescriptor* This,
 				 const GLfloat inScaleX, const GLfloat inScaleY,
 				 const __GLCcontext* inContext)
 {
-  assert(outVec);
+  __GLCmetric metric;
 
-  if (!__glcFaceDescPrepareGlyph(This, inContext, inScaleX, inScaleY,
-				 inGlyphIndex))
-    return NULL;
+  assert(outVec);
 
-  /* Transform the advance according to the conversion from FT_F26Dot6 to
-   * GLfloat.
+#ifdef FT_ADVANCES_H
+  /* When the glyphes are not hinted, the advance can be read without loading
+   * the glyph (see __glcFaceDescPrepareGlyph()).
    */
-  outVec[0] = (GLfloat) This->face->glyph->advance.x / 64. / inScaleX;
-  outVec[1] = (GLfloat) This->face->glyph->advance.y / 64. / inScaleY;
-
-#ifndef GLC_FT_CACHE
-  __glcFaceDescClose(This);
+  if ((GLC_GET_HINTING_PROFILE(inContext) == GLC_HINTING_NONE_QSO)
+      && __glcFaceDescGetFastAdvance(This, inGlyphIndex, outVec, inScaleX,
+				     inScaleY, inContext))
+    return outVec;
 #endif
+
+  if (!__glcFaceDescGetMetrics(This, inGlyphIndex, inScaleX, inScaleY,
+			       inContext, &metric))
+    return NULL;
+
+  memcpy(outVec, metric.advance, 2 * sizeof(GLfloat));
   return outVec;
 }
 
@@ -786,8 +1174,212 @@ GLfloat* __glcFaceDescGetMaxMetric(__GLCfaceDescriptor* This, GLfloat* outVec,
 
 
 
+/* Compare the glyph indices of two kerning pairs (callback of qsort() and
+ * bsearch()).
+ */
+static int __glcKerningPairCompare(const void* inPair1, const void* inPair2)
+{
+  const GLCuint glyphes1 = ((const __GLCkerningPair*)inPair1)->glyphes;
+  const GLCuint glyphes2 = ((const __GLCkerningPair*)inPair2)->glyphes;
+
+  return (glyphes1 > glyphes2) - (glyphes1 < glyphes2);
+}
+
+
+
+/* Read the kerning pairs of the subtables of the TrueType table 'kern' stored
+ * in 'inTable' and merge them in the table 'kerningPairs' of the face
+ * descriptor. The subtables are selected and merged the same way than
+ * FT_Get_Kerning() does : only the horizontal subtables of format 0 are used
+ * and the values of the pairs are either added or overridden according to the
+ * coverage of their subtable.
+ */
+static void __glcFaceDescReadKerningTable(__GLCfaceDescriptor* This,
+					  const FT_Byte* inTable,
+					  const FT_ULong inLength)
+{
+  const FT_Byte* limit = inTable + inLength;
+  const FT_Byte* p = inTable + 4;
+  GLint tableCount = 0;
+  GLint i = 0;
+
+#define GLC_PEEK_USHORT(p) ((GLint)(((GLCuint)(p)[0] << 8) | (p)[1]))
+#define GLC_PEEK_SHORT(p) ((GLint)(GLshort)GLC_PEEK_USHORT(p))
+
+  if (inLength < 4)
+    return;
+
+  /* There can not be more pairs than 6-bytes records in the table */
+  This->kerningPairs = (__GLCkerningPair*)__glcMalloc(inLength / 6
+						      * sizeof(__GLCkerningPair));
+  if (!This->kerningPairs)
+    return;
+
+  /* FreeType does not use more than 32 subtables */
+  tableCount = GLC_PEEK_USHORT(inTable + 2);
+  if (tableCount > 32)
+    tableCount = 32;
+
+  for (i = 0; i < tableCount; i++) {
+    const FT_Byte* next = NULL;
+    const GLint sortedCount = This->kerningPairCount;
+    GLint coverage = 0;
+    GLint pairCount = 0;
+    GLint j = 0;
+
+    if (p + 6 > limit)
+      break;
+
+    if (GLC_PEEK_USHORT(p + 2) <= 14)
+      break;
+
+    next = p + GLC_PEEK_USHORT(p + 2);
+    if (next > limit)
+      next = limit;
+
+    coverage = GLC_PEEK_USHORT(p + 4);
+
+    /* Only keep the horizontal subtables of format 0 (the format is stored in
+     * the high byte of the coverage) which header fits in the table.
+     */
+    if (((coverage & 3) != 0x0001) || (coverage >> 8) || (p + 14 > next)) {
+      p = next;
+      continue;
+    }
+
+    pairCount = GLC_PEEK_USHORT(p + 6);
+    p += 14;
+
+    if ((next - p) < 6 * pairCount)
+      pairCount = (GLint)((next - p) / 6);
+
+    for (j = 0; j < pairCount; j++, p += 6) {
+      __GLCkerningPair pair;
+      __GLCkerningPair* found = NULL;
+
+      pair.glyphes = ((GLCuint)GLC_PEEK_USHORT(p) << 16)
+	| (GLCuint)GLC_PEEK_USHORT(p + 2);
+      pair.value = GLC_PEEK_SHORT(p + 4);
+
+      /* Merge the pair with the pairs of the previous subtables */
+      if (sortedCount)
+	found = (__GLCkerningPair*)bsearch(&pair, This->kerningPairs,
+					   sortedCount,
+					   sizeof(__GLCkerningPair),
+					   __glcKerningPairCompare);
+
+      if (!found)
+	This->kerningPairs[This->kerningPairCount++] = pair;
+      else if (coverage & 8)
+	found->value = pair.value;
+      else
+	found->value += pair.value;
+    }
+
+    if (This->kerningPairCount > sortedCount)
+      qsort(This->kerningPairs, This->kerningPairCount,
+	    sizeof(__GLCkerningPair), __glcKerningPairCompare);
+
+    p = next;
+  }
+
+#undef GLC_PEEK_SHORT
+#undef GLC_PEEK_USHORT
+}
+
+
+
+/* Extract the kerning pairs of the face. They can only be read from the
+ * TrueType table 'kern' of scalable SFNT faces : for any other face, the
+ * member 'kerningState' is set to -1 so that the kerning is asked to FreeType.
+ */
+static void __glcFaceDescLoadKerning(__GLCfaceDescriptor* This,
+				     const __GLCcontext* inContext)
+{
+  FT_Face face = NULL;
+  FT_ULong length = 0;
+  FT_Byte* table = NULL;
+
+  This->kerningState = -1;
+
+  /* Open the face */
+#ifdef GLC_FT_CACHE
+  if (FTC_Manager_LookupFace(inContext->cache, (FTC_FaceID)This, &face))
+    return;
+#else
+  face = __glcFaceDescOpen(This, inContext);
+  if (!face)
+    return;
+#endif
+
+  if (!FT_IS_SFNT(face) || !FT_IS_SCALABLE(face))
+    goto close;
+
+  /* A face without the table 'kern' has no kerning pairs */
+  if (!FT_Load_Sfnt_Table(face, TTAG_kern, 0, NULL, &length)) {
+    table = (FT_Byte*)__glcMalloc(length);
+    if (!table)
+      goto close;
+
+    if (FT_Load_Sfnt_Table(face, TTAG_kern, 0, table, &length)) {
+      __glcFree(table);
+      goto close;
+    }
+
+    __glcFaceDescReadKerningTable(This, table, length);
+    __glcFree(table);
+
+    if (!This->kerningPairs)
+      goto close;
+  }
+
+  This->kerningState = 1;
+
+ close:
+#ifndef GLC_FT_CACHE
+  __glcFaceDescClose(This);
+#endif
+  return;
+}
+
+
+
+/* Get from FreeType the scale of the size given by inScaleX and inScaleY,
+ * unless it has already been stored for the same size and resolution.
+ */
+static GLboolean __glcFaceDescUpdateKerningScale(__GLCfaceDescriptor* This,
+						 const GLfloat inScaleX,
+						 const GLfloat inScaleY,
+						 const __GLCcontext* inContext)
+{
+  const GLfloat resolution = inContext->enableState.glObjects ? 72.f
+    : inContext->renderState.resolution;
+
+  if (This->kerningScale && (This->kerningKey[0] == inScaleX)
+      && (This->kerningKey[1] == resolution))
+    return GL_TRUE;
+
+  if (!__glcFaceDescPrepareFont(This, inContext, inScaleX, inScaleY))
+    return GL_FALSE;
+
+  This->kerningScale = This->face->size->metrics.x_scale;
+  This->kerningPpem = This->face->size->metrics.x_ppem;
+  This->kerningKey[0] = inScaleX;
+  This->kerningKey[1] = resolution;
+
+#ifndef GLC_FT_CACHE
+  __glcFaceDescClose(This);
+#endif
+
+  return GL_TRUE;
+}
+
+
+
 /* Get the kerning information of a pair of glyphes according to the size given
- * by inScaleX and inScaleY. The result is returned in outVec.
+ * by inScaleX and inScaleY. The result is returned in outVec. The kerning pairs
+ * are extracted from the face the first time that the kerning is requested,
+ * so that the glyphes do not need to be loaded.
  */
 GLfloat* __glcFaceDescGetKerning(__GLCfaceDescriptor* This,
 				 const GLCuint inGlyphIndex,
@@ -800,11 +1392,51 @@ GLfloat* __glcFaceDescGetKerning(__GLCfaceDescriptor* This,
 
   assert(outVec);
 
-  if (!__glcFaceDescPrepareGlyph(This, inContext, inScaleX, inScaleY,
-				 inGlyphIndex))
+  if (!This->kerningState)
+    __glcFaceDescLoadKerning(This, inContext);
+
+  if (This->kerningState > 0) {
+    __GLCkerningPair pair;
+    __GLCkerningPair* found = NULL;
+    FT_Pos value = 0;
+
+    pair.glyphes = (inPrevGlyphIndex << 16) | inGlyphIndex;
+    pair.value = 0;
+
+    if ((inGlyphIndex < 0x10000) && (inPrevGlyphIndex < 0x10000)
+	&& This->kerningPairCount)
+      found = (__GLCkerningPair*)bsearch(&pair, This->kerningPairs,
+					 This->kerningPairCount,
+					 sizeof(__GLCkerningPair),
+					 __glcKerningPairCompare);
+
+    outVec[0] = 0.;
+    outVec[1] = 0.;
+
+    if (!found)
+      return outVec;
+
+    if (!__glcFaceDescUpdateKerningScale(This, inScaleX, inScaleY, inContext))
+      return NULL;
+
+    /* Scale the kerning the same way than FT_Get_Kerning() does : the kerning
+     * of small sizes is scaled down before being rounded.
+     */
+    value = FT_MulFix(found->value, This->kerningScale);
+    if (This->kerningPpem < 25)
+      value = FT_MulDiv(value, This->kerningPpem, 25);
+
+    outVec[0] = (GLfloat)((value + 32) & -64) / 64. / inScaleX;
+    return outVec;
+  }
+
+  if (!__glcFaceDescPrepareFont(This, inContext, inScaleX, inScaleY))
     return NULL;
 
   if (!FT_HAS_KERNING(This->face)) {
+#ifndef GLC_FT_CACHE
+    __glcFaceDescClose(This);
+#endif
     outVec[0] = 0.;
     outVec[1] = 0.;
     return outVec;
@@ -992,7 +1624,7 @@ GLboolean __glcFaceDescOutlineDecompose(const __GLCfaceDescriptor* This,
 #endif
 
   /* Initialize the data for FreeType to parse the outline */
-  outline = &face->glyph->outline;
+  outline = (FT_Outline*)&This->outline;
   outlineInterface.shift = 0;
   outlineInterface.delta = 0;
   outlineInterface.move_to = __glcMoveTo;
@@ -1045,14 +1677,9 @@ GLboolean __glcFaceDescGetBitmapSize(const __GLCfaceDescriptor* This,
 				     const int inFactor,
 				     const __GLCcontext* inContext)
 {
-  FT_Outline outline;
+  FT_Outline outline = This->outline;
   FT_Matrix matrix;
   FT_BBox boundingBox;
-  FT_Face face = This->face;
-
-  assert(face);
-
-  outline = face->glyph->outline;
 
   if ((inContext->renderState.renderStyle == GLC_BITMAP)
       || (inContext->renderState.renderStyle == GLC_PIXMAP_QSO)) {
@@ -1104,46 +1731,57 @@ GLboolean __glcFaceDescGetBitmapSize(const __GLCfaceDescriptor* This,
       GLfloat ratioX = 0.f;
       GLfloat ratioY = 0.f;
       GLfloat ratio = 0.f;
+      FT_Pos xMin = boundingBox.xMin;
+      FT_Pos yMin = boundingBox.yMin;
 
       width = boundingBox.xMax - boundingBox.xMin;
       height = boundingBox.yMax - boundingBox.yMin;
 
-      ratioX = width / (64.f * GLC_TEXTURE_SIZE);
-      ratioY = height / (64.f * GLC_TEXTURE_SIZE);
+      ratioX = width / (64.f * (GLC_TEXTURE_SIZE - 2));
+      ratioY = height / (64.f * (GLC_TEXTURE_SIZE - 2));
 
       ratioX = (ratioX > 1.f) ? ratioX : 1.f;
       ratioY = (ratioY > 1.f) ? ratioY : 1.f;
       ratio = ((ratioX > ratioY) ? ratioX : ratioY);
 
-      *outWidth = GLC_TEXTURE_SIZE;
-      *outHeight = GLC_TEXTURE_SIZE;
-
       outline.flags |= FT_OUTLINE_HIGH_PRECISION;
 
+      /* Glyphes that do not fit in GLC_TEXTURE_SIZE x GLC_TEXTURE_SIZE (margins
+       * included) are scaled down.
+       */
       if (ratio > 1.f) {
-	outPixBoundingBox[0] = boundingBox.xMin
-	  - ((GLint)((GLC_TEXTURE_SIZE << 5) - (width * 0.5f)) * ratio);
-	outPixBoundingBox[1] = boundingBox.yMin
-	  - ((GLint)((GLC_TEXTURE_SIZE << 5) - (height * 0.5f)) * ratio);
-	outPixBoundingBox[2] = outPixBoundingBox[0]
-	  + ((GLint)((GLC_TEXTURE_SIZE << 6) * ratio));
-	outPixBoundingBox[3] = outPixBoundingBox[1]
-	  + ((GLint)((GLC_TEXTURE_SIZE << 6) * ratio));
-
 	matrix.xx = (FT_Fixed)(65536.f / ratio);
 	matrix.yy = matrix.xx;
 
 	FT_Outline_Transform(&outline, &matrix);
 	FT_Outline_Get_CBox(&outline, &boundingBox);
+
+	width = boundingBox.xMax - boundingBox.xMin;
+	height = boundingBox.yMax - boundingBox.yMin;
       }
-      else {
-	outPixBoundingBox[0] = boundingBox.xMin
-	  - ((GLC_TEXTURE_SIZE << 5) - (width >> 1));
-	outPixBoundingBox[1] = boundingBox.yMin
-	  - ((GLC_TEXTURE_SIZE << 5) - (height >> 1));
-	outPixBoundingBox[2] = outPixBoundingBox[0] + ((GLC_TEXTURE_SIZE - 1) << 6);
-	outPixBoundingBox[3] = outPixBoundingBox[1] + ((GLC_TEXTURE_SIZE - 1) << 6);
-      }
+
+      /* The pixmap is given the smallest size which is a multiple of
+       * GLC_ATLAS_GRANULARITY and which contains the glyph plus a margin of
+       * one texel on each side (so that bilinear filtering does not sample the
+       * neighbouring glyphes).
+       */
+      *outWidth = ((GLC_CEIL_26_6(width) >> 6) + 2 + GLC_ATLAS_GRANULARITY - 1)
+	& ~(GLC_ATLAS_GRANULARITY - 1);
+      *outHeight = ((GLC_CEIL_26_6(height) >> 6) + 2 + GLC_ATLAS_GRANULARITY - 1)
+	& ~(GLC_ATLAS_GRANULARITY - 1);
+      *outWidth = (*outWidth < GLC_TEXTURE_SIZE) ? *outWidth : GLC_TEXTURE_SIZE;
+      *outHeight = (*outHeight < GLC_TEXTURE_SIZE) ?
+	*outHeight : GLC_TEXTURE_SIZE;
+
+      /* The glyph is centered in the pixmap by __glcFaceDescGetBitmap() */
+      outPixBoundingBox[0] = xMin
+	- (GLint)(((*outWidth << 5) - (width >> 1)) * ratio);
+      outPixBoundingBox[1] = yMin
+	- (GLint)(((*outHeight << 5) - (height >> 1)) * ratio);
+      outPixBoundingBox[2] = outPixBoundingBox[0]
+	+ (GLint)(((*outWidth - 1) << 6) * ratio);
+      outPixBoundingBox[3] = outPixBoundingBox[1]
+	+ (GLint)(((*outHeight - 1) << 6) * ratio);
     }
     else {
       width = (GLC_CEIL_26_6(boundingBox.xMax)
@@ -1185,17 +1823,13 @@ GLboolean __glcFaceDescGetBitmap(const __GLCfaceDescriptor* This,
 				 const void* inBuffer,
 				 const __GLCcontext* inContext)
 {
-  FT_Outline outline;
+  FT_Outline outline = This->outline;
   FT_BBox boundingBox;
   FT_Bitmap pixmap;
   FT_Matrix matrix;
   FT_Pos dx = 0, dy = 0;
-  FT_Face face = This->face;
   FT_Pos width = 0, height = 0;
 
-  assert(face);
-
-  outline = face->glyph->outline;
   FT_Outline_Get_CBox(&outline, &boundingBox);
 
   if ((inContext->renderState.renderStyle == GLC_BITMAP)
@@ -1278,9 +1912,7 @@ GLboolean __glcFaceDescGetBitmap(const __GLCfaceDescriptor* This,
  */
 GLboolean __glcFaceDescOutlineEmpty(__GLCfaceDescriptor* This)
 {
-  FT_Outline outline = This->face->glyph->outline;
-
-  return outline.n_points ? GL_TRUE : GL_FALSE;
+  return This->outline.n_points ? GL_TRUE : GL_FALSE;
 }
 
 
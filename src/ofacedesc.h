@@ -28,8 +28,17 @@
 
 #include "omaster.h"
 
+#define GLC_GLYPH_HASH_MIN_BITS	6	/* The index has at least 64 slots */
+#define GLC_ADVANCE_BLOCK_BITS	6	/* The advances are read 64 at a time */
+
 typedef struct __GLCrendererDataRec __GLCrendererData;
 typedef struct __GLCfaceDescriptorRec __GLCfaceDescriptor;
+typedef struct __GLCkerningPairRec __GLCkerningPair;
+
+struct __GLCkerningPairRec {
+  GLCuint glyphes;		/* Left glyph index << 16 | right glyph index */
+  GLint value;			/* Kerning in font units */
+};
 
 struct __GLCfaceDescriptorRec {
   FT_ListNodeRec node;
@@ -39,6 +48,22 @@ struct __GLCfaceDescriptorRec {
   int faceRefCount;
 #endif
   FT_ListRec glyphList;
+  __GLCglyph** glyphHash;	/* Index of glyphList by codepoint */
+  GLint glyphHashBits;		/* The index has 2^glyphHashBits slots */
+  GLint glyphCount;		/* Number of glyphes in glyphList */
+  GLint metricFaceID;		/* ID of the face in the metric cache */
+  __GLCfontFile* file;		/* Face file mapped in memory or NULL */
+  FT_Fixed** advanceTable;	/* Unhinted advances by blocks of glyphes */
+  GLint advanceBlockCount;	/* -1 if they can not be read in bulk */
+  GLfloat advanceKey[3];	/* Scale and resolution of advanceTable */
+  __GLCkerningPair* kerningPairs; /* Sorted by glyph indices */
+  GLint kerningPairCount;
+  GLint kerningState;		/* 0 if not loaded yet, -1 to use FreeType */
+  FT_Fixed kerningScale;	/* Scale of FreeType for kerningKey */
+  GLint kerningPpem;		/* Size in pixels for kerningKey */
+  GLfloat kerningKey[2];	/* Scale and resolution of kerningScale */
+  FT_Outline outline;		/* Outline of the glyph being rendered */
+  size_t outlineBufferSize;	/* Memory allocated for the outline */
 };
 
 
@@ -49,7 +74,7 @@ __GLCfaceDescriptor* __glcFaceDescCreate(const __GLCmaster* inMaster,
 void __glcFaceDescDestroy(__GLCfaceDescriptor* This, __GLCcontext* inContext);
 #ifndef GLC_FT_CACHE
 FT_Face __glcFaceDescOpen(__GLCfaceDescriptor* This,
-			  __GLCcontext* inContext);
+			  const __GLCcontext* inContext);
 void __glcFaceDescClose(__GLCfaceDescriptor* This);
 #endif
 __GLCglyph* __glcFaceDescGetGlyph(__GLCfaceDescriptor* This,
@@ -62,6 +87,12 @@ GLboolean __glcFaceDescPrepareGlyph(__GLCfaceDescriptor* This,
 				    const GLfloat inScaleX,
 				    const GLfloat inScaleY,
 				    const GLCulong inGlyphIndex);
+GLboolean __glcFaceDescLoadStrike(__GLCfaceDescriptor* This,
+				  __GLCcontext* inContext,
+				  const GLCulong inGlyphIndex,
+				  const GLint inPixelSize);
+GLboolean __glcFaceDescSetOutline(__GLCfaceDescriptor* This,
+				  const FT_Outline* inOutline);
 GLfloat* __glcFaceDescGetBoundingBox(__GLCfaceDescriptor* This,
 				     const GLCulong inGlyphIndex,
 				     GLfloat* outVec, const GLfloat inScaleX,
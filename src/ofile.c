@@ -0,0 +1,195 @@
+/* QuesoGLC
+ * A free implementation of the OpenGL Character Renderer (GLC)
+ * Copyright (c) 2002, 2004-2009, Bertrand Coconnier
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+/* $Id$ */
+
+/** \file
+ * defines the object __GLCfontFile which maps a font file in memory. The faces
+ * are created by FreeType from the mapping so that a font file which is used by
+ * several faces or several contexts is read only once and is stored only once
+ * in memory.
+ */
+
+#include "internal.h"
+
+#if !defined(__WIN32__) && defined(HAVE_MMAP)
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+
+
+/* Map the file 'This->fileName' in memory. Return GL_FALSE if the file can not
+ * be mapped : the caller must then let FreeType read the file by itself.
+ */
+static GLboolean __glcFontFileMap(__GLCfontFile* This)
+{
+#ifdef __WIN32__
+  HANDLE file = INVALID_HANDLE_VALUE;
+  DWORD size = 0;
+
+  file = CreateFileA((LPCSTR)This->fileName, GENERIC_READ, FILE_SHARE_READ,
+		     NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+  if (file == INVALID_HANDLE_VALUE)
+    return GL_FALSE;
+
+  size = GetFileSize(file, NULL);
+  if ((size == INVALID_FILE_SIZE) || !size) {
+    CloseHandle(file);
+    return GL_FALSE;
+  }
+
+  /* The mapping keeps the file open */
+  This->mapping = CreateFileMapping(file, NULL, PAGE_READONLY, 0, 0, NULL);
+  CloseHandle(file);
+  if (!This->mapping)
+    return GL_FALSE;
+
+  This->data = (FT_Byte*)MapViewOfFile(This->mapping, FILE_MAP_READ, 0, 0, 0);
+  if (!This->data) {
+    CloseHandle(This->mapping);
+    This->mapping = NULL;
+    return GL_FALSE;
+  }
+
+  This->size = (FT_Long)size;
+  return GL_TRUE;
+#elif defined(HAVE_MMAP)
+  struct stat status;
+  void* data = NULL;
+  int file = open((const char*)This->fileName, O_RDONLY);
+
+  if (file < 0)
+    return GL_FALSE;
+
+  if (fstat(file, &status) || (status.st_size <= 0)) {
+    close(file);
+    return GL_FALSE;
+  }
+
+  data = mmap(NULL, (size_t)status.st_size, PROT_READ, MAP_SHARED, file, 0);
+  close(file);
+  if (data == MAP_FAILED)
+    return GL_FALSE;
+
+  This->data = (FT_Byte*)data;
+  This->size = (FT_Long)status.st_size;
+  return GL_TRUE;
+#else
+  return GL_FALSE;
+#endif
+}
+
+
+
+/* Unmap the file 'This->fileName' from memory */
+static void __glcFontFileUnmap(__GLCfontFile* This)
+{
+#ifdef __WIN32__
+  UnmapViewOfFile(This->data);
+  CloseHandle(This->mapping);
+#elif defined(HAVE_MMAP)
+  munmap(This->data, (size_t)This->size);
+#endif
+}
+
+
+
+/* Return the font file 'inFileName' mapped in memory and increment its
+ * reference count. If the file has not been mapped yet by another face
+ * descriptor, it is mapped now. NULL is returned if the file can not be
+ * mapped, in which case FreeType must open the file by itself : hence no
+ * error is raised.
+ */
+__GLCfontFile* __glcFontFileAcquire(const GLCchar8* inFileName)
+{
+  FT_ListNode node = NULL;
+  __GLCfontFile* This = NULL;
+
+  __glcLock();
+
+  for (node = __glcCommonArea.fontFiles.head; node; node = node->next) {
+    This = (__GLCfontFile*)node;
+
+    if (!strcmp((const char*)This->fileName, (const char*)inFileName)) {
+      This->refCount++;
+      __glcUnlock();
+      return This;
+    }
+  }
+
+  This = (__GLCfontFile*)__glcMalloc(sizeof(__GLCfontFile));
+  if (!This) {
+    __glcUnlock();
+    return NULL;
+  }
+  memset(This, 0, sizeof(__GLCfontFile));
+
+#ifdef __WIN32__
+  This->fileName = (GLCchar8*)_strdup((const char*)inFileName);
+#else
+  This->fileName = (GLCchar8*)strdup((const char*)inFileName);
+#endif
+  if (!This->fileName) {
+    __glcFree(This);
+    __glcUnlock();
+    return NULL;
+  }
+
+  if (!__glcFontFileMap(This)) {
+    free(This->fileName);
+    __glcFree(This);
+    __glcUnlock();
+    return NULL;
+  }
+
+  This->refCount = 1;
+  This->node.data = This;
+  FT_List_Add(&__glcCommonArea.fontFiles, (FT_ListNode)This);
+
+  __glcUnlock();
+  return This;
+}
+
+
+
+/* Decrement the reference count of the font file and unmap it when it is no
+ * longer used. The faces that FreeType has created from the mapping must have
+ * been destroyed beforehand.
+ */
+void __glcFontFileRelease(__GLCfontFile* This)
+{
+  __glcLock();
+
+  assert(This->refCount > 0);
+
+  if (--This->refCount) {
+    __glcUnlock();
+    return;
+  }
+
+  FT_List_Remove(&__glcCommonArea.fontFiles, (FT_ListNode)This);
+  __glcUnlock();
+
+  __glcFontFileUnmap(This);
+  free(This->fileName);
+  __glcFree(This);
+}
@@ -0,0 +1,56 @@
+/* QuesoGLC
+ * A free implementation of the OpenGL Character Renderer (GLC)
+ * Copyright (c) 2002, 2004-2009, Bertrand Coconnier
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+/* $Id$ */
+
+/** \file
+ * header of the object __GLCfontFile which maps a font file in memory once for
+ * all the faces and all the contexts of the process.
+ */
+
+#ifndef __glc_ofile_h
+#define __glc_ofile_h
+
+#ifdef __WIN32__
+#include <windows.h>
+#endif
+
+#include <ft2build.h>
+#include FT_FREETYPE_H
+#include FT_LIST_H
+
+typedef struct __GLCfontFileRec __GLCfontFile;
+
+/* The font files are stored in the list 'fontFiles' of the common area. Each
+ * face descriptor that uses a file holds a reference on it, so the file is
+ * unmapped when the last face descriptor which uses it is destroyed.
+ */
+struct __GLCfontFileRec {
+  FT_ListNodeRec node;
+  GLCchar8* fileName;
+  GLint refCount;
+  FT_Byte* data;		/* Content of the file */
+  FT_Long size;			/* Size of the file in bytes */
+#ifdef __WIN32__
+  HANDLE mapping;
+#endif
+};
+
+__GLCfontFile* __glcFontFileAcquire(const GLCchar8* inFileName);
+void __glcFontFileRelease(__GLCfontFile* This);
+#endif
@@ -26,6 +26,7 @@
 
 #include <math.h>
 #include "internal.h"
+#include "outline.h"
 
 
 
@@ -322,6 +323,7 @@ GLboolean __glcFontFace(__GLCfont* This, const GLCchar8* inFace,
     __glcCharMapDestroy(This->charMap);
 
   This->charMap = newCharMap;
+  __glcContextFlushFontCache(inContext);
 
   __glcFaceDescDestroy(This->faceDesc, inContext);
   This->faceDesc = faceDesc;
@@ -333,21 +335,16 @@ GLboolean __glcFontFace(__GLCfont* This, const GLCchar8* inFace,
 
 
 
-/* Load a glyph of the current font face and stores the corresponding data in
- * the corresponding face. The size of the glyph is given by inScaleX and
- * inScaleY. 'inGlyphIndex' contains the index of the glyph in the font file.
+/* Get the outline of a glyph of the current font face and stores it in the
+ * corresponding face so that it can be rendered. The size of the glyph is
+ * given by inScaleX and inScaleY. The glyph is only loaded if its outline is
+ * not found in the outline cache (see outline.c).
  */
 GLboolean __glcFontPrepareGlyph(const __GLCfont* This,
-				const __GLCcontext* inContext,
+				__GLCcontext* inContext,
 				const GLfloat inScaleX, const GLfloat inScaleY,
-				const GLCulong inGlyphIndex)
+				__GLCglyph* inGlyph)
 {
-  GLboolean result = __glcFaceDescPrepareGlyph(This->faceDesc, inContext,
-					       inScaleX, inScaleY,
-					       inGlyphIndex);
-#ifndef GLC_FT_CACHE
-  __glcFaceDescClose(This->faceDesc);
-#endif
-
-  return result;
+  return __glcOutlineCacheLoad(inContext, This->faceDesc, inGlyph, inScaleX,
+			       inScaleY);
 }
@@ -58,9 +58,9 @@ GLfloat* __glcFontGetKerning(const __GLCfont* This, const GLint inCode,
 			     const __GLCcontext* inContext,
 			     const GLfloat inScaleX, const GLfloat inScaleY);
 GLboolean __glcFontPrepareGlyph(const __GLCfont* This,
-				const __GLCcontext* inContext,
+				__GLCcontext* inContext,
 				const GLfloat inScaleX, const GLfloat inScaleY,
-				const GLCulong inGlyphIndex);
+				__GLCglyph* inGlyph);
 GLfloat* __glcFontGetMaxMetric(__GLCfont* This, GLfloat* outVec,
 			       const __GLCcontext* inContext,
 			       const GLfloat inScaleX, const GLfloat inScaleY);
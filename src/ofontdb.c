@@ -0,0 +1,660 @@
+/* QuesoGLC
+ * A free implementation of the OpenGL Character Renderer (GLC)
+ * Copyright (c) 2002, 2004-2009, Bertrand Coconnier
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+/* $Id$ */
+
+/** \file
+ * defines the object __GLCfontDatabase which stores the Fontconfig
+ * configuration, the catalogs and the table of the masters. The database is
+ * reference counted so that all the contexts which use the same catalogs share
+ * a single copy of it.
+ */
+
+#include "internal.h"
+
+
+
+/* Find a token in a list of tokens separated by 'separator' */
+static GLCchar8* __glcFindIndexList(GLCchar8* inString, const GLuint inIndex,
+				    const GLCchar8* inSeparator)
+{
+  GLuint occurence = 0;
+  GLCchar8* s = inString;
+  const GLCchar8* sep = inSeparator;
+
+  if (!inIndex)
+    return s;
+
+  for (; *s != '\0'; s++) {
+    if (*s == *sep) {
+      occurence++;
+      if (occurence == inIndex)
+	break;
+    }
+  }
+
+  return (GLCchar8 *) s;
+}
+
+
+
+/* Destroy the table of the masters that has been built by
+ * __glcFontDatabaseUpdate().
+ */
+static void __glcFontDatabaseDestroyMasterTable(__GLCfontDatabase* This)
+{
+  __GLCmasterInfo* masterInfo = NULL;
+  int i = 0;
+
+  if (!This->masterTable)
+    return;
+
+  masterInfo = (__GLCmasterInfo*)GLC_ARRAY_DATA(This->masterTable);
+  for (i = 0; i < GLC_ARRAY_LENGTH(This->masterTable); i++) {
+    if (masterInfo[i].pattern)
+      FcPatternDestroy(masterInfo[i].pattern);
+    if (masterInfo[i].charSet)
+      FcCharSetDestroy(masterInfo[i].charSet);
+  }
+  __glcArrayDestroy(This->masterTable);
+  FcFontSetDestroy(This->masterFontSet);
+  if (This->masterNextFace)
+    __glcFree(This->masterNextFace);
+  if (This->masterIndex)
+    __glcFree(This->masterIndex);
+
+  This->masterTable = NULL;
+  This->masterFontSet = NULL;
+  This->masterNextFace = NULL;
+  This->masterIndex = NULL;
+}
+
+
+
+/* Destructor of the object */
+static void __glcFontDatabaseDestroy(__GLCfontDatabase* This)
+{
+  int i = 0;
+
+  assert(This);
+
+  /* Destroy the list of catalogs */
+  if (This->catalogList) {
+    for (i = 0; i < GLC_ARRAY_LENGTH(This->catalogList); i++) {
+      GLCchar8* string = ((GLCchar8**)GLC_ARRAY_DATA(This->catalogList))[i];
+
+      assert(string);
+      free(string);
+    }
+    __glcArrayDestroy(This->catalogList);
+  }
+
+  if (This->masterHashTable)
+    __glcArrayDestroy(This->masterHashTable);
+  __glcFontDatabaseDestroyMasterTable(This);
+
+  if (This->config)
+    FcConfigDestroy(This->config);
+  __glcFree(This);
+}
+
+
+
+/* Constructor of the object : it allocates memory and initializes the member
+ * of the new object. The database only contains the fonts of the default
+ * Fontconfig configuration and its table of the masters is empty.
+ */
+static __GLCfontDatabase* __glcFontDatabaseCreate(void)
+{
+  __GLCfontDatabase* This = NULL;
+
+  This = (__GLCfontDatabase*)__glcMalloc(sizeof(__GLCfontDatabase));
+  if (!This) {
+    __glcRaiseError(GLC_RESOURCE_ERROR);
+    return NULL;
+  }
+  memset(This, 0, sizeof(__GLCfontDatabase));
+  This->refCount = 1;
+
+  __glcLock();
+  This->config = FcInitLoadConfigAndFonts();
+  __glcUnlock();
+  if (!This->config) {
+    __glcRaiseError(GLC_RESOURCE_ERROR);
+    __glcFree(This);
+    return NULL;
+  }
+
+  This->catalogList = __glcArrayCreate(sizeof(GLCchar8*));
+  if (!This->catalogList) {
+    __glcFontDatabaseDestroy(This);
+    return NULL;
+  }
+
+  This->masterHashTable = __glcArrayCreate(sizeof(GLCchar32));
+  if (!This->masterHashTable) {
+    __glcFontDatabaseDestroy(This);
+    return NULL;
+  }
+
+  return This;
+}
+
+
+
+/* Add the catalogs listed in the environment variables GLC_CATALOG_LIST or
+ * GLC_PATH to the database. A catalog that can not be added is skipped.
+ */
+static void __glcFontDatabaseAddEnvCatalogs(__GLCfontDatabase* This)
+{
+  GLCchar8 *path = NULL;
+  GLCchar8 *begin = NULL;
+  GLCchar8 *sepPos = NULL;
+  const GLCchar8 *separator = (GLCchar8*)getenv("GLC_LIST_SEPARATOR");
+  GLCchar8* duplicated = NULL;
+
+  /* The environment variable GLC_PATH is an alternate way to allow QuesoGLC
+   * to access to fonts catalogs/directories.
+   */
+  /*Check if the GLC_PATH environment variables are exported */
+  if (!getenv("GLC_CATALOG_LIST") && !getenv("GLC_PATH"))
+    return;
+
+  /* Get the list separator */
+  if (!separator) {
+#ifdef __WIN32__
+    /* Windows can not use a colon-separated list since the colon sign is
+     * used after the drive letter. The semicolon is used by Windows for its
+     * PATH variable, so we use it for consistency.
+     */
+    separator = (const GLCchar8*)";";
+#else
+    /* POSIX platforms use colon-separated lists for the paths variables
+     * so we keep with it for consistency.
+     */
+    separator = (const GLCchar8*)":";
+#endif
+  }
+
+  /* Read the paths of fonts file.
+   * First, try GLC_CATALOG_LIST...
+   */
+  if (getenv("GLC_CATALOG_LIST"))
+#ifdef __WIN32__
+    path = (GLCchar8*)_strdup(getenv("GLC_CATALOG_LIST"));
+#else
+    path = (GLCchar8*)strdup(getenv("GLC_CATALOG_LIST"));
+#endif
+  /* Then try GLC_PATH */
+  else if (getenv("GLC_PATH")) {
+#ifdef __WIN32__
+    path = (GLCchar8*)_strdup(getenv("GLC_PATH"));
+#else
+    path = (GLCchar8*)strdup(getenv("GLC_PATH"));
+#endif
+  }
+
+  if (!path) {
+    /* strdup has failed to allocate memory to duplicate GLC_PATH => ERROR */
+    __glcRaiseError(GLC_RESOURCE_ERROR);
+    return;
+  }
+
+  /* Get each path and add the corresponding fonts to the database */
+  begin = path;
+  do {
+    sepPos = __glcFindIndexList(begin, 1, separator);
+
+    if (*sepPos)
+      *(sepPos++) = 0;
+
+#ifdef __WIN32__
+    duplicated = (GLCchar8*)_strdup((char*)begin);
+#else
+    duplicated = (GLCchar8*)strdup((char*)begin);
+#endif
+    if (!duplicated) {
+      __glcRaiseError(GLC_RESOURCE_ERROR);
+    }
+    else {
+      if (!__glcArrayAppend(This->catalogList, &duplicated))
+	free(duplicated);
+      else if (!FcConfigAppFontAddDir(This->config,
+				      (const unsigned char*)begin)) {
+	__glcArrayRemove(This->catalogList,
+			 GLC_ARRAY_LENGTH(This->catalogList) - 1);
+	__glcRaiseError(GLC_RESOURCE_ERROR);
+	free(duplicated);
+      }
+    }
+
+    begin = sepPos;
+  } while (*sepPos);
+  free(path);
+}
+
+
+
+/* Create a copy of the database 'This' which is only referenced by the caller.
+ * The catalogs are added again to a new Fontconfig configuration and the
+ * masters keep their ID.
+ */
+static __GLCfontDatabase* __glcFontDatabaseDuplicate(const __GLCfontDatabase*
+						     This)
+{
+  __GLCfontDatabase* database = __glcFontDatabaseCreate();
+  int i = 0;
+
+  if (!database)
+    return NULL;
+
+  for (i = 0; i < GLC_ARRAY_LENGTH(This->catalogList); i++) {
+    GLCchar8* catalog = ((GLCchar8**)GLC_ARRAY_DATA(This->catalogList))[i];
+#ifdef __WIN32__
+    GLCchar8* duplicated = (GLCchar8*)_strdup((const char*)catalog);
+#else
+    GLCchar8* duplicated = (GLCchar8*)strdup((const char*)catalog);
+#endif
+
+    if (!duplicated) {
+      __glcRaiseError(GLC_RESOURCE_ERROR);
+      goto error;
+    }
+
+    if (!__glcArrayAppend(database->catalogList, &duplicated)) {
+      free(duplicated);
+      goto error;
+    }
+
+    if (!FcConfigAppFontAddDir(database->config, catalog)) {
+      __glcRaiseError(GLC_RESOURCE_ERROR);
+      goto error;
+    }
+  }
+
+  __glcArrayDestroy(database->masterHashTable);
+  database->masterHashTable = __glcArrayDuplicate(This->masterHashTable);
+  if (!database->masterHashTable)
+    goto error;
+
+  if (!__glcFontDatabaseUpdate(database))
+    goto error;
+
+  return database;
+
+ error:
+  __glcFontDatabaseDestroy(database);
+  return NULL;
+}
+
+
+
+/* Return a reference to the database of the default catalogs (the fonts of
+ * Fontconfig and the catalogs of the environment variables). The database is
+ * created by the first context that needs it, then the next contexts share it
+ * until one of them changes its catalogs.
+ */
+__GLCfontDatabase* __glcFontDatabaseGetDefault(void)
+{
+  __GLCfontDatabase* This = NULL;
+
+  __glcLock();
+
+  This = __glcCommonArea.fontDatabase;
+  if (This) {
+    This->refCount++;
+    __glcUnlock();
+    return This;
+  }
+
+  This = __glcFontDatabaseCreate();
+  if (!This) {
+    __glcUnlock();
+    return NULL;
+  }
+
+  __glcFontDatabaseAddEnvCatalogs(This);
+
+  if (!__glcFontDatabaseUpdate(This)) {
+    __glcFontDatabaseDestroy(This);
+    __glcUnlock();
+    return NULL;
+  }
+
+  __glcCommonArea.fontDatabase = This;
+  __glcUnlock();
+  return This;
+}
+
+
+
+/* Return a database that can be modified by the caller : if 'This' is
+ * referenced by other contexts, a copy is created and the reference to 'This'
+ * is released. NULL is returned if the copy can not be created, in which case
+ * the caller keeps its reference to 'This'.
+ */
+__GLCfontDatabase* __glcFontDatabaseUnshare(__GLCfontDatabase* This)
+{
+  __GLCfontDatabase* database = NULL;
+
+  __glcLock();
+  if (This->refCount == 1) {
+    /* The database is about to be modified : the new contexts must not use it
+     * any longer.
+     */
+    if (__glcCommonArea.fontDatabase == This)
+      __glcCommonArea.fontDatabase = NULL;
+    __glcUnlock();
+    return This;
+  }
+  __glcUnlock();
+
+  /* The catalogs and the masters of a shared database are never modified so
+   * they can be copied without locking. Only the character sets of the
+   * masters ('masterInfo->charSet') are written lazily, under the lock of the
+   * common area, by __glcMasterGetCharSet() : the readers of these character
+   * sets must hold that lock. The copy does not read them since its table of
+   * the masters is built again by __glcFontDatabaseUpdate().
+   */
+  database = __glcFontDatabaseDuplicate(This);
+  if (!database)
+    return NULL;
+
+  __glcFontDatabaseRelease(This);
+  return database;
+}
+
+
+
+/* Release a reference to the database. The database is destroyed when it is
+ * no longer referenced by any context.
+ */
+void __glcFontDatabaseRelease(__GLCfontDatabase* This)
+{
+  assert(This);
+
+  __glcLock();
+  assert(This->refCount > 0);
+  This->refCount--;
+  if (!This->refCount) {
+    if (__glcCommonArea.fontDatabase == This)
+      __glcCommonArea.fontDatabase = NULL;
+    __glcFontDatabaseDestroy(This);
+  }
+  __glcUnlock();
+}
+
+
+
+/* Look for the hash value 'inHashValue' in the index 'inIndex' of the hash
+ * table of the masters. The index is an open addressing table of 2^inBits
+ * slots which contain the master ID plus one (or zero if the slot is empty).
+ * The ID of the master is returned, or -1 if the hash value is not found. If
+ * 'outSlot' is not NULL, the slot where the search has stopped is stored
+ * there.
+ */
+static GLint __glcFontDatabaseLookupMasterIndex(const GLint* inIndex,
+						const GLint inBits,
+						const __GLCarray* inHashTable,
+						const GLCchar32 inHashValue,
+						GLuint* outSlot)
+{
+  const GLCchar32* hashTable = (const GLCchar32*)GLC_ARRAY_DATA(inHashTable);
+  const GLuint mask = (1 << inBits) - 1;
+  GLuint i = inHashValue & mask;
+
+  for (; inIndex[i]; i = (i + 1) & mask) {
+    const GLint id = inIndex[i] - 1;
+
+    if ((id < GLC_ARRAY_LENGTH(inHashTable)) && (hashTable[id] == inHashValue))
+      break;
+  }
+
+  if (outSlot)
+    *outSlot = i;
+
+  return inIndex[i] ? inIndex[i] - 1 : -1;
+}
+
+
+
+/* Return the ID of the master which hash value is 'inHashValue' or -1 if no
+ * master has such a hash value.
+ */
+GLint __glcFontDatabaseGetMasterID(const __GLCfontDatabase* This,
+				   const GLCchar32 inHashValue)
+{
+  if (!This->masterIndex)
+    return -1;
+
+  return __glcFontDatabaseLookupMasterIndex(This->masterIndex,
+					    This->masterIndexBits,
+					    This->masterHashTable, inHashValue,
+					    NULL);
+}
+
+
+
+/* Update the hash table that which is used to convert master IDs into
+ * FontConfig patterns, and build the table of the masters.
+ */
+GLboolean __glcFontDatabaseUpdate(__GLCfontDatabase* This)
+{
+  FcPattern* pattern = NULL;
+  FcObjectSet* objectSet = NULL;
+  FcFontSet *fontSet = NULL;
+  int i = 0;
+  __GLCarray *updatedHashTable = NULL;
+  __GLCarray *masterTable = NULL;
+  __GLCmasterInfo* masterInfo = NULL;
+  GLint* nextFace = NULL;
+  GLint* masterIndex = NULL;
+  GLint bits = 4;
+
+  /* Use Fontconfig to get the default font files. The font set is kept in the
+   * database so that the faces of the masters are not listed again each time
+   * that a master is accessed.
+   */
+  pattern = FcPatternCreate();
+  if (!pattern) {
+    __glcRaiseError(GLC_RESOURCE_ERROR);
+    return GL_FALSE;
+  }
+  objectSet = FcObjectSetBuild(FC_FAMILY, FC_FOUNDRY, FC_STYLE, FC_SPACING,
+			       FC_FILE, FC_INDEX, FC_OUTLINE, FC_CHARSET, NULL);
+  if (!objectSet) {
+    __glcRaiseError(GLC_RESOURCE_ERROR);
+    FcPatternDestroy(pattern);
+    return GL_FALSE;
+  }
+  fontSet = FcFontList(This->config, pattern, objectSet);
+  FcPatternDestroy(pattern);
+  FcObjectSetDestroy(objectSet);
+  if (!fontSet) {
+    __glcRaiseError(GLC_RESOURCE_ERROR);
+    return GL_FALSE;
+  }
+
+  updatedHashTable = __glcArrayDuplicate(This->masterHashTable);
+  if (!updatedHashTable) {
+    FcFontSetDestroy(fontSet);
+    return GL_FALSE;
+  }
+
+  masterTable = __glcArrayCreate(sizeof(__GLCmasterInfo));
+  if (!masterTable) {
+    FcFontSetDestroy(fontSet);
+    __glcArrayDestroy(updatedHashTable);
+    return GL_FALSE;
+  }
+
+  if (fontSet->nfont) {
+    nextFace = (GLint*)__glcMalloc(fontSet->nfont * sizeof(GLint));
+    if (!nextFace) {
+      __glcRaiseError(GLC_RESOURCE_ERROR);
+      FcFontSetDestroy(fontSet);
+      __glcArrayDestroy(updatedHashTable);
+      __glcArrayDestroy(masterTable);
+      return GL_FALSE;
+    }
+  }
+
+  /* The index of the hash table is kept at most half full : since each font
+   * adds at most one master, its size is computed once for all.
+   */
+  while ((1 << bits) < 2 * (GLC_ARRAY_LENGTH(updatedHashTable)
+			    + fontSet->nfont))
+    bits++;
+  masterIndex = (GLint*)__glcMalloc((1 << bits) * sizeof(GLint));
+  if (!masterIndex) {
+    __glcRaiseError(GLC_RESOURCE_ERROR);
+    goto error;
+  }
+  memset(masterIndex, 0, (1 << bits) * sizeof(GLint));
+
+  /* The masters that are already registered keep their ID */
+  for (i = 0; i < GLC_ARRAY_LENGTH(updatedHashTable); i++) {
+    __GLCmasterInfo info = {NULL, 0, -1, -1, NULL};
+    GLCchar32* hashTable = (GLCchar32*)GLC_ARRAY_DATA(updatedHashTable);
+    GLuint slot = 0;
+
+    if (!__glcArrayAppend(masterTable, &info))
+      goto error;
+
+    __glcFontDatabaseLookupMasterIndex(masterIndex, bits, updatedHashTable,
+				  hashTable[i], &slot);
+    masterIndex[slot] = i + 1;
+  }
+
+  /* Parse the font set looking for fonts that are not already registered in the
+   * hash table, and gather the faces of each master.
+   */
+  for (i = 0; i < fontSet->nfont; i++) {
+    GLCchar32 hashValue = 0;
+    GLint j = 0;
+    GLuint slot = 0;
+    FcBool outline = FcFalse;
+    FcChar8* family = NULL;
+    int fixed = 0;
+    FcChar8* foundry = NULL;
+#ifdef DEBUGMODE
+    FcResult result = FcResultMatch;
+
+    result = FcPatternGetBool(fontSet->fonts[i], FC_OUTLINE, 0, &outline);
+    assert(result != FcResultTypeMismatch);
+#else
+    FcPatternGetBool(fontSet->fonts[i], FC_OUTLINE, 0, &outline);
+#endif
+
+    nextFace[i] = -1;
+
+    /* Check whether the glyphs are outlines */
+    if (!outline)
+      continue;
+
+#ifdef DEBUGMODE
+    result = FcPatternGetString(fontSet->fonts[i], FC_FAMILY, 0, &family);
+    assert(result != FcResultTypeMismatch);
+    result = FcPatternGetString(fontSet->fonts[i], FC_FOUNDRY, 0, &foundry);
+    assert(result != FcResultTypeMismatch);
+    result = FcPatternGetInteger(fontSet->fonts[i], FC_SPACING, 0, &fixed);
+    assert(result != FcResultTypeMismatch);
+#else
+    FcPatternGetString(fontSet->fonts[i], FC_FAMILY, 0, &family);
+    FcPatternGetString(fontSet->fonts[i], FC_FOUNDRY, 0, &foundry);
+    FcPatternGetInteger(fontSet->fonts[i], FC_SPACING, 0, &fixed);
+#endif
+
+    if (foundry)
+      pattern = FcPatternBuild(NULL, FC_FAMILY, FcTypeString, family,
+			       FC_FOUNDRY, FcTypeString, foundry, FC_SPACING,
+			       FcTypeInteger, fixed, NULL);
+    else
+      pattern = FcPatternBuild(NULL, FC_FAMILY, FcTypeString, family,
+			       FC_SPACING, FcTypeInteger, fixed, NULL);
+
+    if (!pattern) {
+      __glcRaiseError(GLC_RESOURCE_ERROR);
+      goto error;
+    }
+
+    /* Check if the font is already registered in the hash table */
+    hashValue = FcPatternHash(pattern);
+    j = __glcFontDatabaseLookupMasterIndex(masterIndex, bits, updatedHashTable,
+				      hashValue, &slot);
+
+    /* Register the font (i.e. append its hash value to the hash table) */
+    if (j < 0) {
+      __GLCmasterInfo info = {NULL, 0, -1, -1, NULL};
+
+      j = GLC_ARRAY_LENGTH(updatedHashTable);
+      if (!__glcArrayAppend(updatedHashTable, &hashValue)) {
+	FcPatternDestroy(pattern);
+	goto error;
+      }
+      if (!__glcArrayAppend(masterTable, &info)) {
+	FcPatternDestroy(pattern);
+	goto error;
+      }
+      masterIndex[slot] = j + 1;
+    }
+
+    /* Append the font to the faces of the master */
+    masterInfo = (__GLCmasterInfo*)GLC_ARRAY_DATA(masterTable) + j;
+    if (masterInfo->pattern) {
+      FcPatternDestroy(pattern);
+      nextFace[masterInfo->lastFace] = i;
+    }
+    else {
+      masterInfo->pattern = pattern;
+      masterInfo->firstFace = i;
+    }
+    masterInfo->lastFace = i;
+    if (!__glcMasterIsDuplicateFace(fontSet, nextFace, masterInfo->firstFace,
+				    i))
+      masterInfo->faceCount++;
+  }
+
+  __glcArrayDestroy(This->masterHashTable);
+  This->masterHashTable = updatedHashTable;
+  __glcFontDatabaseDestroyMasterTable(This);
+  This->masterTable = masterTable;
+  This->masterFontSet = fontSet;
+  This->masterNextFace = nextFace;
+  if (This->masterIndex)
+    __glcFree(This->masterIndex);
+  This->masterIndex = masterIndex;
+  This->masterIndexBits = bits;
+
+  return GL_TRUE;
+
+ error:
+  masterInfo = (__GLCmasterInfo*)GLC_ARRAY_DATA(masterTable);
+  for (i = 0; i < GLC_ARRAY_LENGTH(masterTable); i++) {
+    if (masterInfo[i].pattern)
+      FcPatternDestroy(masterInfo[i].pattern);
+  }
+  __glcArrayDestroy(masterTable);
+  __glcArrayDestroy(updatedHashTable);
+  FcFontSetDestroy(fontSet);
+  if (nextFace)
+    __glcFree(nextFace);
+  if (masterIndex)
+    __glcFree(masterIndex);
+  return GL_FALSE;
+}
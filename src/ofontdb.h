@@ -0,0 +1,58 @@
+/* QuesoGLC
+ * A free implementation of the OpenGL Character Renderer (GLC)
+ * Copyright (c) 2002, 2004-2009, Bertrand Coconnier
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+/* $Id$ */
+
+/** \file
+ * header of the object __GLCfontDatabase which stores the fonts and the masters
+ * that can be shared by several contexts.
+ */
+
+#ifndef __glc_ofontdb_h
+#define __glc_ofontdb_h
+
+#include <fontconfig/fontconfig.h>
+
+#include "oarray.h"
+
+typedef struct __GLCfontDatabaseRec __GLCfontDatabase;
+
+/* The font database is shared by all the contexts which use the same catalogs.
+ * A database that is referenced by more than one context must not be modified:
+ * a context that changes its catalogs gets its own copy of the database first
+ * (see __glcFontDatabaseUnshare()).
+ */
+struct __GLCfontDatabaseRec {
+  GLint refCount;		/* Number of contexts which use the database */
+  FcConfig* config;
+  __GLCarray* catalogList;	/* GLC_CATALOG_LIST */
+  __GLCarray* masterHashTable;
+  __GLCarray* masterTable;	/* Masters indexed by their ID */
+  FcFontSet* masterFontSet;	/* Faces of the masters */
+  GLint* masterNextFace;	/* Next face of the same master in the set */
+  GLint* masterIndex;		/* Index of masterHashTable by hash value */
+  GLint masterIndexBits;	/* The index has 2^masterIndexBits slots */
+};
+
+__GLCfontDatabase* __glcFontDatabaseGetDefault(void);
+__GLCfontDatabase* __glcFontDatabaseUnshare(__GLCfontDatabase* This);
+void __glcFontDatabaseRelease(__GLCfontDatabase* This);
+GLboolean __glcFontDatabaseUpdate(__GLCfontDatabase* This);
+GLint __glcFontDatabaseGetMasterID(const __GLCfontDatabase* This,
+				   const GLCchar32 inHashValue);
+#endif
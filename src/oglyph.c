@@ -28,6 +28,8 @@
 
 #include "internal.h"
 #include "texture.h"
+#include "otextobj.h"
+#include "outline.h"
 
 
 
@@ -63,6 +65,10 @@ __GLCglyph* __glcGlyphCreate(const GLCulong inIndex, const GLCulong inCode)
 void __glcGlyphDestroy(__GLCglyph* This, __GLCcontext* inContext)
 {
   __glcGlyphDestroyGLObjects(This, inContext);
+
+  if (This->outline)
+    __glcOutlineCacheRemove(inContext, This->outline);
+
   __glcFree(This);
 }
 
@@ -71,6 +77,9 @@ void __glcGlyphDestroy(__GLCglyph* This, __GLCcontext* inContext)
 /* Remove all GL objects related to the texture of the glyph */
 void __glcGlyphDestroyTexture(__GLCglyph* This, const __GLCcontext* inContext)
 {
+  /* The area of the glyph will be given to another glyph */
+  __glcTextObjectInvalidateGlyph(inContext, This);
+
   if (!inContext->isInGlobalCommand && !GLEW_ARB_vertex_buffer_object)
     glDeleteLists(This->glObject[1], 1);
   This->glObject[1] = 0;
@@ -95,8 +104,12 @@ void __glcGlyphDestroyGLObjects(__GLCglyph* This, __GLCcontext* inContext)
 	glDeleteBuffersARB(1, &This->glObject[0]);
 	if (This->contours)
 	  __glcFree(This->contours);
+	if (This->vertices)
+	  __glcFree(This->vertices);
 	This->nContour = 0;
 	This->contours = NULL;
+	This->nVertex = 0;
+	This->vertices = NULL;
       }
       else
 	glDeleteLists(This->glObject[0], 1);
@@ -107,8 +120,11 @@ void __glcGlyphDestroyGLObjects(__GLCglyph* This, __GLCcontext* inContext)
 	glDeleteBuffersARB(1, &This->glObject[2]);
 	if (This->geomBatches)
 	  __glcFree(This->geomBatches);
+	if (This->vertexIndices)
+	  __glcFree(This->vertexIndices);
 	This->nGeomBatch = 0;
 	This->geomBatches = NULL;
+	This->vertexIndices = NULL;
       }
       else
 	glDeleteLists(This->glObject[2], 1);
@@ -43,12 +43,18 @@ struct __GLCglyphRec {
   GLint* contours;
   GLint nGeomBatch;
   __GLCgeomBatch* geomBatches;
+  /* Copies of the VBOs glObject[0] and glObject[2] (see render.c) */
+  GLint nVertex;
+  GLfloat* vertices;
+  GLuint* vertexIndices;
   /* Measurement infos */
   GLfloat boundingBox[4];
   GLfloat advance[2];
   GLboolean advanceCached;
   GLboolean boundingBoxCached;
   GLboolean isSpacingChar;
+  /* Outline loaded by FreeType (see outline.h) */
+  __GLCoutline* outline;
 };
 
 __GLCglyph* __glcGlyphCreate(const GLCulong inIndex, const GLCulong inCode);
@@ -25,115 +25,128 @@
 #include "internal.h"
 #include <string.h>
 
-typedef GLboolean (*__glcPatternProcess)(FcFontSet* inFontSet,
-					 FcPattern* inPattern, int inFont,
-					 void* inData);
-struct __GLCdataRec {
-  const __GLCmaster* master;
-  GLint* index;
-};
-typedef struct __GLCdataRec __GLCdata;
-
-
-static int __glcScanFonts(const __GLCcontext* inContext, FcFontSet** outFontSet,
-			  FcPattern** outPattern,
-			  __glcPatternProcess inPatternProcess, void* inData)
+/* Return the description of the master 'inMaster' in the table of the
+ * masters of the context or NULL if the master is not in the table.
+ */
+static __GLCmasterInfo* __glcMasterGetTableEntry(const GLint inMaster,
+					       const __GLCcontext* inContext)
 {
-  int font = 0;
-  FcObjectSet* objectSet = NULL;
-  FcFontSet *fontSet = NULL;
-  FcPattern *pattern = FcPatternCreate();
+  const __GLCarray* masterTable = inContext->database->masterTable;
+  __GLCmasterInfo* masterInfo = NULL;
 
-  /* Use Fontconfig to get the default font files */
-  if (!pattern) {
+  if (!masterTable || (inMaster < 0)
+      || (inMaster >= GLC_ARRAY_LENGTH(masterTable)))
+    return NULL;
+
+  masterInfo = (__GLCmasterInfo*)GLC_ARRAY_DATA(masterTable) + inMaster;
+
+  return masterInfo->pattern ? masterInfo : NULL;
+}
+
+
+
+/* Return the description of the master 'This' in the table of the masters of
+ * the context. The faces of the master can be parsed from there.
+ */
+const __GLCmasterInfo* __glcMasterLookup(const __GLCmaster* This,
+					 const __GLCcontext* inContext)
+{
+  return __glcMasterGetTableEntry(__glcMasterGetID(This, inContext),
+				  inContext);
+}
+
+
+
+/* Return the union of the character sets of the faces of the master. It is
+ * computed the first time that it is requested, then it is stored in the
+ * table of the masters until the catalogs are modified. The caller must not
+ * destroy the returned character set (but it can keep a reference to it with
+ * FcCharSetCopy()).
+ * Since the table of the masters may be shared by several contexts, the
+ * character set is computed with the common area locked.
+ */
+FcCharSet* __glcMasterGetCharSet(const __GLCmaster* This,
+				 const __GLCcontext* inContext)
+{
+  const __GLCfontDatabase* database = inContext->database;
+  __GLCmasterInfo* masterInfo =
+    __glcMasterGetTableEntry(__glcMasterGetID(This, inContext), inContext);
+  FcCharSet* charSet = NULL;
+  GLint i = 0;
+
+  if (!masterInfo) {
     __glcRaiseError(GLC_RESOURCE_ERROR);
-    return -1;
+    return NULL;
   }
-  objectSet = FcObjectSetBuild(FC_FAMILY, FC_FOUNDRY, FC_OUTLINE, FC_SPACING,
-			       FC_STYLE, NULL);
-  if (!objectSet) {
-    __glcRaiseError(GLC_RESOURCE_ERROR);
-    FcPatternDestroy(pattern);
-    return -1;
+
+  __glcLock();
+
+  if (masterInfo->charSet) {
+    __glcUnlock();
+    return masterInfo->charSet;
   }
-  fontSet = FcFontList(inContext->config, pattern, objectSet);
-  FcObjectSetDestroy(objectSet);
-  FcPatternDestroy(pattern);
-  if (!fontSet) {
+
+  charSet = FcCharSetCreate();
+  if (!charSet) {
+    __glcUnlock();
     __glcRaiseError(GLC_RESOURCE_ERROR);
-    return -1;
+    return NULL;
   }
 
-  /* Parse the font set looking for a font with an outline and which hash value
-   * matches the hash value of the master we are looking for.
-   */
-  for (font = 0; font < fontSet->nfont; font++) {
-    FcBool outline = FcFalse;
-    FcChar8* family = NULL;
-    int fixed = 0;
-    FcChar8* foundry = NULL;
+  for (i = masterInfo->firstFace; i >= 0; i = database->masterNextFace[i]) {
+    FcCharSet* faceCharSet = NULL;
+    FcCharSet* newCharSet = NULL;
 #ifdef DEBUGMODE
-    FcResult result = FcResultMatch;
-
-    result = FcPatternGetBool(fontSet->fonts[font], FC_OUTLINE, 0, &outline);
-    assert(result != FcResultTypeMismatch);
-#else
-    FcPatternGetBool(fontSet->fonts[font], FC_OUTLINE, 0, &outline);
-#endif
-    if (!outline)
-      continue;
+    FcResult result = FcPatternGetCharSet(database->masterFontSet->fonts[i],
+					  FC_CHARSET, 0, &faceCharSet);
 
-#ifdef DEBUGMODE
-    result = FcPatternGetString(fontSet->fonts[font], FC_FAMILY, 0, &family);
-    assert(result != FcResultTypeMismatch);
-    result = FcPatternGetString(fontSet->fonts[font], FC_FOUNDRY, 0, &foundry);
-    assert(result != FcResultTypeMismatch);
-    result = FcPatternGetInteger(fontSet->fonts[font], FC_SPACING, 0, &fixed);
     assert(result != FcResultTypeMismatch);
 #else
-    FcPatternGetString(fontSet->fonts[font], FC_FAMILY, 0, &family);
-    FcPatternGetString(fontSet->fonts[font], FC_FOUNDRY, 0, &foundry);
-    FcPatternGetInteger(fontSet->fonts[font], FC_SPACING, 0, &fixed);
+    FcPatternGetCharSet(database->masterFontSet->fonts[i], FC_CHARSET, 0,
+			&faceCharSet);
 #endif
 
-    if (foundry)
-      pattern = FcPatternBuild(NULL, FC_FAMILY, FcTypeString, family,
-			       FC_FOUNDRY, FcTypeString, foundry, FC_SPACING,
-			       FcTypeInteger, fixed, NULL);
-    else
-      pattern = FcPatternBuild(NULL, FC_FAMILY, FcTypeString, family,
-			       FC_SPACING, FcTypeInteger, fixed, NULL);
+    if (!faceCharSet)
+      continue;
 
-    if (!pattern) {
+    newCharSet = FcCharSetUnion(charSet, faceCharSet);
+    FcCharSetDestroy(charSet);
+    if (!newCharSet) {
+      __glcUnlock();
       __glcRaiseError(GLC_RESOURCE_ERROR);
-      FcFontSetDestroy(fontSet);
-      return -1;
-    }
-
-    if (inPatternProcess(fontSet, pattern, font, inData)) {
-      *outPattern = pattern;
-      *outFontSet = fontSet;
-      return font;
+      return NULL;
     }
-
-    FcPatternDestroy(pattern);
+    charSet = newCharSet;
   }
 
-  *outPattern = NULL;
-  *outFontSet = fontSet;
-  return font;
+  masterInfo->charSet = charSet;
+  __glcUnlock();
+  return charSet;
 }
 
 
 
-static GLboolean __glcCheckHashValue(FcFontSet* GLC_UNUSED_ARG(inFontSet),
-				     FcPattern* inPattern,
-				     int GLC_UNUSED_ARG(inFont), void* inData)
+/* Check if a face that precedes the face 'inFont' in the chain of faces which
+ * begins at 'inFirst' has the same style name. Several files may provide the
+ * same face of a master, but the face must be counted only once.
+ */
+GLboolean __glcMasterIsDuplicateFace(const FcFontSet* inFontSet,
+				     const GLint* inNextFace,
+				     const GLint inFirst, const GLint inFont)
 {
-  GLCchar32 hashValue = *((GLCchar32*)inData);
+  FcChar8* style = NULL;
+  GLint i = 0;
+
+  FcPatternGetString(inFontSet->fonts[inFont], FC_STYLE, 0, &style);
 
-  if (hashValue == FcPatternHash(inPattern))
-    return GL_TRUE;
+  for (i = inFirst; (i >= 0) && (i != inFont); i = inNextFace[i]) {
+    FcChar8* prevStyle = NULL;
+
+    FcPatternGetString(inFontSet->fonts[i], FC_STYLE, 0, &prevStyle);
+    if (style && prevStyle
+	&& !strcmp((const char*)style, (const char*)prevStyle))
+      return GL_TRUE;
+  }
 
   return GL_FALSE;
 }
@@ -147,31 +160,31 @@ __GLCmaster* __glcMasterCreate(const GLint inMaster,
 			       const __GLCcontext* inContext)
 {
   __GLCmaster* This = NULL;
-  GLCchar32 hashValue =
-	((GLCchar32*)GLC_ARRAY_DATA(inContext->masterHashTable))[inMaster];
-  FcFontSet *fontSet = NULL;
-  FcPattern *pattern = NULL;
-  int font = __glcScanFonts(inContext, &fontSet, &pattern, __glcCheckHashValue,
-			    &hashValue);
-
-  assert(font < fontSet->nfont);
+  const __GLCmasterInfo* masterInfo = __glcMasterGetTableEntry(inMaster,
+							       inContext);
 
-  FcFontSetDestroy(fontSet);
-  if (font < 0)
+  if (!masterInfo) {
+    __glcRaiseError(GLC_RESOURCE_ERROR);
     return NULL;
+  }
 
   This = (__GLCmaster*)__glcMalloc(sizeof(__GLCmaster));
   if (!This) {
     __glcRaiseError(GLC_RESOURCE_ERROR);
-    FcPatternDestroy(pattern);
     return NULL;
   }
   memset(This, 0, sizeof(__GLCmaster));
 
-  /* Duplicate the pattern of the found font (otherwise it will be deleted with
-   * the font set).
+  /* Duplicate the pattern of the master (otherwise it will be deleted with
+   * the table of the masters).
    */
-  This->pattern = pattern;
+  This->pattern = FcPatternDuplicate(masterInfo->pattern);
+  if (!This->pattern) {
+    __glcRaiseError(GLC_RESOURCE_ERROR);
+    __glcFree(This);
+    return NULL;
+  }
+
   return This;
 }
 
@@ -187,66 +200,52 @@ void __glcMasterDestroy(__GLCmaster* This)
 
 
 
-static GLboolean __glcFindMasterIndex(FcFontSet* GLC_UNUSED_ARG(inFontSet),
-				      FcPattern* inPattern,
-				      int GLC_UNUSED_ARG(inFont), void* inData)
-{
-  const __GLCmaster* This = ((__GLCdata*)inData)->master;
-  GLint *idx = ((__GLCdata*)inData)->index; 
-  FcBool equal = FcPatternEqual(inPattern, This->pattern);
-
-  if (equal) {
-    if (*idx)
-      (*idx)--;
-    else
-      return GL_TRUE;
-  }
-
-  return GL_FALSE;
-}
-
-
-
 /* Get the style name of the face identified by inIndex  */
 GLCchar8* __glcMasterGetFaceName(const __GLCmaster* This,
 				 const __GLCcontext* inContext,
 				 const GLint inIndex)
 {
-  FcFontSet *fontSet = NULL;
-  FcPattern *pattern = NULL;
+  const __GLCmasterInfo* masterInfo = __glcMasterLookup(This, inContext);
+  const __GLCfontDatabase* database = inContext->database;
   GLCchar8* string = NULL;
   GLCchar8* faceName;
-  GLint idx = inIndex;
-  __GLCdata data = {NULL, NULL};
-  int font = 0;
+  GLint font = 0;
+  GLint i = 0;
 #ifdef DEBUGMODE
   FcResult result = FcResultMatch;
 #endif
 
-  data.master = This;
-  data.index = &idx;
-
-  font = __glcScanFonts(inContext, &fontSet, &pattern, __glcFindMasterIndex,
-			&data);
-
-  FcPatternDestroy(pattern);
-
-  if (font < 0) {
-    FcFontSetDestroy(fontSet);
+  if (!masterInfo) {
+    __glcRaiseError(GLC_RESOURCE_ERROR);
     return NULL;
   }
 
-  if (font == fontSet->nfont) {
+  if (inIndex >= masterInfo->faceCount) {
     __glcRaiseError(GLC_PARAMETER_ERROR);
-    FcFontSetDestroy(fontSet);
     return NULL;
   }
 
+  /* Follow the chain of the faces of the master up to the requested one */
+  for (font = masterInfo->firstFace; font >= 0;
+       font = database->masterNextFace[font]) {
+    if (__glcMasterIsDuplicateFace(database->masterFontSet,
+				   database->masterNextFace,
+				   masterInfo->firstFace, font))
+      continue;
+
+    if (i++ == inIndex)
+      break;
+  }
+
+  assert(font >= 0);
+
 #ifdef DEBUGMODE
-  result = FcPatternGetString(fontSet->fonts[font], FC_STYLE, 0, &string);
+  result = FcPatternGetString(database->masterFontSet->fonts[font], FC_STYLE,
+			      0, &string);
   assert(result != FcResultTypeMismatch);
 #else
-  FcPatternGetString(fontSet->fonts[font], FC_STYLE, 0, &string);
+  FcPatternGetString(database->masterFontSet->fonts[font], FC_STYLE, 0,
+		     &string);
 #endif
 
 #ifdef __WIN32__
@@ -254,7 +253,6 @@ GLCchar8* __glcMasterGetFaceName(const __GLCmaster* This,
 #else
   faceName = (GLCchar8*)strdup((const char*)string);
 #endif
-  FcFontSetDestroy(fontSet);
   if (!faceName) {
     __glcRaiseError(GLC_RESOURCE_ERROR);
     return NULL;
@@ -282,43 +280,13 @@ GLboolean __glcMasterIsFixedPitch(const __GLCmaster* This)
 
 
 
-static GLboolean __glcCountFaces(FcFontSet* GLC_UNUSED_ARG(inFontSet),
-				 FcPattern* inPattern,
-				 int GLC_UNUSED_ARG(inFont), void* inData)
-{
-  const __GLCmaster* This = ((__GLCdata*)inData)->master;
-  GLint *count = ((__GLCdata*)inData)->index; 
-  FcBool equal = FcPatternEqual(inPattern, This->pattern);
-
-  if (equal)
-    (*count)++;
-
-  return GL_FALSE;
-}
-
-
-
 /* Get the face count of the master */
 GLint __glcMasterFaceCount(const __GLCmaster* This,
 			   const __GLCcontext* inContext)
 {
-  FcFontSet *fontSet = NULL;
-  GLint count = 0;
-  FcPattern* pattern = NULL;
-  __GLCdata data = {NULL, NULL};
-  int font = 0;
-
-  data.master = This;
-  data.index = &count;
-
-  font = __glcScanFonts(inContext, &fontSet, &pattern, __glcCountFaces, &data);
-
-  FcFontSetDestroy(fontSet);
+  const __GLCmasterInfo* masterInfo = __glcMasterLookup(This, inContext);
 
-  if (font < 0)
-    return 0;
-
-  return count;
+  return masterInfo ? masterInfo->faceCount : 0;
 }
 
 
@@ -401,67 +369,67 @@ const GLCchar8* __glcMasterGetInfo(const __GLCmaster* This,
 
 
 
-static GLboolean __glcFindFamily(FcFontSet* inFontSet,
-				 FcPattern* GLC_UNUSED_ARG(inPattern),
-				 int inFont, void* inData)
+/* Create a master on the basis of the family name. If several masters have
+ * the same family name, the master of the first face listed by Fontconfig is
+ * returned.
+ */
+__GLCmaster* __glcMasterFromFamily(const __GLCcontext* inContext,
+				   const GLCchar8* inFamily)
 {
-  FcChar8* family = NULL;
-#ifdef DEBUGMODE
-  FcResult result = FcPatternGetString(inFontSet->fonts[inFont], FC_FAMILY, 0,
-				       &family);
-  assert(result != FcResultTypeMismatch);
-#else
-  FcPatternGetString(inFontSet->fonts[inFont], FC_FAMILY, 0, &family);
-#endif
+  const __GLCarray* masterTable = inContext->database->masterTable;
+  const __GLCmasterInfo* masterInfo = NULL;
+  GLint found = -1;
+  GLint i = 0;
+  __GLCmaster* This = NULL;
 
-  if (strcmp((const char*)family, (const char*)inData))
-    return GL_FALSE;
+  if (masterTable) {
+    masterInfo = (const __GLCmasterInfo*)GLC_ARRAY_DATA(masterTable);
 
-  return GL_TRUE;
-}
+    for (i = 0; i < GLC_ARRAY_LENGTH(masterTable); i++) {
+      FcChar8* family = NULL;
+#ifdef DEBUGMODE
+      FcResult result = FcResultMatch;
+#endif
 
+      if (!masterInfo[i].pattern)
+	continue;
 
+      if ((found >= 0)
+	  && (masterInfo[i].firstFace > masterInfo[found].firstFace))
+	continue;
 
-/* Create a master on the basis of the family name */
-__GLCmaster* __glcMasterFromFamily(const __GLCcontext* inContext,
-				   const GLCchar8* inFamily)
-{
-  FcFontSet *fontSet = NULL;
-  FcPattern* pattern = NULL;
-  __GLCmaster* This = NULL;
-  int font = __glcScanFonts(inContext, &fontSet, &pattern, __glcFindFamily,
-			    (void*)inFamily);
+#ifdef DEBUGMODE
+      result = FcPatternGetString(masterInfo[i].pattern, FC_FAMILY, 0,
+				  &family);
+      assert(result != FcResultTypeMismatch);
+#else
+      FcPatternGetString(masterInfo[i].pattern, FC_FAMILY, 0, &family);
+#endif
 
-  if (font < 0) {
-    if (pattern)
-      FcPatternDestroy(pattern);
-    FcFontSetDestroy(fontSet);
-    return NULL;
+      if (!strcmp((const char*)family, (const char*)inFamily))
+	found = i;
+    }
   }
 
-  assert(fontSet);
-
-  if (font == fontSet->nfont) {
+  if (found < 0) {
     __glcRaiseError(GLC_PARAMETER_ERROR);
-    if (pattern)
-      FcPatternDestroy(pattern);
-    FcFontSetDestroy(fontSet);
     return NULL;
   }
 
-  assert(pattern);
-
   This = (__GLCmaster*)__glcMalloc(sizeof(__GLCmaster));
   if (!This) {
     __glcRaiseError(GLC_RESOURCE_ERROR);
-    FcFontSetDestroy(fontSet);
-    FcPatternDestroy(pattern);
     return NULL;
   }
   memset(This, 0, sizeof(__GLCmaster));
 
-  This->pattern = pattern;
-  FcFontSetDestroy(fontSet);
+  This->pattern = FcPatternDuplicate(masterInfo[found].pattern);
+  if (!This->pattern) {
+    __glcRaiseError(GLC_RESOURCE_ERROR);
+    __glcFree(This);
+    return NULL;
+  }
+
   return This;
 }
 
@@ -470,7 +438,7 @@ __GLCmaster* __glcMasterFromFamily(const __GLCcontext* inContext,
 /* Create a master which contains at least a font which math the character
  * identified by inCode.
  */
-__GLCmaster* __glcMasterMatchCode(const __GLCcontext* inContext,
+__GLCmaster* __glcMasterMatchCode(__GLCcontext* inContext,
 				  const GLint inCode)
 {
   __GLCmaster* This = NULL;
@@ -484,6 +452,7 @@ __GLCmaster* __glcMasterMatchCode(const __GLCcontext* inContext,
   int fixed = 0;
   FcChar8* foundry = NULL;
   FcCharSet* charSet = FcCharSetCreate();
+  FcConfig* config = inContext->database->config;
 
   if (!charSet)
     return NULL;
@@ -500,13 +469,13 @@ __GLCmaster* __glcMasterMatchCode(const __GLCcontext* inContext,
     return NULL;
   }
 
-  if (!FcConfigSubstitute(inContext->config, pattern, FcMatchPattern)) {
+  if (!FcConfigSubstitute(config, pattern, FcMatchPattern)) {
     __glcRaiseError(GLC_RESOURCE_ERROR);
     FcPatternDestroy(pattern);
     return NULL;
   }
   FcDefaultSubstitute(pattern);
-  fontSet = FcFontSort(inContext->config, pattern, FcFalse, NULL, &result);
+  fontSet = FcFontSort(config, pattern, FcFalse, NULL, &result);
   FcPatternDestroy(pattern);
   if ((!fontSet) || (result == FcResultTypeMismatch)) {
     __glcRaiseError(GLC_RESOURCE_ERROR);
@@ -531,6 +500,8 @@ __GLCmaster* __glcMasterMatchCode(const __GLCcontext* inContext,
   }
 
   if (f == fontSet->nfont) {
+    /* No master maps the code : remember it until the catalogs change */
+    __glcContextSetUnmappedCode(inContext, inCode);
     FcFontSetDestroy(fontSet);
     return NULL;
   }
@@ -545,7 +516,7 @@ __GLCmaster* __glcMasterMatchCode(const __GLCcontext* inContext,
     FcFontSetDestroy(fontSet);
     return NULL;
   }
-  fontSet2 = FcFontList(inContext->config, fontSet->fonts[f], objectSet);
+  fontSet2 = FcFontList(config, fontSet->fonts[f], objectSet);
   FcObjectSetDestroy(objectSet);
   if (!fontSet2) {
     __glcRaiseError(GLC_RESOURCE_ERROR);
@@ -604,15 +575,9 @@ __GLCmaster* __glcMasterMatchCode(const __GLCcontext* inContext,
 
 GLint __glcMasterGetID(const __GLCmaster* This, const __GLCcontext* inContext)
 {
-  GLCchar32 hashValue = GLC_MASTER_HASH_VALUE(This);
-  GLint i = 0;
-  GLCchar32* hashTable = (GLCchar32*)GLC_ARRAY_DATA(inContext->masterHashTable);
+  GLint id = __glcContextGetMasterID(inContext, GLC_MASTER_HASH_VALUE(This));
 
-  for (i = 0; i < GLC_ARRAY_LENGTH(inContext->masterHashTable); i++) {
-    if (hashValue == hashTable[i])
-      break;
-  }
-  assert(i < GLC_ARRAY_LENGTH(inContext->masterHashTable));
+  assert(id >= 0);
 
-  return i;
+  return id;
 }
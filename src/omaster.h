@@ -31,10 +31,24 @@
 
 #define GLC_MASTER_HASH_VALUE(master) FcPatternHash((master)->pattern)
 
+typedef struct __GLCmasterInfoRec __GLCmasterInfo;
+
 struct __GLCmasterRec {
   FcPattern* pattern;
 };
 
+/* Description of a master in the table of the masters of the context. The
+ * faces of a master are chained in the font set 'masterFontSet' of the context
+ * through the array 'masterNextFace'.
+ */
+struct __GLCmasterInfoRec {
+  FcPattern* pattern;		/* Family, foundry and spacing of the master */
+  GLint faceCount;		/* Number of faces with distinct style names */
+  GLint firstFace;		/* Index of the first face in masterFontSet */
+  GLint lastFace;		/* Index of the last face in masterFontSet */
+  FcCharSet* charSet;		/* Union of the character sets of the faces */
+};
+
 __GLCmaster* __glcMasterCreate(const GLint inMaster,
 			       const __GLCcontext* inContext);
 void __glcMasterDestroy(__GLCmaster* This);
@@ -49,7 +63,14 @@ const GLCchar8* __glcMasterGetInfo(const __GLCmaster* This,
 				   const GLCenum inAttrib);
 __GLCmaster* __glcMasterFromFamily(const __GLCcontext* inContext,
 				   const GLCchar8* inFamily);
-__GLCmaster* __glcMasterMatchCode(const __GLCcontext* inContext,
+__GLCmaster* __glcMasterMatchCode(__GLCcontext* inContext,
 				  const GLint inCode);
 GLint __glcMasterGetID(const __GLCmaster* This, const __GLCcontext* inContext);
+GLboolean __glcMasterIsDuplicateFace(const FcFontSet* inFontSet,
+				     const GLint* inNextFace,
+				     const GLint inFirst, const GLint inFont);
+const __GLCmasterInfo* __glcMasterLookup(const __GLCmaster* This,
+					 const __GLCcontext* inContext);
+FcCharSet* __glcMasterGetCharSet(const __GLCmaster* This,
+				 const __GLCcontext* inContext);
 #endif
@@ -0,0 +1,315 @@
+/* QuesoGLC
+ * A free implementation of the OpenGL Character Renderer (GLC)
+ * Copyright (c) 2002, 2004-2009, Bertrand Coconnier
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+/* $Id$ */
+
+/** \file
+ * defines the object __GLCmetricCache which stores the advance and the
+ * bounding box of the glyphes. The cache lives in the common area so that a
+ * glyph which is measured by a context does not need to be loaded again by
+ * FreeType when another context measures it.
+ */
+
+#include "internal.h"
+
+typedef struct __GLCmetricFaceRec __GLCmetricFace;
+
+struct __GLCmetricFaceRec {
+  GLCchar8* fileName;
+  GLint index;
+};
+
+
+
+/* Lock the buckets of the hash table which share the lock of 'inBucket' */
+static void __glcMetricCacheLock(__GLCmetricCache* This, const GLuint inBucket)
+{
+#ifdef __WIN32__
+  EnterCriticalSection(&This->locks[inBucket & (GLC_METRIC_LOCK_COUNT - 1)]);
+#else
+  pthread_mutex_lock(&This->locks[inBucket & (GLC_METRIC_LOCK_COUNT - 1)]);
+#endif
+}
+
+
+
+/* Unlock the buckets that have been locked by __glcMetricCacheLock() */
+static void __glcMetricCacheUnlock(__GLCmetricCache* This,
+				   const GLuint inBucket)
+{
+#ifdef __WIN32__
+  LeaveCriticalSection(&This->locks[inBucket & (GLC_METRIC_LOCK_COUNT - 1)]);
+#else
+  pthread_mutex_unlock(&This->locks[inBucket & (GLC_METRIC_LOCK_COUNT - 1)]);
+#endif
+}
+
+
+
+/* Initialize the cache : this function is called once when the library is
+ * loaded.
+ */
+GLboolean __glcMetricCacheInit(__GLCmetricCache* This)
+{
+  int i = 0;
+
+  memset(This->hash, 0, GLC_METRIC_HASH_SIZE * sizeof(__GLCmetric*));
+  This->faceFiles = NULL;
+
+  for (i = 0; i < GLC_METRIC_LOCK_COUNT; i++) {
+#ifdef __WIN32__
+    InitializeCriticalSection(&This->locks[i]);
+#else
+    if (pthread_mutex_init(&This->locks[i], NULL)) {
+      while (i--)
+	pthread_mutex_destroy(&This->locks[i]);
+      return GL_FALSE;
+    }
+#endif
+  }
+
+  return GL_TRUE;
+}
+
+
+
+/* Release the memory used by the cache : this function is called once when
+ * the library is unloaded.
+ */
+void __glcMetricCacheFinalize(__GLCmetricCache* This)
+{
+  int i = 0;
+
+  for (i = 0; i < GLC_METRIC_HASH_SIZE; i++) {
+    __GLCmetric* metric = This->hash[i];
+
+    while (metric) {
+      __GLCmetric* next = metric->next;
+
+      __glcFree(metric);
+      metric = next;
+    }
+    This->hash[i] = NULL;
+  }
+
+  if (This->faceFiles) {
+    __GLCmetricFace* faces = (__GLCmetricFace*)GLC_ARRAY_DATA(This->faceFiles);
+
+    for (i = 0; i < GLC_ARRAY_LENGTH(This->faceFiles); i++)
+      free(faces[i].fileName);
+    __glcArrayDestroy(This->faceFiles);
+    This->faceFiles = NULL;
+  }
+
+  for (i = 0; i < GLC_METRIC_LOCK_COUNT; i++) {
+#ifdef __WIN32__
+    DeleteCriticalSection(&This->locks[i]);
+#else
+    pthread_mutex_destroy(&This->locks[i]);
+#endif
+  }
+}
+
+
+
+/* Return the ID of the face stored at the index 'inIndex' of the file
+ * 'inFileName'. The face descriptors of different contexts which use the same
+ * face get the same ID, so that the metrics are looked up with an integer
+ * rather than a file name. The IDs begin at 1 : 0 is returned if the face can
+ * not be registered.
+ */
+GLint __glcMetricCacheGetFaceID(__GLCmetricCache* This,
+				const GLCchar8* inFileName, const GLint inIndex)
+{
+  __GLCmetricFace* faces = NULL;
+  __GLCmetricFace face = {NULL, 0};
+  GLint id = 0;
+  int i = 0;
+
+  __glcLock();
+
+  if (!This->faceFiles) {
+    This->faceFiles = __glcArrayCreate(sizeof(__GLCmetricFace));
+    if (!This->faceFiles) {
+      __glcUnlock();
+      __glcRaiseError(GLC_RESOURCE_ERROR);
+      return 0;
+    }
+  }
+
+  faces = (__GLCmetricFace*)GLC_ARRAY_DATA(This->faceFiles);
+  for (i = 0; i < GLC_ARRAY_LENGTH(This->faceFiles); i++) {
+    if ((faces[i].index == inIndex)
+	&& !strcmp((const char*)faces[i].fileName, (const char*)inFileName)) {
+      __glcUnlock();
+      return i + 1;
+    }
+  }
+
+#ifdef __WIN32__
+  face.fileName = (GLCchar8*)_strdup((const char*)inFileName);
+#else
+  face.fileName = (GLCchar8*)strdup((const char*)inFileName);
+#endif
+  face.index = inIndex;
+  if (!face.fileName) {
+    __glcUnlock();
+    __glcRaiseError(GLC_RESOURCE_ERROR);
+    return 0;
+  }
+
+  if (!__glcArrayAppend(This->faceFiles, &face)) {
+    free(face.fileName);
+    __glcUnlock();
+    __glcRaiseError(GLC_RESOURCE_ERROR);
+    return 0;
+  }
+
+  id = GLC_ARRAY_LENGTH(This->faceFiles);
+  __glcUnlock();
+  return id;
+}
+
+
+
+/* Compute the bucket of the metrics which key is stored in 'inKey' */
+static GLuint __glcMetricCacheHash(const __GLCmetric* inKey)
+{
+  GLuint scale[2] = {0, 0};
+  GLuint hash = (GLuint)inKey->faceID * 2654435761u;
+
+  memcpy(scale, inKey->scale, 2 * sizeof(GLuint));
+  hash ^= (GLuint)inKey->glyphIndex + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+  hash ^= scale[0] + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+  hash ^= scale[1] + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+
+  return hash & (GLC_METRIC_HASH_SIZE - 1);
+}
+
+
+
+/* Check if the metrics 'inMetric' have the key 'inKey' */
+static GLboolean __glcMetricCacheMatch(const __GLCmetric* inMetric,
+				       const __GLCmetric* inKey)
+{
+  return (inMetric->faceID == inKey->faceID)
+    && (inMetric->glyphIndex == inKey->glyphIndex)
+    && (inMetric->scale[0] == inKey->scale[0])
+    && (inMetric->scale[1] == inKey->scale[1])
+    && (inMetric->resolution == inKey->resolution)
+    && (inMetric->hinting == inKey->hinting);
+}
+
+
+
+/* Look for the metrics which key is stored in 'inOutMetric'. If they are
+ * found, the advance and the bounding box are copied to 'inOutMetric' and
+ * GL_TRUE is returned. The metrics that are found are moved at the head of
+ * their bucket so that the least recently used metrics are discarded first.
+ */
+GLboolean __glcMetricCacheLookup(__GLCmetricCache* This,
+				 __GLCmetric* inOutMetric)
+{
+  const GLuint bucket = __glcMetricCacheHash(inOutMetric);
+  __GLCmetric* previous = NULL;
+  __GLCmetric* metric = NULL;
+
+  if (!inOutMetric->faceID)
+    return GL_FALSE;
+
+  __glcMetricCacheLock(This, bucket);
+
+  for (metric = This->hash[bucket]; metric; metric = metric->next) {
+    if (__glcMetricCacheMatch(metric, inOutMetric))
+      break;
+    previous = metric;
+  }
+
+  if (!metric) {
+    __glcMetricCacheUnlock(This, bucket);
+    return GL_FALSE;
+  }
+
+  if (previous) {
+    previous->next = metric->next;
+    metric->next = This->hash[bucket];
+    This->hash[bucket] = metric;
+  }
+
+  memcpy(inOutMetric->advance, metric->advance, 2 * sizeof(GLfloat));
+  memcpy(inOutMetric->boundingBox, metric->boundingBox, 4 * sizeof(GLfloat));
+
+  __glcMetricCacheUnlock(This, bucket);
+  return GL_TRUE;
+}
+
+
+
+/* Store a copy of the metrics 'inMetric' in the cache. A bucket contains at
+ * most GLC_METRIC_BUCKET_DEPTH metrics : the least recently used metrics of
+ * the bucket are discarded when it overflows. If the memory can not be
+ * allocated, the metrics are simply not stored.
+ */
+void __glcMetricCacheInsert(__GLCmetricCache* This,
+			    const __GLCmetric* inMetric)
+{
+  const GLuint bucket = __glcMetricCacheHash(inMetric);
+  __GLCmetric* metric = NULL;
+  __GLCmetric* last = NULL;
+  int depth = 0;
+
+  if (!inMetric->faceID)
+    return;
+
+  __glcMetricCacheLock(This, bucket);
+
+  /* Another context may have stored the same metrics in the meantime */
+  for (metric = This->hash[bucket]; metric; metric = metric->next) {
+    if (__glcMetricCacheMatch(metric, inMetric)) {
+      __glcMetricCacheUnlock(This, bucket);
+      return;
+    }
+  }
+
+  metric = (__GLCmetric*)__glcMalloc(sizeof(__GLCmetric));
+  if (!metric) {
+    __glcMetricCacheUnlock(This, bucket);
+    return;
+  }
+
+  memcpy(metric, inMetric, sizeof(__GLCmetric));
+  metric->next = This->hash[bucket];
+  This->hash[bucket] = metric;
+
+  /* Discard the metrics beyond the maximal depth of the bucket */
+  for (last = metric; last->next; last = last->next) {
+    if (++depth == GLC_METRIC_BUCKET_DEPTH) {
+      __GLCmetric* next = last->next;
+
+      last->next = NULL;
+      while (next) {
+	metric = next->next;
+	__glcFree(next);
+	next = metric;
+      }
+      break;
+    }
+  }
+
+  __glcMetricCacheUnlock(This, bucket);
+}
@@ -0,0 +1,81 @@
+/* QuesoGLC
+ * A free implementation of the OpenGL Character Renderer (GLC)
+ * Copyright (c) 2002, 2004-2009, Bertrand Coconnier
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+/* $Id$ */
+
+/** \file
+ * header of the object __GLCmetricCache which stores the metrics of the
+ * glyphes for all the contexts of the process.
+ */
+
+#ifndef __glc_ometric_h
+#define __glc_ometric_h
+
+#ifndef __WIN32__
+#include <pthread.h>
+#else
+#include <windows.h>
+#endif
+
+#include "oarray.h"
+
+#define GLC_METRIC_HASH_SIZE	4096	/* Must be a power of 2 */
+#define GLC_METRIC_LOCK_COUNT	16	/* Must be a power of 2 */
+#define GLC_METRIC_BUCKET_DEPTH	8	/* Max number of metrics per bucket */
+
+typedef struct __GLCmetricRec __GLCmetric;
+typedef struct __GLCmetricCacheRec __GLCmetricCache;
+
+/* The metrics of a glyph depend on the face file, on the glyph index, on the
+ * scale and on the way the glyph is loaded by FreeType (hinting profile and
+ * resolution). Those members are the key of the cache.
+ */
+struct __GLCmetricRec {
+  __GLCmetric* next;		/* Next metrics of the same bucket */
+  GLint faceID;			/* See __glcMetricCacheGetFaceID() */
+  GLCulong glyphIndex;
+  GLfloat scale[2];
+  GLfloat resolution;
+  GLint hinting;		/* Hinting profile */
+  GLfloat advance[2];
+  GLfloat boundingBox[4];
+};
+
+/* Each lock protects the buckets which index modulo GLC_METRIC_LOCK_COUNT is
+ * the index of the lock, so that the contexts of different threads seldom
+ * wait for each other.
+ */
+struct __GLCmetricCacheRec {
+  __GLCmetric* hash[GLC_METRIC_HASH_SIZE];
+  __GLCarray* faceFiles;	/* Files and indices of the faces */
+#ifndef __WIN32__
+  pthread_mutex_t locks[GLC_METRIC_LOCK_COUNT];
+#else
+  CRITICAL_SECTION locks[GLC_METRIC_LOCK_COUNT];
+#endif
+};
+
+GLboolean __glcMetricCacheInit(__GLCmetricCache* This);
+void __glcMetricCacheFinalize(__GLCmetricCache* This);
+GLint __glcMetricCacheGetFaceID(__GLCmetricCache* This,
+				const GLCchar8* inFileName, const GLint inIndex);
+GLboolean __glcMetricCacheLookup(__GLCmetricCache* This,
+				 __GLCmetric* inOutMetric);
+void __glcMetricCacheInsert(__GLCmetricCache* This,
+			    const __GLCmetric* inMetric);
+#endif
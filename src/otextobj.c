@@ -0,0 +1,233 @@
+/* QuesoGLC
+ * A free implementation of the OpenGL Character Renderer (GLC)
+ * Copyright (c) 2002, 2004-2009, Bertrand Coconnier
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+/* $Id$ */
+
+/* Defines the methods of an object that is intended to store the layout of a
+ * string */
+
+/** \file
+ * defines the object __GLCtextObject which stores the layout of a string that
+ * has been compiled for a given rendering style : the vertices of the whole
+ * string are stored in buffer objects so that the string can be rendered
+ * with a single draw call.
+ */
+
+#include "internal.h"
+#include "texture.h"
+#include "otextobj.h"
+
+
+
+/* Constructor of the object : it allocates memory and initializes the member
+ * of the new object.
+ */
+__GLCtextObject* __glcTextObjectCreate(void)
+{
+  __GLCtextObject* This = NULL;
+
+  This = (__GLCtextObject*)__glcMalloc(sizeof(__GLCtextObject));
+  if (!This) {
+    __glcRaiseError(GLC_RESOURCE_ERROR);
+    return NULL;
+  }
+  memset(This, 0, sizeof(__GLCtextObject));
+
+  This->batches = __glcArrayCreate(sizeof(__GLCatlasBatch));
+  if (!This->batches) {
+    __glcFree(This);
+    return NULL;
+  }
+
+  This->glyphs = __glcArrayCreate(sizeof(__GLCglyph*));
+  if (!This->glyphs) {
+    __glcArrayDestroy(This->batches);
+    __glcFree(This);
+    return NULL;
+  }
+
+  /* An empty text object renders nothing */
+  This->isValid = GL_TRUE;
+  This->renderStyle = GLC_BITMAP;
+
+  return This;
+}
+
+
+
+/* Destructor of the object */
+void __glcTextObjectDestroy(__GLCtextObject* This,
+			    const __GLCcontext* inContext)
+{
+  __glcTextObjectDestroyGLObjects(This, inContext);
+
+  if (This->string)
+    __glcFree(This->string);
+
+  __glcArrayDestroy(This->batches);
+  __glcArrayDestroy(This->glyphs);
+  __glcFree(This);
+}
+
+
+
+/* This function destroys the buffer objects of the text object. The text
+ * object is then invalidated so that it is compiled again the next time it
+ * is rendered.
+ */
+void __glcTextObjectDestroyGLObjects(__GLCtextObject* This,
+				     const __GLCcontext* inContext)
+{
+  if (!inContext->isInGlobalCommand && GLEW_ARB_vertex_buffer_object) {
+    if (This->bufferObject[0])
+      glDeleteBuffersARB(1, &This->bufferObject[0]);
+    if (This->bufferObject[1])
+      glDeleteBuffersARB(1, &This->bufferObject[1]);
+  }
+
+  This->bufferObject[0] = 0;
+  This->bufferObject[1] = 0;
+  This->isValid = GL_FALSE;
+  This->isCompiled = GL_FALSE;
+}
+
+
+
+/* This function stores a copy of the string 'inString' in the text object.
+ * The string must be sorted in visual order and stored using UCS4 format.
+ * The text object needs to be compiled afterwards.
+ */
+GLboolean __glcTextObjectSetString(__GLCtextObject* This,
+				   const GLCchar32* inString,
+				   const GLint inLength,
+				   const GLboolean inIsRightToLeft)
+{
+  GLCchar32* string = NULL;
+
+  if (inLength) {
+    string = (GLCchar32*)__glcMalloc(inLength * sizeof(GLCchar32));
+    if (!string) {
+      __glcRaiseError(GLC_RESOURCE_ERROR);
+      return GL_FALSE;
+    }
+    memcpy(string, inString, inLength * sizeof(GLCchar32));
+  }
+
+  if (This->string)
+    __glcFree(This->string);
+
+  This->string = string;
+  This->length = inLength;
+  This->isRightToLeft = inIsRightToLeft;
+  This->isValid = GL_FALSE;
+
+  return GL_TRUE;
+}
+
+
+
+/* This function is called each time that the glyph 'inGlyph' looses its area
+ * in the texture atlas : the text objects which use the glyph are invalidated
+ * since the area is about to be used by another glyph.
+ * Only the address of the glyph is used, since the glyph may be partially
+ * destroyed.
+ */
+void __glcTextObjectInvalidateGlyph(const __GLCcontext* inContext,
+				    const __GLCglyph* inGlyph)
+{
+  __GLCtextObject** textObjects = NULL;
+  int i = 0;
+
+  if (!inContext->textObjects)
+    return;
+
+  textObjects = (__GLCtextObject**)GLC_ARRAY_DATA(inContext->textObjects);
+
+  for (i = 0; i < GLC_ARRAY_LENGTH(inContext->textObjects); i++) {
+    __GLCtextObject* textObject = textObjects[i];
+    __GLCglyph** glyphs = NULL;
+    int j = 0;
+
+    if (!textObject || !textObject->isValid)
+      continue;
+
+    glyphs = (__GLCglyph**)GLC_ARRAY_DATA(textObject->glyphs);
+    for (j = 0; j < GLC_ARRAY_LENGTH(textObject->glyphs); j++) {
+      if (glyphs[j] == inGlyph) {
+	textObject->isValid = GL_FALSE;
+	GLC_ARRAY_LENGTH(textObject->glyphs) = 0;
+	break;
+      }
+    }
+  }
+}
+
+
+
+/* This function is called each time that the layout of the text objects may
+ * change, that is when GLC_CURRENT_FONT_LIST, the character map of a font or
+ * GLC_KERNING_QSO are modified : every text object is invalidated so that it
+ * is compiled again with the new fonts before being rendered.
+ */
+void __glcTextObjectInvalidateLayouts(const __GLCcontext* inContext)
+{
+  __GLCtextObject** textObjects = NULL;
+  int i = 0;
+
+  if (!inContext->textObjects)
+    return;
+
+  textObjects = (__GLCtextObject**)GLC_ARRAY_DATA(inContext->textObjects);
+
+  for (i = 0; i < GLC_ARRAY_LENGTH(inContext->textObjects); i++) {
+    __GLCtextObject* textObject = textObjects[i];
+
+    if (!textObject || !textObject->length)
+      continue;
+
+    textObject->isValid = GL_FALSE;
+    GLC_ARRAY_LENGTH(textObject->glyphs) = 0;
+  }
+}
+
+
+
+/* Returns the number of buffer objects that have been built for a text
+ * object.
+ */
+int __glcTextObjectGetBufferObjectCount(const __GLCtextObject* This)
+{
+  return (This->bufferObject[0] ? 1 : 0) + (This->bufferObject[1] ? 1 : 0);
+}
+
+
+
+/* Returns the ID of the inCount-th buffer object that has been built for a
+ * text object.
+ */
+GLuint __glcTextObjectGetBufferObject(const __GLCtextObject* This,
+				      const int inCount)
+{
+  assert(inCount >= 0);
+  assert(inCount < __glcTextObjectGetBufferObjectCount(This));
+
+  if (!inCount && This->bufferObject[0])
+    return This->bufferObject[0];
+
+  return This->bufferObject[1];
+}
@@ -0,0 +1,62 @@
+/* QuesoGLC
+ * A free implementation of the OpenGL Character Renderer (GLC)
+ * Copyright (c) 2002, 2004-2009, Bertrand Coconnier
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+/* $Id$ */
+
+/** \file
+ * header of the object __GLCtextObject which stores the layout of a string
+ * compiled for a given rendering style (see glcCompileStringQSO()).
+ */
+
+#ifndef __glc_otextobj_h
+#define __glc_otextobj_h
+
+#include "ofont.h"
+
+typedef struct __GLCtextObjectRec __GLCtextObject;
+
+struct __GLCtextObjectRec {
+  GLCchar32* string;		/* String in visual order and UCS4 format */
+  GLint length;			/* Number of characters of the string */
+  GLboolean isRightToLeft;
+  GLint renderStyle;		/* Rendering style of the compiled data */
+  GLboolean isValid;		/* GL_FALSE if the string must be compiled */
+  GLboolean isCompiled;		/* GL_FALSE if the string is rendered as is */
+  GLuint bufferObject[2];	/* VBOs of the vertices and of the indices */
+  GLint count;			/* Number of indices (GLC_LINE, GLC_TRIANGLE) */
+  __GLCarray* batches;		/* Pages of the atlas used (GLC_TEXTURE) */
+  __GLCarray* glyphs;		/* Glyphes of the atlas used (GLC_TEXTURE) */
+  GLfloat advance[2];		/* Displacement of the pen */
+};
+
+__GLCtextObject* __glcTextObjectCreate(void);
+void __glcTextObjectDestroy(__GLCtextObject* This,
+			    const __GLCcontext* inContext);
+void __glcTextObjectDestroyGLObjects(__GLCtextObject* This,
+				     const __GLCcontext* inContext);
+GLboolean __glcTextObjectSetString(__GLCtextObject* This,
+				   const GLCchar32* inString,
+				   const GLint inLength,
+				   const GLboolean inIsRightToLeft);
+void __glcTextObjectInvalidateGlyph(const __GLCcontext* inContext,
+				    const __GLCglyph* inGlyph);
+void __glcTextObjectInvalidateLayouts(const __GLCcontext* inContext);
+int __glcTextObjectGetBufferObjectCount(const __GLCtextObject* This);
+GLuint __glcTextObjectGetBufferObject(const __GLCtextObject* This,
+				      const int inCount);
+#endif
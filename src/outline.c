@@ -0,0 +1,194 @@
+/* QuesoGLC
+ * A free implementation of the OpenGL Character Renderer (GLC)
+ * Copyright (c) 2002, 2004-2008, Bertrand Coconnier
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+/* $Id$ */
+
+/** \file
+ *  defines the cache of the outlines of the glyphes.
+ *
+ *  Every rendering style needs the outline of the glyph as it is loaded by
+ *  FreeType : it is either decomposed (GLC_LINE and GLC_TRIANGLE) or
+ *  rasterized (GLC_TEXTURE, GLC_BITMAP and GLC_PIXMAP_QSO). A copy of the
+ *  points, the tags and the contours of the outline is stored with the glyph
+ *  so that the glyph does not need to be loaded again when it is rendered
+ *  with another style or rendered again. The amount of memory used by the
+ *  cached outlines of a context is bounded by GLC_OUTLINE_CACHE_SIZE : when
+ *  the cache is full, the outlines that have been the least recently used are
+ *  released. The outlines are linked in a LRU list (the most recently used
+ *  outlines are stored at the head of the list).
+ */
+
+#include "internal.h"
+#include "outline.h"
+
+
+
+/* Amount of memory needed to store the points, the contours and the tags of
+ * an outline.
+ */
+size_t __glcOutlineGetSize(const FT_Outline* inOutline)
+{
+  return inOutline->n_points * (sizeof(inOutline->points[0])
+				+ sizeof(inOutline->tags[0]))
+    + inOutline->n_contours * sizeof(inOutline->contours[0]);
+}
+
+
+
+/* Copy the outline 'inOutline' to 'outOutline'. The points, the contours and
+ * the tags are copied to 'inBuffer' which must be at least
+ * __glcOutlineGetSize(inOutline) bytes large.
+ */
+void __glcOutlineCopy(FT_Outline* outOutline, void* inBuffer,
+		      const FT_Outline* inOutline)
+{
+  outOutline->n_points = inOutline->n_points;
+  outOutline->n_contours = inOutline->n_contours;
+  outOutline->points = (FT_Vector*)inBuffer;
+  outOutline->contours = (void*)(outOutline->points + inOutline->n_points);
+  outOutline->tags = (void*)(outOutline->contours + inOutline->n_contours);
+  /* The memory is not owned by FreeType */
+  outOutline->flags = inOutline->flags & ~FT_OUTLINE_OWNER;
+
+  memcpy(outOutline->points, inOutline->points,
+	 inOutline->n_points * sizeof(inOutline->points[0]));
+  memcpy(outOutline->contours, inOutline->contours,
+	 inOutline->n_contours * sizeof(inOutline->contours[0]));
+  memcpy(outOutline->tags, inOutline->tags,
+	 inOutline->n_points * sizeof(inOutline->tags[0]));
+}
+
+
+
+/* Compute the key of the outline of a glyph of size (inScaleX, inScaleY) */
+static void __glcOutlineCacheMakeKey(const __GLCcontext* inContext,
+				     const GLfloat inScaleX,
+				     const GLfloat inScaleY,
+				     __GLCoutlineKey* outKey)
+{
+  /* Clear the padding bytes so that the keys can be compared with memcmp() */
+  memset(outKey, 0, sizeof(__GLCoutlineKey));
+
+  /* See __glcFaceDescPrepareGlyph() and __glcFaceDescPrepareFont() */
+  outKey->hinting = GLC_GET_HINTING_PROFILE(inContext);
+  outKey->resolution = inContext->enableState.glObjects ? 72
+    : (GLint)inContext->renderState.resolution;
+  outKey->size[0] = (FT_F26Dot6)(inScaleX * 64.);
+  outKey->size[1] = (FT_F26Dot6)(inScaleY * 64.);
+}
+
+
+
+/* Amount of memory used by an outline of the cache */
+static GLint __glcOutlineCacheMemory(const __GLCoutline* This)
+{
+  return (GLint)(sizeof(__GLCoutline) + __glcOutlineGetSize(&This->outline));
+}
+
+
+
+/* Remove an outline from the cache and release its memory */
+void __glcOutlineCacheRemove(__GLCcontext* inContext, __GLCoutline* This)
+{
+  FT_List_Remove(&inContext->outlineList, (FT_ListNode)This);
+  inContext->outlineCacheUsed -= __glcOutlineCacheMemory(This);
+  This->glyph->outline = NULL;
+  __glcFree(This);
+}
+
+
+
+/* Store a copy of the outline 'inOutline' of the glyph 'inGlyph' in the cache.
+ * The least recently used outlines are released to make room for it. If the
+ * memory can not be allocated, the outline is simply not stored.
+ */
+static void __glcOutlineCacheStore(__GLCcontext* inContext,
+				   __GLCglyph* inGlyph,
+				   const __GLCoutlineKey* inKey,
+				   const FT_Outline* inOutline)
+{
+  const GLint memory = (GLint)(sizeof(__GLCoutline)
+			       + __glcOutlineGetSize(inOutline));
+  __GLCoutline* This = NULL;
+
+  if (inGlyph->outline)
+    __glcOutlineCacheRemove(inContext, inGlyph->outline);
+
+  if (memory > GLC_OUTLINE_CACHE_SIZE)
+    return;
+
+  /* Release the least recently used outlines */
+  while ((inContext->outlineCacheUsed > GLC_OUTLINE_CACHE_SIZE - memory)
+	 && inContext->outlineList.tail)
+    __glcOutlineCacheRemove(inContext,
+			    (__GLCoutline*)inContext->outlineList.tail);
+
+  This = (__GLCoutline*)__glcMalloc(memory);
+  if (!This)
+    return;
+
+  This->glyph = inGlyph;
+  memcpy(&This->key, inKey, sizeof(__GLCoutlineKey));
+  __glcOutlineCopy(&This->outline, This + 1, inOutline);
+
+  This->node.data = This;
+  FT_List_Insert(&inContext->outlineList, (FT_ListNode)This);
+  inContext->outlineCacheUsed += memory;
+  inGlyph->outline = This;
+}
+
+
+
+/* Make the outline of the glyph 'inGlyph' of size (inScaleX, inScaleY) the
+ * outline of the face descriptor 'inFaceDesc' that is used by the renderers.
+ * The outline is looked up in the cache first : the glyph is only loaded by
+ * FreeType if its outline has not been cached yet for the same parameters.
+ */
+GLboolean __glcOutlineCacheLoad(__GLCcontext* inContext,
+				__GLCfaceDescriptor* inFaceDesc,
+				__GLCglyph* inGlyph, const GLfloat inScaleX,
+				const GLfloat inScaleY)
+{
+  __GLCoutlineKey key;
+  GLboolean result = GL_FALSE;
+
+  __glcOutlineCacheMakeKey(inContext, inScaleX, inScaleY, &key);
+
+  if (inGlyph->outline && !memcmp(&inGlyph->outline->key, &key,
+				  sizeof(__GLCoutlineKey))) {
+    /* Move the outline at the head of the LRU list */
+    FT_List_Up(&inContext->outlineList, (FT_ListNode)inGlyph->outline);
+    return __glcFaceDescSetOutline(inFaceDesc, &inGlyph->outline->outline);
+  }
+
+  if (!__glcFaceDescPrepareGlyph(inFaceDesc, inContext, inScaleX, inScaleY,
+				 inGlyph->index))
+    return GL_FALSE;
+
+  result = __glcFaceDescSetOutline(inFaceDesc,
+				   &inFaceDesc->face->glyph->outline);
+  if (result)
+    __glcOutlineCacheStore(inContext, inGlyph, &key,
+			   &inFaceDesc->face->glyph->outline);
+
+#ifndef GLC_FT_CACHE
+  __glcFaceDescClose(inFaceDesc);
+#endif
+
+  return result;
+}
@@ -0,0 +1,60 @@
+/* QuesoGLC
+ * A free implementation of the OpenGL Character Renderer (GLC)
+ * Copyright (c) 2002, 2004-2008, Bertrand Coconnier
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+/* $Id$ */
+
+/** \file
+ *  header of the cache of the outlines of the glyphes that are rendered with
+ *  GLC_LINE, GLC_TRIANGLE, GLC_TEXTURE, GLC_BITMAP and GLC_PIXMAP_QSO.
+ */
+
+#ifndef __glc_outline_h
+#define __glc_outline_h
+
+#include "ofont.h"
+
+/* Maximum amount of memory used by the cached outlines of a context */
+#define GLC_OUTLINE_CACHE_SIZE	(1 << 20)
+
+typedef struct __GLCoutlineKeyRec __GLCoutlineKey;
+
+/* The outline of a glyph depends on the size of the font and on the way it is
+ * loaded by FreeType (hinting profile and resolution).
+ */
+struct __GLCoutlineKeyRec {
+  GLint hinting;		/* See GLC_GET_HINTING_PROFILE() */
+  GLint resolution;
+  FT_F26Dot6 size[2];
+};
+
+struct __GLCoutlineRec {
+  FT_ListNodeRec node;		/* Node of the LRU list */
+  __GLCglyph* glyph;		/* Glyph which the outline belongs to */
+  __GLCoutlineKey key;
+  FT_Outline outline;		/* Points, contours and tags follow */
+};
+
+size_t __glcOutlineGetSize(const FT_Outline* inOutline);
+void __glcOutlineCopy(FT_Outline* outOutline, void* inBuffer,
+		      const FT_Outline* inOutline);
+GLboolean __glcOutlineCacheLoad(__GLCcontext* inContext,
+				__GLCfaceDescriptor* inFaceDesc,
+				__GLCglyph* inGlyph, const GLfloat inScaleX,
+				const GLfloat inScaleY);
+void __glcOutlineCacheRemove(__GLCcontext* inContext, __GLCoutline* This);
+#endif /* __glc_outline_h */
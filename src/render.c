@@ -90,36 +90,34 @@
 #include <math.h>
 
 #include "texture.h"
+#include "bitmap.h"
+#include "otextobj.h"
 
 
 
-/* This internal function renders a glyph using the GLC_BITMAP format */
-/* TODO : Render Bitmap fonts */
+/* This internal function renders a glyph using the GLC_BITMAP format. The
+ * bitmap of the glyph is looked up in the cache and it is rasterized only if it
+ * is not found. If GLC_EMBEDDED_BITMAP_QSO is enabled, the bitmap may also be
+ * copied from a strike of the font by __glcRenderChar().
+ */
 static void __glcRenderCharBitmap(const __GLCfont* inFont,
-				  const __GLCcontext* inContext,
+				  __GLCcontext* inContext,
                                   const GLfloat inScaleX,
 				  const GLfloat inScaleY,
+				  const GLCulong inGlyphIndex,
+				  __GLCbitmap* inBitmap,
 				  const GLfloat* inAdvance,
 				  const GLboolean inIsRTL)
 {
   GLfloat *transform = inContext->bitmapMatrix;
-  GLint pixWidth = 0, pixHeight = 0;
-  GLubyte* pixBuffer = NULL;
-  GLint pixBoundingBox[4] = {0, 0, 0, 0};
-
-  __glcFontGetBitmapSize(inFont, &pixWidth, &pixHeight, inScaleX, inScaleY, 0,
-			 pixBoundingBox, inContext);
-
-  pixBuffer = (GLubyte *)__glcMalloc(pixWidth * pixHeight);
-  if (!pixBuffer) {
-    __glcRaiseError(GLC_RESOURCE_ERROR);
-    return;
-  }
+  __GLCbitmap* bitmap = inBitmap;
 
   /* render the glyph */
-  if (!__glcFontGetBitmap(inFont, pixWidth, pixHeight, pixBuffer, inContext)) {
-    __glcFree(pixBuffer);
-    return;
+  if (!bitmap) {
+    bitmap = __glcBitmapCacheRender(inContext, inFont, inGlyphIndex, inScaleX,
+				    inScaleY);
+    if (!bitmap)
+      return;
   }
 
   /* Do the actual GL rendering */
@@ -128,48 +126,47 @@ static void __glcRenderCharBitmap(const __GLCfont* inFont,
 	     inAdvance[1] * transform[2] - inAdvance[0] * transform[0],
 	     inAdvance[1] * transform[3] - inAdvance[0] * transform[1],
 	     NULL);
-    glBitmap(pixWidth, pixHeight, - pixBoundingBox[0] >> 6,
-	     -pixBoundingBox[1] >> 6, 0., 0., pixBuffer);
+    glBitmap(bitmap->width, bitmap->height, - bitmap->boundingBox[0] >> 6,
+	     -bitmap->boundingBox[1] >> 6, 0., 0., bitmap->buffer);
   }
   else
-    glBitmap(pixWidth, pixHeight, -pixBoundingBox[0] >> 6,
-	     -pixBoundingBox[1] >> 6,
+    glBitmap(bitmap->width, bitmap->height, -bitmap->boundingBox[0] >> 6,
+	     -bitmap->boundingBox[1] >> 6,
 	     inAdvance[0] * transform[0] + inAdvance[1] * transform[2],
 	     inAdvance[0] * transform[1] + inAdvance[1] * transform[3],
-	     pixBuffer);
+	     bitmap->buffer);
 
-  __glcFree(pixBuffer);
+  __glcBitmapCacheRelease(bitmap);
 }
 
 
 
-/* This internal function renders a glyph using the GLC_PIXMAP_QSO format */
+/* This internal function renders a glyph using the GLC_PIXMAP_QSO format. The
+ * pixmap of the glyph is looked up in the cache and it is rasterized only if it
+ * is not found.
+ */
 static void __glcRenderCharPixmap(const __GLCfont* inFont,
-				  const __GLCcontext* inContext,
+				  __GLCcontext* inContext,
                                   const GLfloat scaleX, const GLfloat scaleY,
+				  const GLCulong inGlyphIndex,
+				  __GLCbitmap* inBitmap,
                                   const GLfloat* advance,
 				  const GLboolean inIsRTL)
 {
   GLfloat *transform = inContext->bitmapMatrix;
-  GLint pixWidth = 0, pixHeight = 0;
-  GLubyte* pixBuffer = NULL;
-  GLint pixBoundingBox[4] = {0, 0, 0, 0};
-
-  __glcFontGetBitmapSize(inFont, &pixWidth, &pixHeight, scaleX, scaleY, 0,
-			 pixBoundingBox, inContext);
-
-  pixBuffer = (GLubyte *)__glcMalloc(pixWidth * pixHeight);
-  if (!pixBuffer) {
-    __glcRaiseError(GLC_RESOURCE_ERROR);
-    return;
-  }
+  __GLCbitmap* bitmap = inBitmap;
+  GLint* pixBoundingBox = NULL;
 
   /* render the glyph */
-  if (!__glcFontGetBitmap(inFont, pixWidth, pixHeight, pixBuffer, inContext)) {
-    __glcFree(pixBuffer);
-    return;
+  if (!bitmap) {
+    bitmap = __glcBitmapCacheRender(inContext, inFont, inGlyphIndex, scaleX,
+				    scaleY);
+    if (!bitmap)
+      return;
   }
 
+  pixBoundingBox = bitmap->boundingBox;
+
   /* Do the actual GL rendering */
   if (inIsRTL) {
     glBitmap(0, 0, 0.f, 0.f,
@@ -179,7 +176,8 @@ static void __glcRenderCharPixmap(const __GLCfont* inFont,
 	     (pixBoundingBox[1] >> 6),
 	     NULL);
 
-    glDrawPixels(pixWidth, pixHeight, GL_ALPHA, GL_UNSIGNED_BYTE, pixBuffer);
+    glDrawPixels(bitmap->width, bitmap->height, GL_ALPHA, GL_UNSIGNED_BYTE,
+		 bitmap->buffer);
 
     glBitmap(0, 0, 0.f, 0.f,
 	     -(pixBoundingBox[0] >> 6),
@@ -192,7 +190,8 @@ static void __glcRenderCharPixmap(const __GLCfont* inFont,
 	     pixBoundingBox[1] >> 6, 
 	     NULL);
 
-    glDrawPixels(pixWidth, pixHeight, GL_ALPHA, GL_UNSIGNED_BYTE, pixBuffer);
+    glDrawPixels(bitmap->width, bitmap->height, GL_ALPHA, GL_UNSIGNED_BYTE,
+		 bitmap->buffer);
 
     glBitmap(0, 0, 0.f, 0.f,
 	     advance[0] * transform[0] + advance[1] * transform[2] - 
@@ -202,7 +201,167 @@ static void __glcRenderCharPixmap(const __GLCfont* inFont,
 	     NULL);
   }
 
-  __glcFree(pixBuffer);
+  __glcBitmapCacheRelease(bitmap);
+}
+
+
+
+/* When GLC_COMPOSITE_PIXMAP_QSO is enabled, the pixmaps of the glyphes of a
+ * string are copied in the pixmap buffer of the context and their locations
+ * are recorded by __glcRenderCharComposite(). They are composited and drawn
+ * once the whole string has been processed.
+ */
+typedef struct __GLCcompositeRec __GLCcomposite;
+typedef struct __GLCcompositeGlyphRec __GLCcompositeGlyph;
+
+struct __GLCcompositeRec {
+  GLfloat origin[2];	/* Raster position at the beginning of the string */
+  GLfloat pen[2];	/* Displacement of the raster position */
+  size_t size;		/* Size of the pixmaps stored in the pixmap buffer */
+};
+
+struct __GLCcompositeGlyphRec {
+  GLint x, y;		/* Location of the pixmap in window coordinates */
+  GLint width, height;	/* Dimensions of the pixmap */
+  size_t offset;	/* Location of the pixmap in the pixmap buffer */
+};
+
+
+
+/* This internal function checks that the pixmap buffer of the context can
+ * store 'inSize' bytes and returns a pointer to it (or NULL if the buffer could
+ * not be enlarged).
+ */
+static GLubyte* __glcRenderQueryPixmapBuffer(__GLCcontext* inContext,
+					     const size_t inSize)
+{
+  GLubyte* buffer = NULL;
+
+  if (inSize <= inContext->pixmapBufferSize)
+    return inContext->pixmapBuffer;
+
+  buffer = (GLubyte*)__glcRealloc(inContext->pixmapBuffer, inSize);
+  if (!buffer) {
+    __glcRaiseError(GLC_RESOURCE_ERROR);
+    return NULL;
+  }
+
+  inContext->pixmapBuffer = buffer;
+  inContext->pixmapBufferSize = inSize;
+  return buffer;
+}
+
+
+
+/* This internal function moves the raster position of the GLC_BITMAP and
+ * GLC_PIXMAP_QSO rendering styles. If a pixmap is being composited, only the
+ * pen of the composited pixmap is moved.
+ */
+static void __glcRenderMoveRaster(__GLCcomposite* inComposite,
+				  const GLfloat inX, const GLfloat inY)
+{
+  if (inComposite) {
+    inComposite->pen[0] += inX;
+    inComposite->pen[1] += inY;
+  }
+  else
+    glBitmap(0, 0, 0.f, 0.f, inX, inY, NULL);
+}
+
+
+
+/* This internal function records the pixmap of a glyph in the composited
+ * pixmap of a string (GLC_PIXMAP_QSO rendering style with
+ * GLC_COMPOSITE_PIXMAP_QSO enabled). The glyph is located exactly where
+ * __glcRenderCharPixmap() would have drawn it.
+ */
+static void __glcRenderCharComposite(const __GLCfont* inFont,
+				     __GLCcontext* inContext,
+				     const GLfloat scaleX, const GLfloat scaleY,
+				     const GLCulong inGlyphIndex,
+				     __GLCbitmap* inBitmap,
+				     const GLfloat* advance,
+				     const GLboolean inIsRTL,
+				     __GLCcomposite* inComposite)
+{
+  GLfloat *transform = inContext->bitmapMatrix;
+  __GLCbitmap* bitmap = inBitmap;
+  __GLCcompositeGlyph glyph;
+  GLubyte* buffer = NULL;
+  GLint size = 0;
+
+  /* render the glyph */
+  if (!bitmap) {
+    bitmap = __glcBitmapCacheRender(inContext, inFont, inGlyphIndex, scaleX,
+				    scaleY);
+    if (!bitmap)
+      return;
+  }
+
+  if (inIsRTL)
+    __glcRenderMoveRaster(inComposite,
+			  advance[1] * transform[2] - advance[0] * transform[0],
+			  advance[1] * transform[3] - advance[0] * transform[1]);
+
+  size = bitmap->width * bitmap->height;
+
+  if (size) {
+    /* The pixmap is copied since it may be released from the cache by the
+     * next glyphes of the string.
+     */
+    buffer = __glcRenderQueryPixmapBuffer(inContext, inComposite->size + size);
+
+    if (buffer) {
+      glyph.x = (GLint)floor(inComposite->origin[0] + inComposite->pen[0]
+			     + (bitmap->boundingBox[0] >> 6) + 0.5f);
+      glyph.y = (GLint)floor(inComposite->origin[1] + inComposite->pen[1]
+			     + (bitmap->boundingBox[1] >> 6) + 0.5f);
+      glyph.width = bitmap->width;
+      glyph.height = bitmap->height;
+      glyph.offset = inComposite->size;
+
+      if (__glcArrayAppend(inContext->pixmapGlyphs, &glyph)) {
+	memcpy(buffer + inComposite->size, bitmap->buffer, size);
+	inComposite->size += size;
+      }
+    }
+  }
+
+  if (!inIsRTL)
+    __glcRenderMoveRaster(inComposite,
+			  advance[0] * transform[0] + advance[1] * transform[2],
+			  advance[0] * transform[1] + advance[1] * transform[3]);
+
+  __glcBitmapCacheRelease(bitmap);
+}
+
+
+
+/* This internal function computes the transformation matrix and the scale of
+ * the glyphes. If GLC_USER_TRANSFORM_QSO is enabled, they are computed once
+ * per string from the matrices given by glcLoadTransformQSO() and the cached
+ * values are returned for the following glyphes of the string.
+ */
+static void __glcRenderGetScale(__GLCcontext* inContext,
+				GLfloat* outTransformMatrix,
+				GLfloat* outScaleX, GLfloat* outScaleY)
+{
+  if (!inContext->enableState.userTransform
+      || (inContext->renderState.renderStyle == GLC_BITMAP)
+      || (inContext->renderState.renderStyle == GLC_PIXMAP_QSO)) {
+    __glcGetScale(inContext, outTransformMatrix, outScaleX, outScaleY);
+    return;
+  }
+
+  if (!inContext->isScaleCached) {
+    __glcGetScale(inContext, inContext->cachedTransform,
+		  &inContext->cachedScale[0], &inContext->cachedScale[1]);
+    inContext->isScaleCached = GL_TRUE;
+  }
+
+  memcpy(outTransformMatrix, inContext->cachedTransform, 16 * sizeof(GLfloat));
+  *outScaleX = inContext->cachedScale[0];
+  *outScaleY = inContext->cachedScale[1];
 }
 
 
@@ -213,19 +372,21 @@ static void __glcRenderCharPixmap(const __GLCfont* inFont,
 static void* __glcRenderChar(const GLint inCode, const GLint inPrevCode,
 			     const GLboolean inIsRTL, const __GLCfont* inFont,
 			     __GLCcontext* inContext,
-			     const void* GLC_UNUSED_ARG(inData),
+			     const void* inData,
 			     const GLboolean GLC_UNUSED_ARG(inMultipleChars))
 {
+  __GLCcomposite* composite = (__GLCcomposite*)inData;
   GLfloat transformMatrix[16];
   GLfloat scaleX = GLC_POINT_SIZE;
   GLfloat scaleY = GLC_POINT_SIZE;
   __GLCglyph* glyph = NULL;
   GLfloat sx64 = 0., sy64 = 0.;
   GLfloat advance[2] = {0., 0.};
+  __GLCbitmap* bitmap = NULL;
 
   assert(inFont);
 
-  __glcGetScale(inContext, transformMatrix, &scaleX, &scaleY);
+  __glcRenderGetScale(inContext, transformMatrix, &scaleX, &scaleY);
 
   if ((fabs(scaleX) < GLC_EPSILON) || (fabs(scaleY) < GLC_EPSILON))
     return NULL;
@@ -247,14 +408,13 @@ static void* __glcRenderChar(const GLint inCode, const GLint inPrevCode,
 
       if ((inContext->renderState.renderStyle == GLC_BITMAP)
           || (inContext->renderState.renderStyle == GLC_PIXMAP_QSO))
-	glBitmap(0, 0, 0, 0,
-		 kerning[0] * inContext->bitmapMatrix[0] 
-		 + kerning[1] * inContext->bitmapMatrix[2],
-		 kerning[0] * inContext->bitmapMatrix[1]
-		 + kerning[1] * inContext->bitmapMatrix[3],
-		 NULL);
+	__glcRenderMoveRaster(composite,
+			      kerning[0] * inContext->bitmapMatrix[0]
+			      + kerning[1] * inContext->bitmapMatrix[2],
+			      kerning[0] * inContext->bitmapMatrix[1]
+			      + kerning[1] * inContext->bitmapMatrix[3]);
       else
-	glTranslatef(kerning[0], kerning[1], 0.f);
+	__glcTranslate(inContext, kerning[0], kerning[1]);
     }
   }
 
@@ -269,9 +429,22 @@ static void* __glcRenderChar(const GLint inCode, const GLint inPrevCode,
   /* Get and load the glyph which unicode code is identified by inCode */
   glyph = __glcFontGetGlyph(inFont, inCode, inContext);
 
-  if (inContext->enableState.glObjects
-      && !__glcFontPrepareGlyph(inFont, inContext, scaleX, scaleY,
-				glyph->index)) {
+  /* If the bitmap of the glyph is cached, there is no need to load the glyph */
+  if ((inContext->renderState.renderStyle == GLC_BITMAP)
+      || (inContext->renderState.renderStyle == GLC_PIXMAP_QSO))
+    bitmap = __glcBitmapCacheLookup(inContext, inFont, glyph->index, scaleX,
+				    scaleY);
+
+  /* Otherwise if the font has a strike of the size of the glyph, the bitmap is
+   * copied from the strike and the outline of the glyph is not loaded.
+   */
+  if (!bitmap && inContext->enableState.embeddedBitmap
+      && (inContext->renderState.renderStyle == GLC_BITMAP))
+    bitmap = __glcBitmapCacheRenderStrike(inContext, inFont, glyph->index,
+					  scaleX, scaleY);
+
+  if (!bitmap
+      && !__glcFontPrepareGlyph(inFont, inContext, scaleX, scaleY, glyph)) {
 #ifndef GLC_FT_CACHE
     __glcFontClose(inFont);
 #endif
@@ -284,7 +457,7 @@ static void* __glcRenderChar(const GLint inCode, const GLint inPrevCode,
   if ((inContext->renderState.renderStyle != GLC_BITMAP)
       && (inContext->renderState.renderStyle != GLC_PIXMAP_QSO)) {
     if (inIsRTL)
-      glTranslatef(-advance[0], advance[1], 0.f);
+      __glcTranslate(inContext, -advance[0], advance[1]);
 
     /* If the outline contains no point then the glyph represents a space
      * character and there is no need to continue the process of rendering.
@@ -292,7 +465,7 @@ static void* __glcRenderChar(const GLint inCode, const GLint inPrevCode,
     if (!__glcFontOutlineEmpty(inFont)) {
       /* Update the advance and return */
       if (!inIsRTL)
-        glTranslatef(advance[0], advance[1], 0.f);
+        __glcTranslate(inContext, advance[0], advance[1]);
       if (inContext->enableState.glObjects)
 	glyph->isSpacingChar = GL_TRUE;
 #ifndef GLC_FT_CACHE
@@ -311,23 +484,27 @@ static void* __glcRenderChar(const GLint inCode, const GLint inPrevCode,
   /* Call the appropriate function depending on the rendering mode */
   switch(inContext->renderState.renderStyle) {
   case GLC_BITMAP:
-    __glcRenderCharBitmap(inFont, inContext, scaleX, scaleY, advance,
-			  inIsRTL);
+    __glcRenderCharBitmap(inFont, inContext, scaleX, scaleY, glyph->index,
+			  bitmap, advance, inIsRTL);
     break;
   case GLC_PIXMAP_QSO:
-    __glcRenderCharPixmap(inFont, inContext, scaleX, scaleY, advance,
-			  inIsRTL);
+    if (composite)
+      __glcRenderCharComposite(inFont, inContext, scaleX, scaleY, glyph->index,
+			       bitmap, advance, inIsRTL, composite);
+    else
+      __glcRenderCharPixmap(inFont, inContext, scaleX, scaleY, glyph->index,
+			    bitmap, advance, inIsRTL);
     break;
   case GLC_TEXTURE:
-    __glcRenderCharTexture(inFont, inContext, scaleX, scaleY, glyph);
+    __glcRenderCharTexture(inFont, inContext, scaleX, scaleY, glyph, GL_TRUE);
     break;
   case GLC_LINE:
     __glcRenderCharScalable(inFont, inContext, transformMatrix, scaleX,
-			    scaleY, glyph);
+			    scaleY, glyph, GL_TRUE);
     break;
   case GLC_TRIANGLE:
     __glcRenderCharScalable(inFont, inContext, transformMatrix, scaleX,
-			    scaleY, glyph);
+			    scaleY, glyph, GL_TRUE);
     break;
   default:
     __glcRaiseError(GLC_PARAMETER_ERROR);
@@ -338,7 +515,7 @@ static void* __glcRenderChar(const GLint inCode, const GLint inPrevCode,
     if (!inContext->enableState.glObjects)
       glScalef(sx64, sy64, 1.);
     if (!inIsRTL)
-      glTranslatef(advance[0], advance[1], 0.f);
+      __glcTranslate(inContext, advance[0], advance[1]);
   }
 #ifndef GLC_FT_CACHE
   __glcFontClose(inFont);
@@ -348,50 +525,238 @@ static void* __glcRenderChar(const GLint inCode, const GLint inPrevCode,
 
 
 
-/* This internal function is used by both glcRenderString() and
- * glcRenderCountedString(). The string 'inString' must be sorted in visual
- * order and stored using UCS4 format.
+/* This internal function multiplies two 8 bits values that represent numbers
+ * in [0, 1] : it returns (a * b / 255) rounded to the nearest integer.
  */
-static void __glcRenderCountedString(__GLCcontext* inContext,
-				     const GLCchar32* inString,
-				     const GLboolean inIsRightToLeft,
-				     const GLint inCount)
+static GLuint __glcRenderMul255(const GLuint a, const GLuint b)
+{
+  GLuint t = a * b + 128;
+
+  return (t + (t >> 8)) >> 8;
+}
+
+
+
+/* This internal function records the pixmaps of the glyphes of the string
+ * 'inString' in the pixmap buffer of the context (see
+ * __glcRenderCharComposite()). The origin of 'ioComposite' must have been set
+ * by the caller and the rendering style must be GLC_PIXMAP_QSO. The function
+ * issues no GL command. The string must be sorted in visual order and stored
+ * using UCS4 format.
+ */
+static GLboolean __glcRenderCollectPixmaps(__GLCcontext* inContext,
+					   const GLCchar32* inString,
+					   const GLboolean inIsRightToLeft,
+					   const GLint inCount,
+					   __GLCcomposite* ioComposite)
 {
-  GLint listIndex = 0;
-  GLint i = 0;
-  const GLCchar32* ptr = NULL;
-  __GLCglState GLState;
   __GLCcharacter prevCode = {0, NULL, NULL, {0.f, 0.f}};
-  GLboolean saveGLObjects = GL_FALSE;
+  const GLCchar32* ptr = inString;
   GLint shift = 1;
-  __GLCcharacter* chars = NULL;
-  GLfloat pixmapColor[4];
+  GLint i = 0;
 
-  /* Disable the internal management of GL objects when the user is currently
-   * building a display list.
-   */
-  glGetIntegerv(GL_LIST_INDEX, &listIndex);
-  if (listIndex) {
-    saveGLObjects = inContext->enableState.glObjects;
-    inContext->enableState.glObjects = GL_FALSE;
+  if (!inContext->pixmapGlyphs) {
+    inContext->pixmapGlyphs = __glcArrayCreate(sizeof(__GLCcompositeGlyph));
+    if (!inContext->pixmapGlyphs)
+      return GL_FALSE;
   }
+  GLC_ARRAY_LENGTH(inContext->pixmapGlyphs) = 0;
 
+  ioComposite->pen[0] = 0.f;
+  ioComposite->pen[1] = 0.f;
+  ioComposite->size = 0;
 
-  /* Allocate a buffer to store the glyphes informations of the string to be
-   * rendered.
-   */
-  if (inContext->enableState.glObjects
-      && (inContext->renderState.renderStyle != GLC_BITMAP)
-      && (inContext->renderState.renderStyle != GLC_PIXMAP_QSO)) {
-    chars = (__GLCcharacter*)__glcMalloc(inCount * sizeof(__GLCcharacter));
-    if (!chars) {
-      __glcRaiseError(GLC_RESOURCE_ERROR);
-      return;
+  if (inIsRightToLeft) {
+    ptr += inCount - 1;
+    shift = -1;
+  }
+
+  for (i = 0; i < inCount; i++, ptr += shift) {
+    if (*ptr >= 32)
+      __glcProcessChar(inContext, *ptr, &prevCode, inIsRightToLeft,
+		       __glcRenderChar, ioComposite);
+  }
+
+  return GL_TRUE;
+}
+
+
+
+/* This internal function renders the string 'inString' in GLC_PIXMAP_QSO mode
+ * when GLC_COMPOSITE_PIXMAP_QSO is enabled : the pixmaps of the glyphes are
+ * blended in a single pixmap which is drawn by a single call to
+ * glDrawPixels(). The string must be sorted in visual order and stored using
+ * UCS4 format.
+ */
+static void __glcRenderCompositeString(__GLCcontext* inContext,
+				       const GLCchar32* inString,
+				       const GLboolean inIsRightToLeft,
+				       const GLint inCount)
+{
+  __GLCcomposite composite;
+  __GLCcompositeGlyph* glyphs = NULL;
+  GLfloat rasterPos[4];
+  GLint xMin = 0, yMin = 0, xMax = 0, yMax = 0;
+  GLint width = 0, height = 0;
+  GLubyte* buffer = NULL;
+  GLint i = 0;
+
+  glGetFloatv(GL_CURRENT_RASTER_POSITION, rasterPos);
+  composite.origin[0] = rasterPos[0];
+  composite.origin[1] = rasterPos[1];
+
+  /* Collect the pixmaps of the glyphes */
+  if (!__glcRenderCollectPixmaps(inContext, inString, inIsRightToLeft, inCount,
+				 &composite))
+    return;
+
+  /* Compute the bounding box of the composited pixmap */
+  glyphs = (__GLCcompositeGlyph*)GLC_ARRAY_DATA(inContext->pixmapGlyphs);
+
+  for (i = 0; i < GLC_ARRAY_LENGTH(inContext->pixmapGlyphs); i++) {
+    if (!i || (glyphs[i].x < xMin))
+      xMin = glyphs[i].x;
+    if (!i || (glyphs[i].y < yMin))
+      yMin = glyphs[i].y;
+    if (!i || (glyphs[i].x + glyphs[i].width > xMax))
+      xMax = glyphs[i].x + glyphs[i].width;
+    if (!i || (glyphs[i].y + glyphs[i].height > yMax))
+      yMax = glyphs[i].y + glyphs[i].height;
+  }
+
+  width = xMax - xMin;
+  height = yMax - yMin;
+
+  if (width && height)
+    buffer = __glcRenderQueryPixmapBuffer(inContext,
+					  composite.size + width * height);
+
+  if (buffer) {
+    GLubyte* pixmap = buffer + composite.size;
+
+    memset(pixmap, 0, width * height);
+
+    /* The coverages of overlapping glyphes are combined as if the pixmaps
+     * were blended one after the other.
+     */
+    for (i = 0; i < GLC_ARRAY_LENGTH(inContext->pixmapGlyphs); i++) {
+      GLubyte* src = buffer + glyphs[i].offset;
+      GLint j = 0;
+
+      for (j = 0; j < glyphs[i].height; j++) {
+	GLubyte* dst = pixmap + (glyphs[i].y - yMin + j) * width
+	  + glyphs[i].x - xMin;
+	GLint k = 0;
+
+	for (k = 0; k < glyphs[i].width; k++, src++, dst++) {
+	  if (*src)
+	    *dst = (GLubyte)(*dst + *src - __glcRenderMul255(*dst, *src));
+	}
+      }
+    }
+
+    /* Do the actual GL rendering */
+    glBitmap(0, 0, 0.f, 0.f, xMin - composite.origin[0],
+	     yMin - composite.origin[1], NULL);
+    glDrawPixels(width, height, GL_ALPHA, GL_UNSIGNED_BYTE, pixmap);
+    glBitmap(0, 0, 0.f, 0.f, composite.origin[0] + composite.pen[0] - xMin,
+	     composite.origin[1] + composite.pen[1] - yMin, NULL);
+  }
+  else
+    glBitmap(0, 0, 0.f, 0.f, composite.pen[0], composite.pen[1], NULL);
+}
+
+
+
+/* This internal function blends the pixmaps that have been recorded by
+ * __glcRenderCollectPixmaps() in the user buffer 'outBuffer' which rows are
+ * 'inStride' bytes apart. The format of the buffer is either GL_ALPHA (the
+ * coverages are combined) or GL_RGBA (the color 'inColor', given in [0, 255],
+ * is blended over the buffer). The pixmaps are clipped to the dimensions of the
+ * buffer. The inner loops do not branch so that the compiler can vectorize
+ * them.
+ */
+static void __glcRenderBlendPixmaps(const __GLCcontext* inContext,
+				    const GLenum inFormat,
+				    const GLint inWidth, const GLint inHeight,
+				    const GLint inStride, GLubyte* outBuffer,
+				    const GLuint* inColor)
+{
+  const __GLCcompositeGlyph* glyphs =
+    (const __GLCcompositeGlyph*)GLC_ARRAY_DATA(inContext->pixmapGlyphs);
+  GLint pixelSize = (inFormat == GL_RGBA) ? 4 : 1;
+  GLint i = 0;
+
+  for (i = 0; i < GLC_ARRAY_LENGTH(inContext->pixmapGlyphs); i++) {
+    GLint x0 = (glyphs[i].x > 0) ? glyphs[i].x : 0;
+    GLint y0 = (glyphs[i].y > 0) ? glyphs[i].y : 0;
+    GLint x1 = glyphs[i].x + glyphs[i].width;
+    GLint y1 = glyphs[i].y + glyphs[i].height;
+    GLint j = 0;
+
+    x1 = (x1 < inWidth) ? x1 : inWidth;
+    y1 = (y1 < inHeight) ? y1 : inHeight;
+
+    for (j = y0; j < y1; j++) {
+      const GLubyte* src = inContext->pixmapBuffer + glyphs[i].offset
+	+ (j - glyphs[i].y) * glyphs[i].width + x0 - glyphs[i].x;
+      GLubyte* dst = outBuffer + j * inStride + x0 * pixelSize;
+      GLint k = 0;
+
+      if (inFormat == GL_ALPHA) {
+	for (k = 0; k < x1 - x0; k++)
+	  dst[k] = (GLubyte)(dst[k] + src[k] - __glcRenderMul255(dst[k],
+								 src[k]));
+      }
+      else {
+	for (k = 0; k < x1 - x0; k++, dst += 4) {
+	  GLuint alpha = __glcRenderMul255(src[k], inColor[3]);
+	  GLuint invAlpha = 255 - alpha;
+
+	  dst[0] = (GLubyte)(__glcRenderMul255(inColor[0], alpha)
+			     + __glcRenderMul255(dst[0], invAlpha));
+	  dst[1] = (GLubyte)(__glcRenderMul255(inColor[1], alpha)
+			     + __glcRenderMul255(dst[1], invAlpha));
+	  dst[2] = (GLubyte)(__glcRenderMul255(inColor[2], alpha)
+			     + __glcRenderMul255(dst[2], invAlpha));
+	  dst[3] = (GLubyte)(alpha + __glcRenderMul255(dst[3], invAlpha));
+	}
+      }
     }
   }
+}
+
+
+
+/* This internal function sets the pixel transfer parameters so that the
+ * pixmaps of the GLC_PIXMAP_QSO rendering style are drawn with the color
+ * 'inColor'.
+ */
+static void __glcRenderPixmapColor(const GLfloat* inColor)
+{
+  glPixelTransferf(GL_RED_BIAS, inColor[0]);
+  glPixelTransferf(GL_GREEN_BIAS, inColor[1]);
+  glPixelTransferf(GL_BLUE_BIAS, inColor[2]);
+  glPixelTransferf(GL_ALPHA_BIAS, 0.f);
+  glPixelTransferf(GL_RED_SCALE, 1.f);
+  glPixelTransferf(GL_GREEN_SCALE, 1.f);
+  glPixelTransferf(GL_BLUE_SCALE, 1.f);
+  glPixelTransferf(GL_ALPHA_SCALE, inColor[3]);
+}
+
+
+
+/* This internal function saves the GL state in 'outGLState' then sets the GL
+ * parameters that are needed by the current rendering style. It is called
+ * once before a string or a batch of strings is rendered.
+ */
+static void __glcRenderSetupGLState(__GLCcontext* inContext,
+				    __GLCglState* outGLState)
+{
+  GLfloat pixmapColor[4];
 
   /* Save the value of the GL parameters */
-  __glcSaveGLState(&GLState, inContext, GL_FALSE);
+  __glcSaveGLState(outGLState, inContext, GL_FALSE);
 
   /* Set the vertex arrays parameters for GLC_LINE and GLC_TRIANGLE rendering
    * styles when GLC_GL_OBJECTS is enabled.
@@ -419,14 +784,10 @@ static void __glcRenderCountedString(__GLCcontext* inContext,
     glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
     glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
     if (inContext->enableState.glObjects) {
-      if (inContext->atlas.id)
-	glBindTexture(GL_TEXTURE_2D, inContext->atlas.id);
-      if (GLEW_ARB_vertex_buffer_object) {
-	if (inContext->atlas.bufferObjectID) {
-	  glBindBufferARB(GL_ARRAY_BUFFER_ARB, inContext->atlas.bufferObjectID);
-	  glInterleavedArrays(GL_T2F_V3F, 0, NULL);
-	}
-      }
+      /* Pages of the atlas that are not used by this string (or batch of
+       * strings) are evicted first.
+       */
+      inContext->atlasStamp++;
     }
     else if (inContext->texture.id) {
       glBindTexture(GL_TEXTURE_2D, inContext->texture.id);
@@ -448,17 +809,141 @@ static void __glcRenderCountedString(__GLCcontext* inContext,
       glEnable(GL_BLEND);
       glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
       glGetFloatv(GL_CURRENT_RASTER_COLOR, pixmapColor);
-      glPixelTransferf(GL_RED_BIAS, pixmapColor[0]);
-      glPixelTransferf(GL_GREEN_BIAS, pixmapColor[1]);
-      glPixelTransferf(GL_BLUE_BIAS, pixmapColor[2]);
-      glPixelTransferf(GL_ALPHA_BIAS, 0.f);
-      glPixelTransferf(GL_RED_SCALE, 1.f);
-      glPixelTransferf(GL_GREEN_SCALE, 1.f);
-      glPixelTransferf(GL_BLUE_SCALE, 1.f);
-      glPixelTransferf(GL_ALPHA_SCALE, pixmapColor[3]);
+      __glcRenderPixmapColor(pixmapColor);
+    }
+  }
+}
+
+
+
+/* This internal function looks in the current fonts for a glyph of the
+ * character 'inCode' which GL object 'inGLObjectIndex' has already been built.
+ * If such a glyph is found, its informations are stored in 'outChar' and the
+ * function returns GL_TRUE. The kerning between the character and the
+ * previous one 'ioPrevCode' is then returned in 'outKerning'.
+ */
+static GLboolean __glcRenderLookupChar(__GLCcontext* inContext,
+				       const GLint inCode,
+				       __GLCcharacter* ioPrevCode,
+				       const GLboolean inIsRightToLeft,
+				       const GLuint inGLObjectIndex,
+				       __GLCcharacter* outChar,
+				       GLfloat* outKerning)
+{
+  FT_ListNode node = NULL;
+
+  for (node = inContext->currentFontList.head; node ; node = node->next) {
+    __GLCfont* font = (__GLCfont*)node->data;
+    __GLCglyph* glyph = __glcCharMapGetGlyph(font->charMap, inCode);
+
+    if (!glyph)
+      continue;
+
+    if (!glyph->glObject[inGLObjectIndex] && !glyph->isSpacingChar)
+      continue;
+
+    if (!glyph->isSpacingChar
+	&& (inContext->renderState.renderStyle == GLC_TEXTURE))
+      __glcTextureAtlasUseElement(glyph->textureObject, inContext);
+
+    outChar->glyph = glyph;
+    outChar->advance[0] = glyph->advance[0];
+    outChar->advance[1] = glyph->advance[1];
+
+    if (inContext->enableState.kerning) {
+      if (ioPrevCode->code && ioPrevCode->font == font) {
+	GLint leftCode = inIsRightToLeft ? inCode : ioPrevCode->code;
+	GLint rightCode = inIsRightToLeft ? ioPrevCode->code : inCode;
+
+	if (__glcFontGetKerning(font, leftCode, rightCode, outKerning,
+				inContext, GLC_POINT_SIZE, GLC_POINT_SIZE)) {
+	  if (inIsRightToLeft)
+	    outKerning[0] = -outKerning[0];
+	}
+      }
+    }
+
+    ioPrevCode->font = font;
+    ioPrevCode->code = inCode;
+
+    if (glyph->isSpacingChar)
+      outChar->code = 32;
+    else
+      outChar->code = inCode;
+
+    return GL_TRUE;
+  }
+
+  return GL_FALSE;
+}
+
+
+
+/* This internal function looks for the glyphes of the characters of the
+ * string 'inString' and stores their informations in 'outChars'. The string
+ * must be sorted in visual order and stored using UCS4 format. The function
+ * returns the number of characters that have been stored or -1 if the GL
+ * objects of one of the glyphes have not been built yet.
+ */
+static GLint __glcRenderResolveString(__GLCcontext* inContext,
+				      const GLCchar32* inString,
+				      const GLint inCount,
+				      const GLboolean inIsRightToLeft,
+				      __GLCcharacter* outChars)
+{
+  const GLCchar32* ptr = inString;
+  __GLCcharacter prevCode = {0, NULL, NULL, {0.f, 0.f}};
+  GLuint GLObjectIndex = inContext->renderState.renderStyle - 0x101;
+  GLint shift = 1;
+  GLint length = 0;
+  GLint i = 0;
+
+  if (inIsRightToLeft) {
+    ptr += inCount - 1;
+    shift = -1;
+  }
+
+  for (i = 0; i < inCount; i++, ptr += shift) {
+    GLfloat kerning[2] = {0.f, 0.f};
+
+    if (*ptr < 32)
+      continue;
+
+    if (!__glcRenderLookupChar(inContext, *ptr, &prevCode, inIsRightToLeft,
+			       GLObjectIndex, &outChars[length], kerning))
+      return -1;
+
+    if (length) {
+      outChars[length - 1].advance[0] += kerning[0];
+      outChars[length - 1].advance[1] += kerning[1];
     }
+    length++;
   }
 
+  return length;
+}
+
+
+
+/* This internal function renders the string 'inString' with the GL state
+ * that has been set by __glcRenderSetupGLState(). The string must be sorted
+ * in visual order and stored using UCS4 format. If GL objects are used,
+ * 'inChars' is a buffer that can store the informations of at least
+ * 'inCount' characters.
+ */
+static void __glcRenderGlyphs(__GLCcontext* inContext,
+			      const GLCchar32* inString,
+			      const GLboolean inIsRightToLeft,
+			      const GLint inCount, __GLCcharacter* inChars)
+{
+  GLint i = 0;
+  const GLCchar32* ptr = NULL;
+  __GLCcharacter prevCode = {0, NULL, NULL, {0.f, 0.f}};
+  GLint shift = 1;
+
+  /* The transformation may have changed since the last string */
+  inContext->isScaleCached = GL_FALSE;
+
   /* Render the string */
   ptr = inString;
   if (inIsRightToLeft) {
@@ -469,12 +954,11 @@ static void __glcRenderCountedString(__GLCcontext* inContext,
   if (inContext->enableState.glObjects
       && (inContext->renderState.renderStyle != GLC_BITMAP)
       && (inContext->renderState.renderStyle != GLC_PIXMAP_QSO)) {
-    __GLCfont* font = NULL;
     __GLCglyph* glyph = NULL;
     int length = 0;
     int j = 0;
     GLuint GLObjectIndex = inContext->renderState.renderStyle - 0x101;
-    FT_ListNode node = NULL;
+    GLboolean found = GL_FALSE;
     float resolution = inContext->renderState.resolution / 72.;
     GLfloat orientation = 1.f;
 
@@ -484,7 +968,7 @@ static void __glcRenderCountedString(__GLCcontext* inContext,
       GLfloat scaleX = GLC_POINT_SIZE;
       GLfloat scaleY = GLC_POINT_SIZE;
 
-      __glcGetScale(inContext, transformMatrix, &scaleX, &scaleY);
+      __glcRenderGetScale(inContext, transformMatrix, &scaleX, &scaleY);
 
       if ((fabs(scaleX) < GLC_EPSILON) || (fabs(scaleY) < GLC_EPSILON))
 	return;
@@ -497,74 +981,43 @@ static void __glcRenderCountedString(__GLCcontext* inContext,
 
     for (i = 0; i < inCount; i++) {
       if (*ptr >= 32) {
- 	for (node = inContext->currentFontList.head; node ; node = node->next) {
- 	  font = (__GLCfont*)node->data;
- 	  glyph = __glcCharMapGetGlyph(font->charMap, *ptr);
-
- 	  if (glyph) {
- 	    if (!glyph->glObject[GLObjectIndex] && !glyph->isSpacingChar)
- 	      continue;
-
-	    if (!glyph->isSpacingChar
-		&& (inContext->renderState.renderStyle == GLC_TEXTURE))
-	      FT_List_Up(&inContext->atlasList,
-			 (FT_ListNode)glyph->textureObject);
-
-	    chars[length].glyph = glyph;
-	    chars[length].advance[0] = glyph->advance[0];
-	    chars[length].advance[1] = glyph->advance[1];
-
- 	    if (inContext->enableState.kerning) {
- 	      if (prevCode.code && prevCode.font == font) {
- 		GLfloat kerning[2];
-		GLint leftCode = inIsRightToLeft ? *ptr : prevCode.code;
-		GLint rightCode = inIsRightToLeft ? prevCode.code : *ptr;
-
- 		if (__glcFontGetKerning(font, leftCode, rightCode, kerning,
- 					inContext, GLC_POINT_SIZE,
- 					GLC_POINT_SIZE)) {
-		  if (inIsRightToLeft)
-		    kerning[0] = -kerning[0];
-
-		  if (length) {
-		    chars[length - 1].advance[0] += kerning[0];
-		    chars[length - 1].advance[1] += kerning[1];
-		  }
-		  else
-		    glTranslatef(kerning[0], kerning[1], 0.f);
- 		}
- 	      }
- 	    }
-
-	    prevCode.font = font;
-	    prevCode.code = *ptr;
-
-	    if (glyph->isSpacingChar)
-	      chars[length].code = 32;
-	    else
-	      chars[length].code = *ptr;
-
- 	    length++;
- 	    break;
- 	  }
- 	}
+	GLfloat kerning[2] = {0.f, 0.f};
+
+	found = __glcRenderLookupChar(inContext, *ptr, &prevCode,
+				      inIsRightToLeft, GLObjectIndex,
+				      &inChars[length], kerning);
+	if (found) {
+	  if (length) {
+	    inChars[length - 1].advance[0] += kerning[0];
+	    inChars[length - 1].advance[1] += kerning[1];
+	  }
+	  else if ((kerning[0] != 0.f) || (kerning[1] != 0.f))
+	    __glcTranslate(inContext, kerning[0], kerning[1]);
+
+	  length++;
+	}
       }
 
-      if(!node || (i == inCount-1)) {
-	glScalef(resolution, resolution, 1.f);
+      if(!found || (i == inCount-1)) {
+	__glcScale(inContext, resolution);
+
+	/* The glyphes of the texture atlas are drawn all at once */
+	if ((inContext->renderState.renderStyle == GLC_TEXTURE)
+	    && GLEW_ARB_vertex_buffer_object) {
+	  __glcTextureAtlasDrawString(inContext, inChars, length, inIsRightToLeft);
+	  length = 0;
+	}
 
 	for (j = 0; j < length; j++) {
 	  if (inIsRightToLeft)
-	    glTranslatef(-chars[j].advance[0], chars[j].advance[1], 0.);
-	  if (chars[j].code != 32) {
-	    glyph = chars[j].glyph;
+	    __glcTranslate(inContext, -inChars[j].advance[0],
+			   inChars[j].advance[1]);
+	  if (inChars[j].code != 32) {
+	    glyph = inChars[j].glyph;
 
 	    switch(inContext->renderState.renderStyle) {
 	    case GLC_TEXTURE:
-	      if (GLEW_ARB_vertex_buffer_object)
-		glDrawArrays(GL_QUADS, glyph->textureObject->position * 4, 4);
-	      else
-		glCallList(glyph->glObject[1]);
+	      glCallList(glyph->glObject[1]);
 	      break;
 	    case GLC_LINE:
 	      if (GLEW_ARB_vertex_buffer_object) {
@@ -632,20 +1085,24 @@ static void __glcRenderCountedString(__GLCcontext* inContext,
 	    }
 	  }
 	  if (!inIsRightToLeft)
-	    glTranslatef(chars[j].advance[0], chars[j].advance[1], 0.);
+	    __glcTranslate(inContext, inChars[j].advance[0],
+			   inChars[j].advance[1]);
 	}
 
-	if (!node)
+	if (!found)
 	  __glcProcessChar(inContext, *ptr, &prevCode, inIsRightToLeft,
 			   __glcRenderChar, NULL);
 
-	glScalef(1./resolution, 1./resolution, 1.f);
+	__glcScale(inContext, 1./resolution);
 	length = 0;
       }
 
       ptr += shift;
     }
   }
+  else if ((inContext->renderState.renderStyle == GLC_PIXMAP_QSO)
+	   && inContext->enableState.compositePixmap)
+    __glcRenderCompositeString(inContext, inString, inIsRightToLeft, inCount);
   else {
     glNormal3f(0.f, 0.f, 1.f);
 
@@ -656,29 +1113,72 @@ static void __glcRenderCountedString(__GLCcontext* inContext,
       ptr += shift;
     }
   }
-
-  /* Restore the values of the GL state if needed */
-  __glcRestoreGLState(&GLState, inContext, GL_FALSE);
-
-  if ((inContext->renderState.renderStyle != GLC_BITMAP)
-      && (inContext->renderState.renderStyle != GLC_PIXMAP_QSO)
-      && inContext->enableState.glObjects)
-      __glcFree(chars);
-
-  if (listIndex)
-    inContext->enableState.glObjects = saveGLObjects;
 }
 
 
 
-/** \ingroup render
- *  This command renders the character that \e inCode is mapped to.
- *  \param inCode The character to render
- *  \sa glcRenderString()
- *  \sa glcRenderCountedString()
- *  \sa glcReplacementCode()
- *  \sa glcRenderStyle()
- *  \sa glcCallbackFunc()
+/* This internal function is used by both glcRenderString() and
+ * glcRenderCountedString(). The string 'inString' must be sorted in visual
+ * order and stored using UCS4 format.
+ */
+static void __glcRenderCountedString(__GLCcontext* inContext,
+				     const GLCchar32* inString,
+				     const GLboolean inIsRightToLeft,
+				     const GLint inCount)
+{
+  GLint listIndex = 0;
+  __GLCglState GLState;
+  GLboolean saveGLObjects = GL_FALSE;
+  __GLCcharacter* chars = NULL;
+
+  /* Disable the internal management of GL objects when the user is currently
+   * building a display list.
+   */
+  glGetIntegerv(GL_LIST_INDEX, &listIndex);
+  if (listIndex) {
+    saveGLObjects = inContext->enableState.glObjects;
+    inContext->enableState.glObjects = GL_FALSE;
+  }
+
+
+  /* Allocate a buffer to store the glyphes informations of the string to be
+   * rendered.
+   */
+  if (inContext->enableState.glObjects
+      && (inContext->renderState.renderStyle != GLC_BITMAP)
+      && (inContext->renderState.renderStyle != GLC_PIXMAP_QSO)) {
+    chars = (__GLCcharacter*)__glcMalloc(inCount * sizeof(__GLCcharacter));
+    if (!chars) {
+      __glcRaiseError(GLC_RESOURCE_ERROR);
+      if (listIndex)
+	inContext->enableState.glObjects = saveGLObjects;
+      return;
+    }
+  }
+
+  __glcRenderSetupGLState(inContext, &GLState);
+  __glcRenderGlyphs(inContext, inString, inIsRightToLeft, inCount, chars);
+
+  /* Restore the values of the GL state if needed */
+  __glcRestoreGLState(&GLState, inContext, GL_FALSE);
+
+  if (chars)
+    __glcFree(chars);
+
+  if (listIndex)
+    inContext->enableState.glObjects = saveGLObjects;
+}
+
+
+
+/** \ingroup render
+ *  This command renders the character that \e inCode is mapped to.
+ *  \param inCode The character to render
+ *  \sa glcRenderString()
+ *  \sa glcRenderCountedString()
+ *  \sa glcReplacementCode()
+ *  \sa glcRenderStyle()
+ *  \sa glcCallbackFunc()
  */
 void APIENTRY glcRenderChar(GLint inCode)
 {
@@ -795,6 +1295,284 @@ void APIENTRY glcRenderString(const GLCchar *inString)
 
 
 
+/* This internal function renders the string 'inString' of a batch of strings
+ * at the location 'inOrigin' and with the color 'inColor' (or the current
+ * color if 'inColor' is NULL). The modelview matrix is left unchanged. The
+ * string must be sorted in visual order and stored using UCS4 format and, if
+ * GL objects are used, 'inChars' must be able to store the informations of at
+ * least 'inCount' characters.
+ */
+static void __glcRenderStringAt(__GLCcontext* inContext,
+				const GLCchar32* inString,
+				const GLboolean inIsRightToLeft,
+				const GLint inCount, __GLCcharacter* inChars,
+				const GLfloat* inOrigin, const GLfloat* inColor)
+{
+  GLfloat modelview[16];
+  GLboolean isRasterStyle =
+    (inContext->renderState.renderStyle == GLC_BITMAP)
+    || (inContext->renderState.renderStyle == GLC_PIXMAP_QSO);
+
+  if (inColor)
+    glColor4fv(inColor);
+
+  if (isRasterStyle) {
+    glRasterPos2fv(inOrigin);
+    if (inColor && (inContext->renderState.renderStyle == GLC_PIXMAP_QSO))
+      __glcRenderPixmapColor(inColor);
+  }
+  else {
+    glPushMatrix();
+    memcpy(modelview, inContext->userModelview, 16 * sizeof(GLfloat));
+    __glcTranslate(inContext, inOrigin[0], inOrigin[1]);
+  }
+
+  __glcRenderGlyphs(inContext, inString, inIsRightToLeft, inCount, inChars);
+
+  if (!isRasterStyle) {
+    glPopMatrix();
+    memcpy(inContext->userModelview, modelview, 16 * sizeof(GLfloat));
+  }
+}
+
+
+
+/** \ingroup render
+ *  This command renders the \e inCount zero-terminated strings of the array
+ *  \e inStrings, each one at its own location. It is equivalent to the
+ *  following (pseudo) code but it is much faster since the GL state is saved,
+ *  set up and restored only once for the whole batch of strings :
+ *  \code
+ *  for (i = 0; i < inCount; i++) {
+ *    if (inColors)
+ *      glColor4fv(&inColors[4 * i]);
+ *    if ((style == GLC_BITMAP) || (style == GLC_PIXMAP_QSO))
+ *      glRasterPos2fv(&inOrigins[2 * i]);
+ *    else {
+ *      glPushMatrix();
+ *      glTranslatef(inOrigins[2 * i], inOrigins[2 * i + 1], 0.f);
+ *    }
+ *    glcRenderString(inStrings[i]);
+ *    if ((style != GLC_BITMAP) && (style != GLC_PIXMAP_QSO))
+ *      glPopMatrix();
+ *  }
+ *  \endcode
+ *  where \e style is the value of the variable \b GLC_RENDER_STYLE. Hence the
+ *  modelview matrix is left unchanged by this command whereas the raster
+ *  position is left at the end of the last string for the \b GLC_BITMAP and
+ *  the \b GLC_PIXMAP_QSO rendering styles.
+ *
+ *  Moreover, if the rendering style is \b GLC_TEXTURE and \b GLC_GL_OBJECTS
+ *  is enabled, the glyphes of all the strings are gathered and drawn with a
+ *  single GL call per texture of the atlas. The strings are hence not
+ *  necessarily drawn in the order of \e inStrings.
+ *
+ *  \e inOrigins is an array of 2 * \e inCount floating point numbers that
+ *  contains the origin (x, y) of each string in object coordinates.
+ *  \e inColors is either \b NULL or an array of 4 * \e inCount floating
+ *  point numbers that contains the color (red, green, blue, alpha) of each
+ *  string. If \e inColors is \b NULL, the strings are rendered with the
+ *  current color, otherwise the current color is restored when the command
+ *  returns.
+ *
+ *  The command raises \b GLC_PARAMETER_ERROR if \e inCount is less than zero
+ *  or if \e inCount is positive and either \e inStrings or \e inOrigins is
+ *  \b NULL. The elements of \e inStrings which are \b NULL are skipped.
+ *  \param inCount The number of strings to be rendered.
+ *  \param inStrings The array of the zero-terminated strings.
+ *  \param inOrigins The array of the origins of the strings.
+ *  \param inColors The array of the colors of the strings or \b NULL.
+ *  \sa glcRenderString()
+ */
+void APIENTRY glcRenderStringsQSO(GLint inCount, const GLCchar** inStrings,
+				  const GLfloat* inOrigins,
+				  const GLfloat* inColors)
+{
+  __GLCcontext *ctx = NULL;
+  GLint listIndex = 0;
+  GLboolean saveGLObjects = GL_FALSE;
+  __GLCglState GLState;
+  __GLCcharacter* chars = NULL;
+  GLint charsLength = 0;
+  GLint charsCount = 0;
+  __GLCatlasString* atlasStrings = NULL;
+  GLfloat currentColor[4];
+  GLboolean isRasterStyle = GL_FALSE;
+  GLboolean useGLObjects = GL_FALSE;
+  GLfloat resolution = 1.f;
+  GLint i = 0;
+
+  GLC_INIT_THREAD();
+
+  /* Check the parameters */
+  if ((inCount < 0) || (inCount && (!inStrings || !inOrigins))) {
+    __glcRaiseError(GLC_PARAMETER_ERROR);
+    return;
+  }
+
+  /* Check if the current thread owns a context state */
+  ctx = GLC_GET_CURRENT_CONTEXT();
+  if (!ctx) {
+    __glcRaiseError(GLC_STATE_ERROR);
+    return;
+  }
+
+  if (!inCount)
+    return;
+
+  /* Disable the internal management of GL objects when the user is currently
+   * building a display list.
+   */
+  glGetIntegerv(GL_LIST_INDEX, &listIndex);
+  if (listIndex) {
+    saveGLObjects = ctx->enableState.glObjects;
+    ctx->enableState.glObjects = GL_FALSE;
+  }
+
+  isRasterStyle = (ctx->renderState.renderStyle == GLC_BITMAP)
+    || (ctx->renderState.renderStyle == GLC_PIXMAP_QSO);
+  useGLObjects = ctx->enableState.glObjects && !isRasterStyle;
+
+  /* When the glyphes are stored in the texture atlas, the strings which
+   * glyphes have already been built are gathered and drawn all at once.
+   */
+  if (useGLObjects && (ctx->renderState.renderStyle == GLC_TEXTURE)
+      && GLEW_ARB_vertex_buffer_object) {
+    atlasStrings = (__GLCatlasString*)__glcMalloc(inCount
+						  * sizeof(__GLCatlasString));
+    if (atlasStrings) {
+      for (i = 0; i < inCount; i++)
+	atlasStrings[i].length = 0;
+    }
+    else
+      __glcRaiseError(GLC_RESOURCE_ERROR);
+    resolution = ctx->renderState.resolution / 72.;
+  }
+
+  if (inColors)
+    glGetFloatv(GL_CURRENT_COLOR, currentColor);
+
+  __glcRenderSetupGLState(ctx, &GLState);
+  ctx->isScaleCached = GL_FALSE;
+
+  for (i = 0; i < inCount; i++) {
+    GLCchar32* UinString = NULL;
+    GLboolean isRightToLeft = GL_FALSE;
+    GLint length = 0;
+
+    if (!inStrings[i])
+      continue;
+
+    /* Creates a Unicode string based on the current string type. The string
+     * is stored in the context buffer which is re-used for the next string.
+     */
+    UinString = __glcConvertToVisualUcs4(ctx, &isRightToLeft, &length,
+					 inStrings[i]);
+    if (!UinString)
+      break;
+
+    /* The buffer that stores the glyphes informations is shared by all the
+     * strings : it only grows when the characters of a string do not fit in
+     * the room that is left by the strings of the batch.
+     */
+    if (useGLObjects && (charsCount + length > charsLength)) {
+      __GLCcharacter* newChars =
+	(__GLCcharacter*)__glcRealloc(chars, (charsCount + length)
+				      * sizeof(__GLCcharacter));
+
+      if (!newChars) {
+	__glcRaiseError(GLC_RESOURCE_ERROR);
+	break;
+      }
+      chars = newChars;
+      charsLength = charsCount + length;
+    }
+
+    if (atlasStrings) {
+      GLint count = __glcRenderResolveString(ctx, UinString, length,
+					     isRightToLeft, chars + charsCount);
+
+      /* If some glyphes have not been built yet, the string is rendered on
+       * its own below.
+       */
+      if (count >= 0) {
+	atlasStrings[i].first = charsCount;
+	atlasStrings[i].length = count;
+	atlasStrings[i].isRightToLeft = isRightToLeft;
+	atlasStrings[i].origin[0] = inOrigins[2 * i] / resolution;
+	atlasStrings[i].origin[1] = inOrigins[2 * i + 1] / resolution;
+	atlasStrings[i].color = inColors ? &inColors[4 * i] : NULL;
+	charsCount += count;
+	continue;
+      }
+    }
+
+    __glcRenderStringAt(ctx, UinString, isRightToLeft, length,
+			chars + charsCount, &inOrigins[2 * i],
+			inColors ? &inColors[4 * i] : NULL);
+  }
+
+  if (atlasStrings) {
+    GLint j = 0;
+
+    /* The glyphes of the batch may have been evicted from the texture atlas by
+     * the strings that have been rendered on their own : the strings that
+     * use them are removed from the batch and rendered after it.
+     */
+    for (i = 0; i < inCount; i++) {
+      for (j = 0; j < atlasStrings[i].length; j++) {
+	const __GLCcharacter* character = &chars[atlasStrings[i].first + j];
+
+	if ((character->code != 32) && !character->glyph->textureObject) {
+	  atlasStrings[i].length = -1;
+	  break;
+	}
+      }
+    }
+
+    glPushMatrix();
+    glNormal3f(0.f, 0.f, 1.f / resolution);
+    __glcScale(ctx, resolution);
+    __glcTextureAtlasDrawStrings(ctx, chars, atlasStrings, inCount);
+    __glcScale(ctx, 1. / resolution);
+    glPopMatrix();
+
+    for (i = 0; i < inCount; i++) {
+      GLCchar32* UinString = NULL;
+      GLboolean isRightToLeft = GL_FALSE;
+      GLint length = 0;
+
+      if (atlasStrings[i].length >= 0)
+	continue;
+
+      UinString = __glcConvertToVisualUcs4(ctx, &isRightToLeft, &length,
+					   inStrings[i]);
+      if (!UinString)
+	break;
+
+      __glcRenderStringAt(ctx, UinString, isRightToLeft, length,
+			  chars + atlasStrings[i].first, &inOrigins[2 * i],
+			  inColors ? &inColors[4 * i] : NULL);
+    }
+
+    __glcFree(atlasStrings);
+  }
+
+  /* Restore the values of the GL state if needed */
+  __glcRestoreGLState(&GLState, ctx, GL_FALSE);
+
+  if (inColors)
+    glColor4fv(currentColor);
+
+  if (chars)
+    __glcFree(chars);
+
+  if (listIndex)
+    ctx->enableState.glObjects = saveGLObjects;
+}
+
+
+
 /** \ingroup render
  *  This command assigns the value \e inStyle to the variable
  *  \b GLC_RENDER_STYLE. Legal values for \e inStyle are defined in the table
@@ -893,6 +1671,33 @@ void APIENTRY glcReplacementCode(GLint inCode)
 
 
 
+/* This internal function discards the measurements that have been stored in
+ * the fonts and in the glyphes of the context. It is called when a parameter
+ * which changes the way the glyphes are loaded by FreeType is modified.
+ */
+static void __glcRenderResetMeasurements(__GLCcontext* inContext)
+{
+  FT_ListNode node = NULL;
+
+  for (node = inContext->fontList.head; node; node = node->next) {
+    __GLCfont* font = (__GLCfont*)node->data;
+    __GLCfaceDescriptor* faceDesc = font->faceDesc;
+    FT_ListNode glyphNode = NULL;
+
+    font->maxMetricCached = GL_FALSE;
+
+    for (glyphNode = faceDesc->glyphList.head; glyphNode;
+	 glyphNode = glyphNode->next) {
+      __GLCglyph* glyph = (__GLCglyph*)glyphNode->data;
+
+      glyph->advanceCached = GL_FALSE;
+      glyph->boundingBoxCached = GL_FALSE;
+    }
+  }
+}
+
+
+
 /** \ingroup render
  *  This command assigns the value \e inVal to the variable \b GLC_RESOLUTION.
  *  It is used to compute the size of characters in pixels from the size in
@@ -908,7 +1713,6 @@ void APIENTRY glcReplacementCode(GLint inCode)
 void APIENTRY glcResolution(GLfloat inVal)
 {
   __GLCcontext *ctx = NULL;
-  FT_ListNode node = NULL;
 
   GLC_INIT_THREAD();
 
@@ -929,21 +1733,7 @@ void APIENTRY glcResolution(GLfloat inVal)
   ctx->renderState.resolution = (inVal < GLC_EPSILON) ? 72. : inVal;
 
   /* Force the measurement caches to be updated */
-  for (node = ctx->fontList.head; node; node = node->next) {
-    __GLCfont* font = (__GLCfont*)node->data;
-    __GLCfaceDescriptor* faceDesc = font->faceDesc;
-    FT_ListNode glyphNode = NULL;
-
-    font->maxMetricCached = GL_FALSE;
-
-    for (glyphNode = faceDesc->glyphList.head; glyphNode;
-	 glyphNode = glyphNode->next) {
-      __GLCglyph* glyph = (__GLCglyph*)glyphNode->data;
-
-      glyph->advanceCached = GL_FALSE;
-      glyph->boundingBoxCached = GL_FALSE;
-    }
-  }
+  __glcRenderResetMeasurements(ctx);
 
   return;
 }
@@ -994,3 +1784,996 @@ void APIENTRY glcRenderParameterfQSO(GLenum inAttrib, GLfloat inVal)
   ctx->renderState.tolerance = inVal;
   return;
 }
+
+
+
+/** \ingroup render
+ *  This command assigns the value \b inVal to the integer variable identified
+ *  by \e inAttrib which must be chosen in the table below.
+ *
+ *  - \b GLC_TEXTURE_BUDGET_QSO specifies the maximum amount of texture memory,
+ *    in bytes, that the texture atlas may use. When the glyphes do not fit in
+ *    the first texture of the atlas, additional textures (or pages) are
+ *    created until the budget is reached. Beyond that point, the glyphes of
+ *    the page that has been the least recently used are replaced. The atlas
+ *    always uses at least one page whatever the budget is. This parameter is
+ *    only relevant for the \b GLC_TEXTURE rendering type when
+ *    \b GLC_GL_OBJECTS is enabled.
+ *  - \b GLC_BITMAP_CACHE_SIZE_QSO specifies the maximum amount of memory, in
+ *    bytes, that may be used to cache the bitmaps of the glyphes rendered with
+ *    the \b GLC_BITMAP and \b GLC_PIXMAP_QSO rendering types. When the cache is
+ *    full, the bitmaps that have been the least recently used are released. A
+ *    value of 0 disables the cache.
+ *  - \b GLC_HINTING_PROFILE_QSO selects the hinter that FreeType uses when the
+ *    glyphes are hinted (that is when \b GLC_HINTING_QSO or \b GLC_GL_OBJECTS
+ *    is enabled) :
+ *    - \b GLC_HINTING_NATIVE_QSO : the hinting instructions of the font are
+ *      executed. The auto-hinter is used for the fonts that have none.
+ *    - \b GLC_HINTING_LIGHT_AUTO_QSO : the auto-hinter only aligns the glyphes
+ *      vertically, which is faster and keeps the shapes of the glyphes closer
+ *      to their outlines.
+ *    - \b GLC_HINTING_FULL_AUTO_QSO : the auto-hinter aligns the glyphes in
+ *      both directions. This is the default value.
+ *    - \b GLC_HINTING_NONE_QSO : the glyphes are never hinted. This is the
+ *      fastest profile, which suits contexts that are mainly used to measure
+ *      strings.
+ *    .
+ *    The display lists and the textures that have already been created by
+ *    GLC are not affected : glcDeleteGLObjects() must be called so that they
+ *    are created again with the new profile.
+ *
+ *  The command raises a \b GLC_PARAMETER_ERROR if \e inVal is negative or,
+ *  for \b GLC_HINTING_PROFILE_QSO, if \e inVal is not one of the values
+ *  above.
+ *  \param inAttrib A symbolic constant indicating a GLC attribute.
+ *  \param inVal An integer to be assigned to the variable \e inAttrib.
+ *  \sa glcGeti() with argument GLC_TEXTURE_BUDGET_QSO
+ *  \sa glcGeti() with argument GLC_BITMAP_CACHE_SIZE_QSO
+ *  \sa glcGeti() with argument GLC_HINTING_PROFILE_QSO
+ *  \sa glcRenderParameterfQSO()
+ */
+void APIENTRY glcRenderParameteriQSO(GLenum inAttrib, GLint inVal)
+{
+  __GLCcontext *ctx = NULL;
+
+  GLC_INIT_THREAD();
+
+  /* Check if inAttrib has a legal value */
+  switch(inAttrib) {
+  case GLC_TEXTURE_BUDGET_QSO:
+  case GLC_BITMAP_CACHE_SIZE_QSO:
+    if (inVal < 0) {
+      __glcRaiseError(GLC_PARAMETER_ERROR);
+      return;
+    }
+    break;
+  case GLC_HINTING_PROFILE_QSO:
+    switch(inVal) {
+    case GLC_HINTING_NATIVE_QSO:
+    case GLC_HINTING_LIGHT_AUTO_QSO:
+    case GLC_HINTING_FULL_AUTO_QSO:
+    case GLC_HINTING_NONE_QSO:
+      break;
+    default:
+      __glcRaiseError(GLC_PARAMETER_ERROR);
+      return;
+    }
+    break;
+  default:
+    __glcRaiseError(GLC_PARAMETER_ERROR);
+    return;
+  }
+
+  /* Check if the current thread owns a current state */
+  ctx = GLC_GET_CURRENT_CONTEXT();
+  if (!ctx) {
+    __glcRaiseError(GLC_STATE_ERROR);
+    return;
+  }
+
+  switch(inAttrib) {
+  case GLC_TEXTURE_BUDGET_QSO:
+    /* Stores the budget. The pages that are already created are kept : the
+     * budget only prevents new pages from being created.
+     */
+    ctx->renderState.textureBudget = inVal;
+    break;
+  case GLC_BITMAP_CACHE_SIZE_QSO:
+    /* Stores the size and releases the bitmaps that no longer fit */
+    ctx->renderState.bitmapCacheSize = inVal;
+    __glcBitmapCacheTrim(ctx, inVal);
+    break;
+  case GLC_HINTING_PROFILE_QSO:
+    /* The cached outlines, bitmaps and metrics are looked up with the profile
+     * as part of their key : only the measurements stored in the glyphes need
+     * to be discarded.
+     */
+    if (ctx->renderState.hintingProfile != inVal) {
+      ctx->renderState.hintingProfile = inVal;
+      __glcRenderResetMeasurements(ctx);
+    }
+    break;
+  }
+  return;
+}
+
+
+
+/* This internal function returns the text object which ID is 'inTextObject'.
+ * It raises GLC_PARAMETER_ERROR if the text object does not exist.
+ */
+static __GLCtextObject* __glcRenderGetTextObject(__GLCcontext* inContext,
+						 const GLuint inTextObject)
+{
+  __GLCtextObject* textObject = NULL;
+
+  if (inContext->textObjects && inTextObject
+      && (inTextObject <= (GLuint)GLC_ARRAY_LENGTH(inContext->textObjects)))
+    textObject = ((__GLCtextObject**)GLC_ARRAY_DATA(inContext->textObjects))
+      [inTextObject - 1];
+
+  if (!textObject)
+    __glcRaiseError(GLC_PARAMETER_ERROR);
+
+  return textObject;
+}
+
+
+
+/* This internal function copies the quads of the glyphes 'inChars' to the VBO
+ * of the text object 'inTextObject' (GLC_TEXTURE rendering style). The
+ * glyphes are recorded in the text object so that it can be invalidated when
+ * one of them is evicted from the texture atlas.
+ */
+static GLboolean __glcRenderBuildTextStream(__GLCcontext* inContext,
+					    __GLCtextObject* inTextObject,
+					    const __GLCcharacter* inChars,
+					    const GLint inLength)
+{
+  __GLCarray* stream = __glcArrayCreate(20 * sizeof(GLfloat));
+  GLint i = 0;
+
+  if (!stream)
+    return GL_FALSE;
+
+  if (!__glcTextureAtlasBuildStream(inContext, inChars, inLength,
+				    inTextObject->isRightToLeft, stream,
+				    inTextObject->batches,
+				    inTextObject->advance)) {
+    __glcRaiseError(GLC_RESOURCE_ERROR);
+    __glcArrayDestroy(stream);
+    return GL_FALSE;
+  }
+
+  for (i = 0; i < inLength; i++) {
+    if (inChars[i].code == 32)
+      continue;
+
+    if (!__glcArrayAppend(inTextObject->glyphs, &inChars[i].glyph)) {
+      __glcArrayDestroy(stream);
+      return GL_FALSE;
+    }
+  }
+
+  if (GLC_ARRAY_LENGTH(stream)) {
+    if (!inTextObject->bufferObject[0]) {
+      glGenBuffersARB(1, &inTextObject->bufferObject[0]);
+      if (!inTextObject->bufferObject[0]) {
+	__glcRaiseError(GLC_RESOURCE_ERROR);
+	__glcArrayDestroy(stream);
+	return GL_FALSE;
+      }
+    }
+
+    glBindBufferARB(GL_ARRAY_BUFFER_ARB, inTextObject->bufferObject[0]);
+    glBufferDataARB(GL_ARRAY_BUFFER_ARB, GLC_ARRAY_SIZE(stream),
+		    GLC_ARRAY_DATA(stream), GL_STATIC_DRAW_ARB);
+  }
+
+  __glcArrayDestroy(stream);
+  return GL_TRUE;
+}
+
+
+
+/* This internal function merges the vertices and the indices of the glyphes
+ * 'inChars' in the VBOs of the text object 'inTextObject' (GLC_LINE and
+ * GLC_TRIANGLE rendering styles). The vertices are translated to the pen
+ * position of each glyph and the primitives are converted to GL_LINES or
+ * GL_TRIANGLES so that the whole string is drawn by a single call. The data
+ * of the glyphes are copied from the memory copies of their VBOs, so that the
+ * VBOs are not read back.
+ */
+static GLboolean __glcRenderBuildTextGeometry(__GLCcontext* inContext,
+					      __GLCtextObject* inTextObject,
+					      const __GLCcharacter* inChars,
+					      const GLint inLength)
+{
+  GLboolean isLine = (inContext->renderState.renderStyle == GLC_LINE);
+  GLfloat* vertices = NULL;
+  GLuint* indices = NULL;
+  GLint vertexCount = 0;
+  GLint indexCount = 0;
+  GLfloat pen[2] = {0.f, 0.f};
+  GLint i = 0;
+  GLint k = 0;
+
+  /* Compute the size of the merged data */
+  for (i = 0; i < inLength; i++) {
+    const __GLCglyph* glyph = inChars[i].glyph;
+
+    if (inChars[i].code == 32)
+      continue;
+
+    /* The memory copies of the VBOs may be missing if a memory allocation
+     * failed when the glyph has been built.
+     */
+    if (!glyph->vertices || (!isLine && !glyph->vertexIndices))
+      return GL_FALSE;
+
+    vertexCount += glyph->nVertex;
+
+    if (isLine) {
+      /* Each vertex of a contour is the origin of a segment */
+      indexCount += 2 * glyph->contours[glyph->nContour];
+      continue;
+    }
+
+    for (k = 0; k < glyph->nGeomBatch; k++) {
+      GLint length = glyph->geomBatches[k].length;
+
+      if (glyph->geomBatches[k].mode == GL_TRIANGLES)
+	indexCount += length;
+      else if (length > 2)
+	indexCount += (length - 2) * 3;
+    }
+  }
+
+  if (vertexCount) {
+    vertices = (GLfloat*)__glcMalloc(vertexCount * 2 * sizeof(GLfloat));
+    if (!vertices) {
+      __glcRaiseError(GLC_RESOURCE_ERROR);
+      return GL_FALSE;
+    }
+  }
+
+  if (indexCount) {
+    indices = (GLuint*)__glcMalloc(indexCount * sizeof(GLuint));
+    if (!indices) {
+      __glcRaiseError(GLC_RESOURCE_ERROR);
+      if (vertices)
+	__glcFree(vertices);
+      return GL_FALSE;
+    }
+  }
+
+  /* Merge the data of the glyphes */
+  vertexCount = 0;
+  indexCount = 0;
+
+  for (i = 0; i < inLength; i++) {
+    if (inTextObject->isRightToLeft) {
+      pen[0] -= inChars[i].advance[0];
+      pen[1] += inChars[i].advance[1];
+    }
+
+    if (inChars[i].code != 32) {
+      const __GLCglyph* glyph = inChars[i].glyph;
+      GLuint base = vertexCount;
+
+      for (k = 0; k < glyph->nVertex; k++) {
+	vertices[2 * vertexCount] = glyph->vertices[2 * k] + pen[0];
+	vertices[2 * vertexCount + 1] = glyph->vertices[2 * k + 1] + pen[1];
+	vertexCount++;
+      }
+
+      if (isLine) {
+	/* GL_LINE_LOOP contours are converted to GL_LINES */
+	for (k = 0; k < glyph->nContour; k++) {
+	  GLint first = glyph->contours[k];
+	  GLint last = glyph->contours[k + 1];
+	  GLint j = 0;
+
+	  for (j = first; j < last; j++) {
+	    indices[indexCount++] = base + j;
+	    indices[indexCount++] = base + ((j + 1 < last) ? j + 1 : first);
+	  }
+	}
+      }
+      else {
+	const GLuint* batchIndices = glyph->vertexIndices;
+
+	/* GL_TRIANGLE_STRIP and GL_TRIANGLE_FAN are converted to
+	 * GL_TRIANGLES.
+	 */
+	for (k = 0; k < glyph->nGeomBatch; k++) {
+	  GLint length = glyph->geomBatches[k].length;
+	  GLint j = 0;
+
+	  for (j = 0; j < length; j++) {
+	    switch(glyph->geomBatches[k].mode) {
+	    case GL_TRIANGLES:
+	      indices[indexCount++] = base + batchIndices[j];
+	      break;
+	    case GL_TRIANGLE_STRIP:
+	      if (j < 2)
+		break;
+	      indices[indexCount++] = base + batchIndices[(j & 1) ? j - 1 : j - 2];
+	      indices[indexCount++] = base + batchIndices[(j & 1) ? j - 2 : j - 1];
+	      indices[indexCount++] = base + batchIndices[j];
+	      break;
+	    case GL_TRIANGLE_FAN:
+	      if (j < 2)
+		break;
+	      indices[indexCount++] = base + batchIndices[0];
+	      indices[indexCount++] = base + batchIndices[j - 1];
+	      indices[indexCount++] = base + batchIndices[j];
+	      break;
+	    }
+	  }
+	  batchIndices += length;
+	}
+      }
+    }
+
+    if (!inTextObject->isRightToLeft) {
+      pen[0] += inChars[i].advance[0];
+      pen[1] += inChars[i].advance[1];
+    }
+  }
+
+  inTextObject->advance[0] = pen[0];
+  inTextObject->advance[1] = pen[1];
+  inTextObject->count = indexCount;
+
+  if (indexCount) {
+    if (!inTextObject->bufferObject[0]) {
+      glGenBuffersARB(2, inTextObject->bufferObject);
+      if (!inTextObject->bufferObject[0] || !inTextObject->bufferObject[1]) {
+	__glcRaiseError(GLC_RESOURCE_ERROR);
+	if (inTextObject->bufferObject[0])
+	  glDeleteBuffersARB(1, &inTextObject->bufferObject[0]);
+	if (inTextObject->bufferObject[1])
+	  glDeleteBuffersARB(1, &inTextObject->bufferObject[1]);
+	inTextObject->bufferObject[0] = 0;
+	inTextObject->bufferObject[1] = 0;
+	__glcFree(vertices);
+	__glcFree(indices);
+	return GL_FALSE;
+      }
+    }
+
+    glBindBufferARB(GL_ARRAY_BUFFER_ARB, inTextObject->bufferObject[0]);
+    glBufferDataARB(GL_ARRAY_BUFFER_ARB, vertexCount * 2 * sizeof(GLfloat),
+		    vertices, GL_STATIC_DRAW_ARB);
+    glBindBufferARB(GL_ELEMENT_ARRAY_BUFFER_ARB, inTextObject->bufferObject[1]);
+    glBufferDataARB(GL_ELEMENT_ARRAY_BUFFER_ARB, indexCount * sizeof(GLuint),
+		    indices, GL_STATIC_DRAW_ARB);
+  }
+
+  if (vertices)
+    __glcFree(vertices);
+  if (indices)
+    __glcFree(indices);
+
+  return GL_TRUE;
+}
+
+
+
+/* This internal function builds the GL objects of the glyph of the character
+ * 'inCode' for the current rendering style, without drawing it. It is called
+ * by __glcProcessChar() (see __glcRenderPrepareString()).
+ */
+static void* __glcRenderPrepareChar(const GLint inCode,
+			const GLint GLC_UNUSED_ARG(inPrevCode),
+			const GLboolean GLC_UNUSED_ARG(inIsRTL),
+			const __GLCfont* inFont, __GLCcontext* inContext,
+			const void* GLC_UNUSED_ARG(inData),
+			const GLboolean GLC_UNUSED_ARG(inMultipleChars))
+{
+  GLuint GLObjectIndex = inContext->renderState.renderStyle - 0x101;
+  GLfloat transformMatrix[16];
+  GLfloat scaleX = GLC_POINT_SIZE;
+  GLfloat scaleY = GLC_POINT_SIZE;
+  GLfloat advance[2] = {0., 0.};
+  __GLCglyph* glyph = NULL;
+
+  assert(inFont);
+
+  __glcRenderGetScale(inContext, transformMatrix, &scaleX, &scaleY);
+
+  if ((fabs(scaleX) < GLC_EPSILON) || (fabs(scaleY) < GLC_EPSILON))
+    return NULL;
+
+#ifndef GLC_FT_CACHE
+  if (!__glcFontOpen(inFont, inContext))
+    return NULL;
+#endif
+
+  /* The advance is cached in the glyph for __glcRenderLookupChar() */
+  if (__glcFontGetAdvance(inFont, inCode, advance, inContext, scaleX,
+			  scaleY)) {
+    glyph = __glcFontGetGlyph(inFont, inCode, inContext);
+
+    /* The glyphes of the string that are already stored in the texture atlas
+     * must not be evicted by the glyphes that are being stored.
+     */
+    if (glyph->isSpacingChar || glyph->glObject[GLObjectIndex]) {
+      if (!glyph->isSpacingChar
+	  && (inContext->renderState.renderStyle == GLC_TEXTURE))
+	__glcTextureAtlasUseElement(glyph->textureObject, inContext);
+    }
+    else if (__glcFontPrepareGlyph(inFont, inContext, scaleX, scaleY,
+				   glyph)) {
+      if (__glcFontOutlineEmpty(inFont))
+	glyph->isSpacingChar = GL_TRUE;
+      else if (inContext->renderState.renderStyle == GLC_TEXTURE)
+	__glcRenderCharTexture(inFont, inContext, scaleX, scaleY, glyph,
+			       GL_FALSE);
+      else
+	__glcRenderCharScalable(inFont, inContext, transformMatrix, scaleX,
+				scaleY, glyph, GL_FALSE);
+    }
+  }
+
+#ifndef GLC_FT_CACHE
+  __glcFontClose(inFont);
+#endif
+  return NULL;
+}
+
+
+
+/* This internal function builds the GL objects of the glyphes of the string
+ * 'inString' that have not been built yet. Nothing is drawn but the buffer
+ * objects that are bound must be restored by the caller. The string must be
+ * sorted in visual order and stored using UCS4 format.
+ */
+static void __glcRenderPrepareString(__GLCcontext* inContext,
+				     const GLCchar32* inString,
+				     const GLboolean inIsRightToLeft,
+				     const GLint inCount)
+{
+  __GLCcharacter prevCode = {0, NULL, NULL, {0.f, 0.f}};
+  const GLCchar32* ptr = inString;
+  GLint textureID = 0;
+  GLint shift = 1;
+  GLint i = 0;
+
+  /* The pages of the texture atlas are bound when the glyphes are stored */
+  if (inContext->renderState.renderStyle == GLC_TEXTURE) {
+    glGetIntegerv(GL_TEXTURE_BINDING_2D, &textureID);
+    inContext->atlasStamp++;
+  }
+
+  inContext->isScaleCached = GL_FALSE;
+
+  if (inIsRightToLeft) {
+    ptr += inCount - 1;
+    shift = -1;
+  }
+
+  for (i = 0; i < inCount; i++, ptr += shift) {
+    if (*ptr >= 32)
+      __glcProcessChar(inContext, *ptr, &prevCode, inIsRightToLeft,
+		       __glcRenderPrepareChar, NULL);
+  }
+
+  if (inContext->renderState.renderStyle == GLC_TEXTURE)
+    glBindTexture(GL_TEXTURE_2D, textureID);
+}
+
+
+
+/* This internal function compiles the text object 'inTextObject' for the
+ * current rendering style. Only the glyphes which GL objects are stored in
+ * VBOs can be merged : if the compilation is not possible, the text object is
+ * rendered as a regular string by glcCallTextObjectQSO().
+ */
+static void __glcRenderCompileTextObject(__GLCcontext* inContext,
+					 __GLCtextObject* inTextObject)
+{
+  __GLCcharacter* chars = NULL;
+  GLint length = 0;
+  GLint listIndex = 0;
+  GLint arrayBuffer = 0;
+  GLint elementBuffer = 0;
+  GLint renderStyle = inContext->renderState.renderStyle;
+  GLboolean compiled = GL_FALSE;
+
+  inTextObject->isValid = GL_TRUE;
+  inTextObject->isCompiled = GL_FALSE;
+  inTextObject->count = 0;
+  inTextObject->advance[0] = 0.f;
+  inTextObject->advance[1] = 0.f;
+  GLC_ARRAY_LENGTH(inTextObject->batches) = 0;
+  GLC_ARRAY_LENGTH(inTextObject->glyphs) = 0;
+
+  glGetIntegerv(GL_LIST_INDEX, &listIndex);
+  if (listIndex || !inContext->enableState.glObjects
+      || !GLEW_ARB_vertex_buffer_object
+      || ((renderStyle != GLC_TEXTURE) && (renderStyle != GLC_LINE)
+	  && (renderStyle != GLC_TRIANGLE))
+      || ((renderStyle == GLC_TRIANGLE) && inContext->enableState.extrude))
+    return;
+
+  if (!inTextObject->length)
+    return;
+
+  chars = (__GLCcharacter*)__glcMalloc(inTextObject->length
+				       * sizeof(__GLCcharacter));
+  if (!chars) {
+    __glcRaiseError(GLC_RESOURCE_ERROR);
+    return;
+  }
+
+  glGetIntegerv(GL_ARRAY_BUFFER_BINDING_ARB, &arrayBuffer);
+  glGetIntegerv(GL_ELEMENT_ARRAY_BUFFER_BINDING_ARB, &elementBuffer);
+
+  length = __glcRenderResolveString(inContext, inTextObject->string,
+				    inTextObject->length,
+				    inTextObject->isRightToLeft, chars);
+  if (length < 0) {
+    /* The GL objects of some glyphes have not been built yet : they are built
+     * without being drawn.
+     */
+    __glcRenderPrepareString(inContext, inTextObject->string,
+			     inTextObject->isRightToLeft, inTextObject->length);
+
+    length = __glcRenderResolveString(inContext, inTextObject->string,
+				      inTextObject->length,
+				      inTextObject->isRightToLeft, chars);
+  }
+
+  /* If some characters still have no glyph (for instance if they are
+   * rendered by the GLC_OP_glcUnmappedCode callback function), the string
+   * can not be compiled.
+   */
+  if (length >= 0) {
+    if (renderStyle == GLC_TEXTURE)
+      compiled = __glcRenderBuildTextStream(inContext, inTextObject, chars,
+					    length);
+    else
+      compiled = __glcRenderBuildTextGeometry(inContext, inTextObject, chars,
+					      length);
+  }
+
+  glBindBufferARB(GL_ARRAY_BUFFER_ARB, arrayBuffer);
+  glBindBufferARB(GL_ELEMENT_ARRAY_BUFFER_ARB, elementBuffer);
+
+  if (!compiled)
+    GLC_ARRAY_LENGTH(inTextObject->glyphs) = 0;
+
+  /* Fonts may have been appended to GLC_CURRENT_FONT_LIST while the glyphes
+   * were looked up (GLC_AUTO_FONT) : the layout that has just been computed
+   * already takes them into account.
+   */
+  inTextObject->isValid = GL_TRUE;
+  inTextObject->isCompiled = compiled;
+  __glcFree(chars);
+}
+
+
+
+/** \ingroup render
+ *  This command creates a new text object and returns its ID. A text object
+ *  stores the layout of a string that is compiled by glcCompileStringQSO() :
+ *  it can then be rendered by glcCallTextObjectQSO() much faster than the
+ *  string itself since the glyphes do not need to be looked up nor measured.
+ *
+ *  The command returns 0 if the text object could not be created.
+ *  \return The ID of the new text object.
+ *  \sa glcDeleteTextObjectQSO()
+ *  \sa glcCompileStringQSO()
+ *  \sa glcCallTextObjectQSO()
+ */
+GLuint APIENTRY glcGenTextObjectQSO(void)
+{
+  __GLCcontext *ctx = NULL;
+  __GLCtextObject* textObject = NULL;
+  __GLCtextObject** textObjects = NULL;
+  GLint i = 0;
+
+  GLC_INIT_THREAD();
+
+  /* Check if the current thread owns a context state */
+  ctx = GLC_GET_CURRENT_CONTEXT();
+  if (!ctx) {
+    __glcRaiseError(GLC_STATE_ERROR);
+    return 0;
+  }
+
+  if (!ctx->textObjects) {
+    ctx->textObjects = __glcArrayCreate(sizeof(__GLCtextObject*));
+    if (!ctx->textObjects)
+      return 0;
+  }
+
+  textObject = __glcTextObjectCreate();
+  if (!textObject)
+    return 0;
+
+  /* Look for the ID of a text object that has been deleted */
+  textObjects = (__GLCtextObject**)GLC_ARRAY_DATA(ctx->textObjects);
+  for (i = 0; i < GLC_ARRAY_LENGTH(ctx->textObjects); i++) {
+    if (!textObjects[i]) {
+      textObjects[i] = textObject;
+      return i + 1;
+    }
+  }
+
+  if (!__glcArrayAppend(ctx->textObjects, &textObject)) {
+    __glcTextObjectDestroy(textObject, ctx);
+    return 0;
+  }
+
+  return GLC_ARRAY_LENGTH(ctx->textObjects);
+}
+
+
+
+/** \ingroup render
+ *  This command deletes the text object identified by \e inTextObject and
+ *  the GL objects that have been built for it. Its ID can then be returned
+ *  by a subsequent call to glcGenTextObjectQSO().
+ *
+ *  The command raises \b GLC_PARAMETER_ERROR if \e inTextObject is not the ID
+ *  of a text object.
+ *  \param inTextObject The ID of the text object to be deleted.
+ *  \sa glcGenTextObjectQSO()
+ */
+void APIENTRY glcDeleteTextObjectQSO(GLuint inTextObject)
+{
+  __GLCcontext *ctx = NULL;
+  __GLCtextObject* textObject = NULL;
+
+  GLC_INIT_THREAD();
+
+  /* Check if the current thread owns a context state */
+  ctx = GLC_GET_CURRENT_CONTEXT();
+  if (!ctx) {
+    __glcRaiseError(GLC_STATE_ERROR);
+    return;
+  }
+
+  textObject = __glcRenderGetTextObject(ctx, inTextObject);
+  if (!textObject)
+    return;
+
+  __glcTextObjectDestroy(textObject, ctx);
+  ((__GLCtextObject**)GLC_ARRAY_DATA(ctx->textObjects))[inTextObject - 1] =
+    NULL;
+}
+
+
+
+/** \ingroup render
+ *  This command compiles the zero-terminated string \e inString in the text
+ *  object identified by \e inTextObject : the glyphes of the string are
+ *  looked up in the current fonts, measured and their GL objects are merged
+ *  in buffer objects, according to the current value of the variable
+ *  \b GLC_RENDER_STYLE. The previous content of the text object is replaced.
+ *
+ *  The text object is rendered by glcCallTextObjectQSO() with the rendering
+ *  style that was current when glcCompileStringQSO() was called. However the
+ *  layout is not frozen : the text object only stores the string and the GL
+ *  data that have been built from it. Whenever these data have to be built
+ *  again (see glcCallTextObjectQSO()) or if they could not be built, the
+ *  glyphes are looked up in the fonts that are current at that time and
+ *  measured with the current value of \b GLC_KERNING_QSO. The GL data of
+ *  every text object are built again when \b GLC_CURRENT_FONT_LIST, the face
+ *  or the character map of one of its fonts or \b GLC_KERNING_QSO are
+ *  modified, so that a text object is always laid out with the current fonts
+ *  and kerning.
+ *
+ *  The GL objects of the glyphes which have not been built yet are built
+ *  without being drawn : glcCompileStringQSO() does not draw anything.
+ *
+ *  The GL objects of the glyphes can be merged only if \b GLC_GL_OBJECTS is
+ *  enabled, if the rendering style is \b GLC_LINE, \b GLC_TEXTURE or
+ *  \b GLC_TRIANGLE (without extrusion) and if the GL driver supports vertex
+ *  buffer objects. Otherwise the text object simply stores the string which
+ *  is then rendered as by glcRenderString() each time glcCallTextObjectQSO()
+ *  is called.
+ *
+ *  The command raises \b GLC_PARAMETER_ERROR if \e inTextObject is not the ID
+ *  of a text object.
+ *  \param inTextObject The ID of the text object.
+ *  \param inString A zero-terminated string of characters.
+ *  \sa glcGenTextObjectQSO()
+ *  \sa glcCallTextObjectQSO()
+ *  \sa glcRenderString()
+ */
+void APIENTRY glcCompileStringQSO(GLuint inTextObject, const GLCchar* inString)
+{
+  __GLCcontext *ctx = NULL;
+  __GLCtextObject* textObject = NULL;
+  GLCchar32* UinString = NULL;
+  GLboolean isRightToLeft = GL_FALSE;
+  GLint length = 0;
+
+  GLC_INIT_THREAD();
+
+  /* Check if the current thread owns a context state */
+  ctx = GLC_GET_CURRENT_CONTEXT();
+  if (!ctx) {
+    __glcRaiseError(GLC_STATE_ERROR);
+    return;
+  }
+
+  textObject = __glcRenderGetTextObject(ctx, inTextObject);
+  if (!textObject)
+    return;
+
+  /* Creates a Unicode string based on the current string type. Basically,
+   * that means that inString is read in the current string format.
+   */
+  if (inString) {
+    UinString = __glcConvertToVisualUcs4(ctx, &isRightToLeft, &length,
+					 inString);
+    if (!UinString)
+      return;
+  }
+
+  if (!__glcTextObjectSetString(textObject, UinString, length, isRightToLeft))
+    return;
+
+  textObject->renderStyle = ctx->renderState.renderStyle;
+  __glcRenderCompileTextObject(ctx, textObject);
+}
+
+
+
+/** \ingroup render
+ *  This command renders the text object identified by \e inTextObject. The
+ *  rendering is equivalent to a call to glcRenderString() with the string
+ *  that has been compiled in the text object and the rendering style that
+ *  was current when glcCompileStringQSO() was called. When the GL objects of
+ *  the glyphes could be merged, the string is drawn with the layout computed
+ *  by glcCompileStringQSO() and with one call per page of the texture atlas
+ *  (\b GLC_TEXTURE) or a single call (\b GLC_LINE and \b GLC_TRIANGLE).
+ *  Otherwise the string is laid out with the current fonts and kerning each
+ *  time it is rendered.
+ *
+ *  If some glyphes of the text object have been evicted from the texture
+ *  atlas since the text object has been compiled, if glcDeleteGLObjects()
+ *  has been called or if the current fonts or the kerning have been modified,
+ *  the text object is compiled again, with the current fonts and kerning,
+ *  before being rendered.
+ *
+ *  The command raises \b GLC_PARAMETER_ERROR if \e inTextObject is not the ID
+ *  of a text object.
+ *  \param inTextObject The ID of the text object to be rendered.
+ *  \sa glcCompileStringQSO()
+ *  \sa glcRenderString()
+ */
+void APIENTRY glcCallTextObjectQSO(GLuint inTextObject)
+{
+  __GLCcontext *ctx = NULL;
+  __GLCtextObject* textObject = NULL;
+  __GLCglState GLState;
+  GLint renderStyle = 0;
+  GLboolean glObjects = GL_FALSE;
+  GLboolean extrude = GL_FALSE;
+  GLfloat resolution = 0.f;
+
+  GLC_INIT_THREAD();
+
+  /* Check if the current thread owns a context state */
+  ctx = GLC_GET_CURRENT_CONTEXT();
+  if (!ctx) {
+    __glcRaiseError(GLC_STATE_ERROR);
+    return;
+  }
+
+  textObject = __glcRenderGetTextObject(ctx, inTextObject);
+  if (!textObject || !textObject->length)
+    return;
+
+  /* The text object is rendered with the rendering style that was current
+   * when it has been compiled.
+   */
+  renderStyle = ctx->renderState.renderStyle;
+  ctx->renderState.renderStyle = textObject->renderStyle;
+
+  if (!textObject->isValid)
+    __glcRenderCompileTextObject(ctx, textObject);
+
+  if (!textObject->isCompiled) {
+    __glcRenderCountedString(ctx, textObject->string,
+			     textObject->isRightToLeft, textObject->length);
+    ctx->renderState.renderStyle = renderStyle;
+    return;
+  }
+
+  /* The GL state is set up as if the string was rendered with GL objects
+   * (without extrusion, since it is not supported by text objects).
+   */
+  glObjects = ctx->enableState.glObjects;
+  extrude = ctx->enableState.extrude;
+  ctx->enableState.glObjects = GL_TRUE;
+  ctx->enableState.extrude = GL_FALSE;
+
+  __glcRenderSetupGLState(ctx, &GLState);
+
+  resolution = ctx->renderState.resolution / 72.;
+  glNormal3f(0.f, 0.f, 1.f / resolution);
+  __glcScale(ctx, resolution);
+
+  if (textObject->renderStyle == GLC_TEXTURE) {
+    if (textObject->bufferObject[0]) {
+      __GLCatlasPage* pages =
+	(__GLCatlasPage*)GLC_ARRAY_DATA(ctx->atlasPages);
+      __GLCatlasBatch* batches =
+	(__GLCatlasBatch*)GLC_ARRAY_DATA(textObject->batches);
+      int i = 0;
+
+      glBindBufferARB(GL_ARRAY_BUFFER_ARB, textObject->bufferObject[0]);
+      glInterleavedArrays(GL_T2F_V3F, 0, NULL);
+      for (i = 0; i < GLC_ARRAY_LENGTH(textObject->batches); i++) {
+	glBindTexture(GL_TEXTURE_2D, pages[batches[i].page].id);
+	glDrawArrays(GL_QUADS, batches[i].start, batches[i].count);
+      }
+    }
+  }
+  else if (textObject->count) {
+    GLint elementBuffer = 0;
+
+    /* The binding of the element buffer is only saved for GLC_TRIANGLE */
+    if (textObject->renderStyle == GLC_LINE)
+      glGetIntegerv(GL_ELEMENT_ARRAY_BUFFER_BINDING_ARB, &elementBuffer);
+
+    glBindBufferARB(GL_ARRAY_BUFFER_ARB, textObject->bufferObject[0]);
+    glVertexPointer(2, GL_FLOAT, 0, NULL);
+    glBindBufferARB(GL_ELEMENT_ARRAY_BUFFER_ARB, textObject->bufferObject[1]);
+    glDrawElements((textObject->renderStyle == GLC_LINE) ? GL_LINES
+		   : GL_TRIANGLES, textObject->count, GL_UNSIGNED_INT, NULL);
+
+    if (textObject->renderStyle == GLC_LINE)
+      glBindBufferARB(GL_ELEMENT_ARRAY_BUFFER_ARB, elementBuffer);
+  }
+
+  /* Move the pen to the end of the string */
+  __glcTranslate(ctx, textObject->advance[0], textObject->advance[1]);
+  __glcScale(ctx, 1. / resolution);
+
+  /* Restore the values of the GL state if needed */
+  __glcRestoreGLState(&GLState, ctx, GL_FALSE);
+
+  ctx->enableState.glObjects = glObjects;
+  ctx->enableState.extrude = extrude;
+  ctx->renderState.renderStyle = renderStyle;
+}
+
+
+
+/** \ingroup render
+ *  This command renders the string \e inString in the memory buffer
+ *  \e outBuffer instead of the GL frame buffer. The command itself does not
+ *  issue any GL command. Notice however that, as required by the GLC specs,
+ *  glcContext() calls glGetString() : a GL context must be current to the
+ *  thread when the GLC context is made current, but it can be released
+ *  afterwards while the strings are rendered in memory buffers.
+ *
+ *  The string is rasterized by FreeType with anti-aliasing as for the
+ *  \b GLC_PIXMAP_QSO rendering style, whatever the value of
+ *  \b GLC_RENDER_STYLE is. The glyphes are transformed by the bitmap matrix,
+ *  their bitmaps are stored in the cache of the \b GLC_PIXMAP_QSO rendering
+ *  style (see \b GLC_BITMAP_CACHE_SIZE_QSO) and the current fonts, kerning and
+ *  string type are used just like in glcRenderString().
+ *
+ *  The buffer is made of \e inHeight rows of \e inWidth pixels. The row \e j
+ *  starts at \e outBuffer + \e j * \e inStride : as in GL, the first row is the
+ *  bottom row of the picture. A negative \e inStride can be given with a
+ *  pointer to the last row of the buffer in order to use a top-down buffer.
+ *  The origin of the string (the pen position on the base line) is located at
+ *  (\e inX, \e inY) in pixels from the bottom left corner of the buffer. The
+ *  glyphes are clipped to the buffer.
+ *
+ *  \e inFormat must be one of the following values :
+ *  - \b GL_ALPHA : each pixel is an 8 bits coverage. The coverage of each
+ *    glyph is combined with the content of the buffer.
+ *  - \b GL_RGBA : each pixel is made of 4 bytes. Each glyph is blended over
+ *    the buffer with the color \e inColor (4 floating point values in
+ *    [0, 1]), modulated by the coverage of the glyph. If \e inColor is
+ *    \b NULL, the glyphes are rendered in opaque black. \e inColor is ignored
+ *    with \b GL_ALPHA.
+ *
+ *  The command raises \b GLC_PARAMETER_ERROR if \e inFormat is not one of the
+ *  values above, if \e inWidth or \e inHeight is negative, if \e outBuffer is
+ *  \b NULL or if the absolute value of \e inStride is lower than the size of a
+ *  row.
+ *  \param inString A zero-terminated string of characters.
+ *  \param inX The horizontal location of the origin of the string.
+ *  \param inY The vertical location of the origin of the string.
+ *  \param inFormat The format of the pixels of the buffer.
+ *  \param inWidth The width of the buffer in pixels.
+ *  \param inHeight The height of the buffer in pixels.
+ *  \param inStride The number of bytes between two consecutive rows.
+ *  \param outBuffer The buffer in which the string is rendered.
+ *  \param inColor The color of the string (\b GL_RGBA only).
+ *  \sa glcRenderString()
+ *  \sa glcLoadMatrix()
+ */
+void APIENTRY glcRenderStringToBufferQSO(const GLCchar* inString,
+					 GLfloat inX, GLfloat inY,
+					 GLenum inFormat, GLint inWidth,
+					 GLint inHeight, GLint inStride,
+					 GLvoid* outBuffer,
+					 const GLfloat* inColor)
+{
+  __GLCcontext *ctx = NULL;
+  GLCchar32* UinString = NULL;
+  GLboolean isRightToLeft = GL_FALSE;
+  GLint length = 0;
+  GLint pixelSize = 0;
+  GLint renderStyle = 0;
+  GLuint color[4] = {0, 0, 0, 255};
+  __GLCcomposite composite;
+  int i = 0;
+
+  GLC_INIT_THREAD();
+
+  /* Check the parameters */
+  switch(inFormat) {
+  case GL_ALPHA:
+    pixelSize = 1;
+    break;
+  case GL_RGBA:
+    pixelSize = 4;
+    break;
+  default:
+    __glcRaiseError(GLC_PARAMETER_ERROR);
+    return;
+  }
+
+  if ((inWidth < 0) || (inHeight < 0) || !outBuffer
+      || (abs(inStride) < inWidth * pixelSize)) {
+    __glcRaiseError(GLC_PARAMETER_ERROR);
+    return;
+  }
+
+  /* Check if the current thread owns a context state */
+  ctx = GLC_GET_CURRENT_CONTEXT();
+  if (!ctx) {
+    __glcRaiseError(GLC_STATE_ERROR);
+    return;
+  }
+
+  /* If inString is NULL then there is no point in continuing */
+  if (!inString)
+    return;
+
+  /* Creates a Unicode string based on the current string type. Basically,
+   * that means that inString is read in the current string format.
+   */
+  UinString = __glcConvertToVisualUcs4(ctx, &isRightToLeft, &length, inString);
+  if (!UinString)
+    return;
+
+  if (inColor) {
+    for (i = 0; i < 4; i++) {
+      GLfloat value = inColor[i];
+
+      value = (value < 0.f) ? 0.f : ((value > 1.f) ? 1.f : value);
+      color[i] = (GLuint)(value * 255.f + 0.5f);
+    }
+  }
+
+  /* The glyphes are rasterized as for the GLC_PIXMAP_QSO rendering style
+   * which does not issue GL commands as long as the pixmaps are composited.
+   */
+  renderStyle = ctx->renderState.renderStyle;
+  ctx->renderState.renderStyle = GLC_PIXMAP_QSO;
+
+  composite.origin[0] = inX;
+  composite.origin[1] = inY;
+
+  if (__glcRenderCollectPixmaps(ctx, UinString, isRightToLeft, length,
+				&composite))
+    __glcRenderBlendPixmaps(ctx, inFormat, inWidth, inHeight, inStride,
+			    (GLubyte*)outBuffer, color);
+
+  ctx->renderState.renderStyle = renderStyle;
+}
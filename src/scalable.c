@@ -480,11 +480,14 @@ static void CALLBACK __glcCallbackError(GLenum GLC_UNUSED_ARG(inErrorCode))
  * contour is rendered as is and if the rendering type is GLC_TRIANGLE then the
  * contour defines a polygon that is tesselated in triangles by the GLU library
  * before being rendered.
+ * If 'inDraw' is GL_FALSE, the VBOs of the glyph are built but nothing is
+ * drawn : it is then required that GL objects are stored in VBOs.
  */
 void __glcRenderCharScalable(const __GLCfont* inFont,
 			     const __GLCcontext* inContext,
 			     GLfloat* inTransformMatrix, const GLfloat inScaleX,
-			     const GLfloat inScaleY, __GLCglyph* inGlyph)
+			     const GLfloat inScaleY, __GLCglyph* inGlyph,
+			     const GLboolean inDraw)
 {
   __GLCrendererData rendererData;
   GLfloat identityMatrix[16] = {1., 0., 0., 0., 0., 1., 0., 0., 0., 0.,
@@ -500,6 +503,9 @@ void __glcRenderCharScalable(const __GLCfont* inFont,
   rendererData.vertexIndices = inContext->vertexIndices;
   rendererData.geomBatches = inContext->geomBatches;
 
+  assert(inDraw
+	 || (inContext->enableState.glObjects && GLEW_ARB_vertex_buffer_object));
+
   if (inContext->enableState.extrude)
     orientation = -inTransformMatrix[11];
 
@@ -509,7 +515,7 @@ void __glcRenderCharScalable(const __GLCfont* inFont,
   if (!inContext->enableState.glObjects) {
     GLint viewport[4];
 
-    glGetIntegerv(GL_VIEWPORT, viewport);
+    __glcGetViewport(inContext, viewport);
     rendererData.halfWidth = viewport[2] * 0.5;
     rendererData.halfHeight = viewport[3] * 0.5;
     rendererData.transformMatrix = inTransformMatrix;
@@ -684,12 +690,42 @@ void __glcRenderCharScalable(const __GLCfont* inFont,
     gluDeleteTess(tess);
 
     if (inContext->enableState.glObjects && GLEW_ARB_vertex_buffer_object) {
+      /* The tesselator may have appended vertices to the vertex array : the
+       * VBO of the vertices is updated accordingly.
+       */
+      if ((GLuint)GLC_ARRAY_LENGTH(rendererData.vertexArray)
+	  > endContour[GLC_ARRAY_LENGTH(rendererData.endContour) - 1])
+	glBufferDataARB(GL_ARRAY_BUFFER_ARB,
+			GLC_ARRAY_SIZE(rendererData.vertexArray),
+			GLC_ARRAY_DATA(rendererData.vertexArray),
+			GL_STATIC_DRAW_ARB);
+
+      /* The vertices and the indices are kept in memory so that the glyph can
+       * be merged in a text object without reading its VBOs back.
+       */
+      inGlyph->nVertex = GLC_ARRAY_LENGTH(rendererData.vertexArray);
+      inGlyph->vertices =
+	(GLfloat*)__glcMalloc(GLC_ARRAY_SIZE(rendererData.vertexArray));
+      if (inGlyph->vertices)
+	memcpy(inGlyph->vertices, GLC_ARRAY_DATA(rendererData.vertexArray),
+	       GLC_ARRAY_SIZE(rendererData.vertexArray));
+
       inGlyph->nGeomBatch = GLC_ARRAY_LENGTH(rendererData.geomBatches);
       inGlyph->geomBatches =
 	(__GLCgeomBatch*)__glcMalloc(GLC_ARRAY_SIZE(rendererData.geomBatches));
+      inGlyph->vertexIndices =
+	(GLuint*)__glcMalloc(GLC_ARRAY_SIZE(rendererData.vertexIndices));
 
-      if (!inGlyph->geomBatches) {
+      if (!inGlyph->vertices || !inGlyph->geomBatches
+	  || !inGlyph->vertexIndices) {
 	__glcRaiseError(GLC_RESOURCE_ERROR);
+	if (inGlyph->geomBatches)
+	  __glcFree(inGlyph->geomBatches);
+	if (inGlyph->vertexIndices)
+	  __glcFree(inGlyph->vertexIndices);
+	inGlyph->nGeomBatch = 0;
+	inGlyph->geomBatches = NULL;
+	inGlyph->vertexIndices = NULL;
 	glDeleteBuffersARB(1, &inGlyph->glObject[2]);
 	inGlyph->glObject[2] = 0;
 	goto reset;
@@ -697,6 +733,9 @@ void __glcRenderCharScalable(const __GLCfont* inFont,
 
       memcpy(inGlyph->geomBatches, GLC_ARRAY_DATA(rendererData.geomBatches),
 	     GLC_ARRAY_SIZE(rendererData.geomBatches));
+      memcpy(inGlyph->vertexIndices,
+	     GLC_ARRAY_DATA(rendererData.vertexIndices),
+	     GLC_ARRAY_SIZE(rendererData.vertexIndices));
 
       glBufferDataARB(GL_ELEMENT_ARRAY_BUFFER_ARB,
 		      GLC_ARRAY_SIZE(rendererData.vertexIndices),
@@ -708,7 +747,7 @@ void __glcRenderCharScalable(const __GLCfont* inFont,
   /* Now that the tesselation is done, the actual rendering for GLC_TRIANGLE 
    * begins.
    */
-  if (inContext->renderState.renderStyle == GLC_TRIANGLE) {
+  if (inDraw && (inContext->renderState.renderStyle == GLC_TRIANGLE)) {
     int i = 0;
     __GLCgeomBatch* geomBatch =
       (__GLCgeomBatch*)GLC_ARRAY_DATA(rendererData.geomBatches);
@@ -877,7 +916,7 @@ void __glcRenderCharScalable(const __GLCfont* inFont,
       __glcFree(extrudeArray);
 
       /* Render the contour */
-      if (inContext->enableState.extrude) {
+      if (inDraw && inContext->enableState.extrude) {
 	glInterleavedArrays(GL_N3F_V3F, 0, NULL);
 
 	for (i = 0; i < GLC_ARRAY_LENGTH(rendererData.endContour)-1; i++)
@@ -889,7 +928,7 @@ void __glcRenderCharScalable(const __GLCfont* inFont,
     glNormal3f(0.f, 0.f, 1.f);
   }
 
-  if (inContext->renderState.renderStyle == GLC_LINE) {
+  if (inDraw && (inContext->renderState.renderStyle == GLC_LINE)) {
     /* For GLC_LINE, there is no need to tesselate. The vertices are contained
      * in an array so we use the OpenGL function glDrawArrays().
      */
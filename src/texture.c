@@ -41,32 +41,291 @@ void __glcReleaseAtlasElement(__GLCatlasElement* This,
 			      __GLCcontext* inContext)
 {
   FT_ListNode node = (FT_ListNode)This;
+  __GLCatlasPage* page = (__GLCatlasPage*)GLC_ARRAY_DATA(inContext->atlasPages)
+    + This->page;
 
   /* Put the atlas element at the tail of the list so that its position is used
    * as soon as possible.
    */
-  FT_List_Remove(&inContext->atlasList, node);
-  FT_List_Add(&inContext->atlasList, node);
+  FT_List_Remove(&page->areaList, node);
+  FT_List_Add(&page->areaList, node);
   This->glyph = NULL; /* The glyph will be destroyed so clear the pointer */
 }
 
 
 
-/* This function gets some room in the texture atlas for a new glyph 'inGlyph'.
- * Eventually it creates the texture atlas, if it does not exist yet.
+/* This function is called each time a glyph stored in the texture atlas is
+ * rendered : its area is moved to the head of the list of its page and the
+ * page is stamped as used by the current string.
  */
-static GLboolean __glcTextureAtlasGetPosition(__GLCcontext* inContext,
-					      __GLCglyph* inGlyph)
+void __glcTextureAtlasUseElement(__GLCatlasElement* This,
+				 __GLCcontext* inContext)
+{
+  __GLCatlasPage* page = (__GLCatlasPage*)GLC_ARRAY_DATA(inContext->atlasPages)
+    + This->page;
+
+  FT_List_Up(&page->areaList, (FT_ListNode)This);
+  page->lastUsed = inContext->atlasStamp;
+}
+
+
+
+/* This function releases the memory used by the texture atlas. The GL objects
+ * are not destroyed : the caller is responsible of it.
+ */
+void __glcTextureAtlasDestroy(__GLCcontext* inContext)
 {
+  if (inContext->atlasPages) {
+    __GLCatlasPage* pages =
+      (__GLCatlasPage*)GLC_ARRAY_DATA(inContext->atlasPages);
+    int i = 0;
+
+    for (i = 0; i < GLC_ARRAY_LENGTH(inContext->atlasPages); i++) {
+      FT_List_Finalize(&pages[i].areaList, NULL,
+		       &__glcCommonArea.memoryManager, NULL);
+      __glcArrayDestroy(pages[i].shelves);
+    }
+
+    __glcArrayDestroy(inContext->atlasPages);
+  }
+
+  if (inContext->atlasFreeSlots)
+    __glcArrayDestroy(inContext->atlasFreeSlots);
+
+  if (inContext->atlasVertices)
+    __glcArrayDestroy(inContext->atlasVertices);
+
+  if (inContext->atlasStream)
+    __glcArrayDestroy(inContext->atlasStream);
+
+  if (inContext->atlasBatches)
+    __glcArrayDestroy(inContext->atlasBatches);
+}
+
+
+
+/* This function looks for an area of the page 'inPage' that has been released
+ * by a destroyed glyph and which is large enough to store a glyph of
+ * inWidth x inHeight texels.
+ * The released areas are stored at the tail of the list of the page. Among
+ * them, the smallest area that fits is chosen.
+ */
+static __GLCatlasElement* __glcTextureAtlasGetReleasedArea(
+					__GLCatlasPage* inPage,
+					const GLint inWidth,
+					const GLint inHeight)
+{
+  FT_ListNode node = NULL;
+  __GLCatlasElement* bestNode = NULL;
+
+  for (node = inPage->areaList.tail; node; node = node->prev) {
+    __GLCatlasElement* atlasNode = (__GLCatlasElement*)node;
+
+    /* The released areas are all at the tail of the list */
+    if (atlasNode->glyph)
+      break;
+
+    if ((atlasNode->width < inWidth) || (atlasNode->height < inHeight))
+      continue;
+
+    if (!bestNode || (atlasNode->width * atlasNode->height
+		      < bestNode->width * bestNode->height))
+      bestNode = atlasNode;
+  }
+
+  if (bestNode)
+    FT_List_Up(&inPage->areaList, (FT_ListNode)bestNode);
+
+  return bestNode;
+}
+
+
+
+/* This function carves a new area of inWidth x inHeight texels out of the
+ * shelves of the page 'inPage'. The shelf which height fits best the glyph
+ * height is used ; a new shelf is created at the bottom of the page if the
+ * existing shelves are either full or too high for the glyph.
+ * The function returns GL_FALSE if a memory allocation failed and GL_TRUE
+ * otherwise. If there is no room left in the page, 'outNode' is NULL.
+ */
+static GLboolean __glcTextureAtlasGetNewArea(__GLCcontext* inContext,
+					     const int inPage,
+					     const GLint inWidth,
+					     const GLint inHeight,
+					     __GLCatlasElement** outNode)
+{
+  __GLCatlasPage* page = (__GLCatlasPage*)GLC_ARRAY_DATA(inContext->atlasPages)
+    + inPage;
+  __GLCatlasShelf* shelves = (__GLCatlasShelf*)GLC_ARRAY_DATA(page->shelves);
+  int length = GLC_ARRAY_LENGTH(page->shelves);
+  int bestShelf = -1;
+  int bottom = 0;
+  int i = 0;
   __GLCatlasElement* atlasNode = NULL;
 
-  /* Test if the atlas already exists. If not, create it. */
-  if (!inContext->atlas.id) {
-    int size = 1024; /* Initial try with a 1024x1024 texture */
+  *outNode = NULL;
+
+  for (i = 0; i < length; i++) {
+    if ((shelves[i].height < inHeight)
+	|| (shelves[i].fill + inWidth > inContext->atlas.width))
+      continue;
+
+    if ((bestShelf < 0) || (shelves[i].height < shelves[bestShelf].height))
+      bestShelf = i;
+  }
+
+  if (length)
+    bottom = shelves[length - 1].y + shelves[length - 1].height;
+
+  /* Create a new shelf if no shelf can store the glyph or if the glyph would
+   * waste more than half of the height of the best shelf.
+   */
+  if (((bestShelf < 0) || (shelves[bestShelf].height >= 2 * inHeight))
+      && (bottom + inHeight <= inContext->atlas.height)) {
+    __GLCatlasShelf shelf;
+
+    shelf.y = bottom;
+    shelf.height = inHeight;
+    shelf.fill = 0;
+
+    if (!__glcArrayAppend(page->shelves, &shelf))
+      return GL_FALSE;
+
+    /* The array may have been moved by __glcArrayAppend() */
+    shelves = (__GLCatlasShelf*)GLC_ARRAY_DATA(page->shelves);
+    bestShelf = length;
+  }
+
+  /* The page is full */
+  if (bestShelf < 0)
+    return GL_TRUE;
+
+  atlasNode = (__GLCatlasElement*)__glcMalloc(sizeof(__GLCatlasElement));
+  if (!atlasNode) {
+    __glcRaiseError(GLC_RESOURCE_ERROR);
+    return GL_FALSE;
+  }
+
+  /* Use the slot of the VBO of an area that has been destroyed, if any */
+  if (GLC_ARRAY_LENGTH(inContext->atlasFreeSlots)) {
+    GLC_ARRAY_LENGTH(inContext->atlasFreeSlots)--;
+    atlasNode->position = ((int*)GLC_ARRAY_DATA(inContext->atlasFreeSlots))
+      [GLC_ARRAY_LENGTH(inContext->atlasFreeSlots)];
+  }
+  else {
+    /* Some room is reserved for the new slot in the array of the free slots,
+     * so that __glcTextureAtlasEvict() can give it back without allocating
+     * memory. Since the array is empty at this stage, it is extended by
+     * appending an element to its full length.
+     */
+    if (inContext->atlasFreeSlots->allocated <= inContext->atlasCount) {
+      GLC_ARRAY_LENGTH(inContext->atlasFreeSlots) =
+	inContext->atlasFreeSlots->allocated;
+      if (!__glcArrayAppend(inContext->atlasFreeSlots,
+			    &inContext->atlasCount)) {
+	GLC_ARRAY_LENGTH(inContext->atlasFreeSlots) = 0;
+	__glcFree(atlasNode);
+	return GL_FALSE;
+      }
+      GLC_ARRAY_LENGTH(inContext->atlasFreeSlots) = 0;
+    }
+    atlasNode->position = inContext->atlasCount++;
+  }
+
+  atlasNode->node.data = atlasNode;
+  atlasNode->page = inPage;
+  atlasNode->x = shelves[bestShelf].fill;
+  atlasNode->y = shelves[bestShelf].y;
+  atlasNode->width = inWidth;
+  atlasNode->height = inHeight;
+  shelves[bestShelf].fill += inWidth;
+  FT_List_Insert(&page->areaList, (FT_ListNode)atlasNode);
+
+  *outNode = atlasNode;
+  return GL_TRUE;
+}
+
+
+
+/* This function is called when the texture memory budget is exhausted. It
+ * releases the least recently used area of the page 'inPage' which is large
+ * enough to store a glyph of inWidth x inHeight texels. If no such area exists
+ * then the whole page is flushed.
+ */
+static __GLCatlasElement* __glcTextureAtlasEvict(__GLCcontext* inContext,
+						 const int inPage,
+						 const GLint inWidth,
+						 const GLint inHeight)
+{
+  __GLCatlasPage* page = (__GLCatlasPage*)GLC_ARRAY_DATA(inContext->atlasPages)
+    + inPage;
+  FT_ListNode node = NULL;
+  __GLCatlasElement* atlasNode = NULL;
+
+  /* We get the glyph that has not been used for the longer time (that is the
+   * tail element of the list of the page) and which area is large enough.
+   */
+  for (node = page->areaList.tail; node; node = node->prev) {
+    atlasNode = (__GLCatlasElement*)node;
+
+    if ((atlasNode->width >= inWidth) && (atlasNode->height >= inHeight)) {
+      if (atlasNode->glyph) {
+	/* Release the texture area of the glyph */
+	__glcGlyphDestroyTexture(atlasNode->glyph, inContext);
+      }
+      /* Put the texture area at the head of the list otherwise we will use
+       * the same texture element over and over again each time that we need
+       * to release a texture area.
+       */
+      FT_List_Up(&page->areaList, node);
+      return atlasNode;
+    }
+  }
+
+  /* None of the areas is large enough : all the glyphes are removed from the
+   * page and its shelves are emptied. The slots of the VBO are given back.
+   */
+  node = page->areaList.head;
+  while (node) {
+    FT_ListNode next = node->next;
+
+    atlasNode = (__GLCatlasElement*)node;
+    if (atlasNode->glyph)
+      __glcGlyphDestroyTexture(atlasNode->glyph, inContext);
+    /* Some room has been reserved for the slot in the array of the free slots
+     * by __glcTextureAtlasGetNewArea() so that no memory is allocated here.
+     */
+    assert(GLC_ARRAY_LENGTH(inContext->atlasFreeSlots)
+	   < inContext->atlasFreeSlots->allocated);
+    __glcArrayAppend(inContext->atlasFreeSlots, &atlasNode->position);
+    __glcFree(atlasNode);
+    node = next;
+  }
+
+  page->areaList.head = NULL;
+  page->areaList.tail = NULL;
+  GLC_ARRAY_LENGTH(page->shelves) = 0;
+
+  return NULL;
+}
+
+
+
+/* This function creates a new page in the texture atlas. The size of the page
+ * is determined when the first page is created.
+ */
+static GLboolean __glcTextureAtlasCreatePage(__GLCcontext* inContext)
+{
+  int size = inContext->atlas.width;
+  GLint level = 0;
+  void * buffer = NULL;
+  __GLCatlasPage page;
+
+  if (!size) {
     int i = 0;
     GLint format = 0;
-    GLint level = 0;
-    void * buffer = NULL;
+
+    size = 1024; /* Initial try with a 1024x1024 texture */
 
     /* Not all gfx card are able to use 1024x1024 textures (especially old ones
      * like 3dfx's). Moreover, the texture memory may be scarce when our texture
@@ -92,134 +351,225 @@ static GLboolean __glcTextureAtlasGetPosition(__GLCcontext* inContext,
       __glcRaiseError(GLC_RESOURCE_ERROR);
       return GL_FALSE;
     }
+  }
 
-    buffer = __glcMalloc(size * size);
-    if (!buffer) {
-      __glcRaiseError(GLC_RESOURCE_ERROR);
-      return GL_FALSE;
-    }
-    memset(buffer, 0, size * size);
+  page.shelves = __glcArrayCreate(sizeof(__GLCatlasShelf));
+  if (!page.shelves)
+    return GL_FALSE;
 
-    /* Create the texture atlas structure. The texture is divided in small
-     * square areas of GLC_TEXTURE_SIZE x GLC_TEXTURE_SIZE, each of which will
-     * contain a different glyph.
-     * TODO: Allow the user to change GLC_TEXTURE_SIZE rather than using a fixed
-     * value.
-     */
-    glGenTextures(1, &inContext->atlas.id);
-    inContext->atlas.width = size;
-    inContext->atlas.height = size;
-    inContext->atlasWidth = size / GLC_TEXTURE_SIZE;
-    inContext->atlasHeight = size / GLC_TEXTURE_SIZE;
-    inContext->atlasCount = 0;
-    glBindTexture(GL_TEXTURE_2D, inContext->atlas.id);
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_ALPHA8, size,
+  page.areaList.head = NULL;
+  page.areaList.tail = NULL;
+  page.lastUsed = inContext->atlasStamp;
+  page.id = 0;
+
+  if (!__glcArrayAppend(inContext->atlasPages, &page)) {
+    __glcArrayDestroy(page.shelves);
+    return GL_FALSE;
+  }
+
+  buffer = __glcMalloc(size * size);
+  if (!buffer) {
+    __glcRaiseError(GLC_RESOURCE_ERROR);
+    __glcArrayDestroy(page.shelves);
+    GLC_ARRAY_LENGTH(inContext->atlasPages)--;
+    return GL_FALSE;
+  }
+  memset(buffer, 0, size * size);
+
+  /* Create the texture of the page. The texture is divided in shelves
+   * which are filled with areas which size matches the size of the glyphes.
+   */
+  glGenTextures(1, &page.id);
+  ((__GLCatlasPage*)GLC_ARRAY_DATA(inContext->atlasPages))
+    [GLC_ARRAY_LENGTH(inContext->atlasPages) - 1].id = page.id;
+  inContext->atlas.width = size;
+  inContext->atlas.height = size;
+  glBindTexture(GL_TEXTURE_2D, page.id);
+  glTexImage2D(GL_TEXTURE_2D, 0, GL_ALPHA8, size,
+	       size, 0, GL_ALPHA, GL_UNSIGNED_BYTE, buffer);
+
+  /* Create the mipmap structure of the texture atlas, no matter if GLC_MIPMAP
+   * is enabled or not.
+   */
+  while (size > 1) {
+    size >>= 1;
+    level++;
+    glTexImage2D(GL_TEXTURE_2D, level, GL_ALPHA8, size,
 		 size, 0, GL_ALPHA, GL_UNSIGNED_BYTE, buffer);
+  }
 
-    /* Create the mipmap structure of the texture atlas, no matter if GLC_MIPMAP
-     * is enabled or not.
-     */
-    while (size > 1) {
-      size >>= 1;
-      level++;
-      glTexImage2D(GL_TEXTURE_2D, level, GL_ALPHA8, size,
-		   size, 0, GL_ALPHA, GL_UNSIGNED_BYTE, buffer);
-    }
+  /* Use trilinear filtering if GLC_MIPMAP is enabled.
+   * Otherwise use bilinear filtering.
+   */
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER,
+		  GL_LINEAR_MIPMAP_LINEAR);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP);
 
-    /* Use trilinear filtering if GLC_MIPMAP is enabled.
-     * Otherwise use bilinear filtering.
-     */
+  /* The intent of this code is to work around an ugly bug of the Intel GMA
+   * 965 (or X3000) drivers on Linux. On those crappy drivers a 2nd call to
+   * glTexSubImage2D() completely clears the texture removing by the way the
+   * first character stored in the texture...
+   * This workaround displays a dummy character in order to deceive the
+   * stupid drivers. Note that I tried to reduce the code to the minimum : it
+   * seems that if any line below is removed, the workaround no longer works
+   * around the f***ing bug.
+   */
+  size = GLC_TEXTURE_SIZE;
+  glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, size, size, GL_ALPHA,
+		  GL_UNSIGNED_BYTE, buffer);
+  level = 0;
+  while (size > 2) {
+    size >>= 1;
+    level++;
+    glTexSubImage2D(GL_TEXTURE_2D, level, 0, 0, size, size, GL_ALPHA,
+		    GL_UNSIGNED_BYTE, buffer);
+  }
+
+  /* Since the glyphes are packed in the atlas, only the mipmap levels that
+   * do not mix neighbouring glyphes can be used.
+   */
+  if (GLEW_VERSION_1_2 || GLEW_SGIS_texture_lod)
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, GLC_ATLAS_MAX_LEVEL);
+
+  glBegin(GL_QUADS);
+  glNormal3f(0.f, 0.f, 1.f);
+  glTexCoord2f(0.f, 0.f);
+  glVertex2f(0.f, 0.f);
+  glTexCoord2f(0.f, 1.f);
+  glVertex2f(0.f, .5f);
+  glTexCoord2f(1.f, 1.f);
+  glVertex2f(.5f, .5f);
+  glTexCoord2f(1.f, 0.f);
+  glVertex2f(.5f, 0.f);
+  glEnd();
+  /* End of the workaround for the crappy open source drivers for Intel chips
+   */
+  __glcFree(buffer);
+
+  if (inContext->enableState.mipmap)
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER,
 		    GL_LINEAR_MIPMAP_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP);
-
-    /* The intent of this code is to work around an ugly bug of the Intel GMA
-     * 965 (or X3000) drivers on Linux. On those crappy drivers a 2nd call to
-     * glTexSubImage2D() completely clears the texture removing by the way the
-     * first character stored in the texture...
-     * This workaround displays a dummy character in order to deceive the
-     * stupid drivers. Note that I tried to reduce the code to the minimum : it
-     * seems that if any line below is removed, the workaround no longer works
-     * around the f***ing bug.
-     */
-    size = GLC_TEXTURE_SIZE;
-    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, size, size, GL_ALPHA,
-		    GL_UNSIGNED_BYTE, buffer);
-    level = 0;
-    while (size > 2) {
-      size >>= 1;
-      level++;
-      glTexSubImage2D(GL_TEXTURE_2D, level, 0, 0, size, size, GL_ALPHA,
-		      GL_UNSIGNED_BYTE, buffer);
-    }
+  else
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER,
+		    GL_LINEAR);
 
-    if (GLEW_VERSION_1_2 || GLEW_SGIS_texture_lod)
-      glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, level - 1);
-
-    glBegin(GL_QUADS);
-    glNormal3f(0.f, 0.f, 1.f);
-    glTexCoord2f(0.f, 0.f);
-    glVertex2f(0.f, 0.f);
-    glTexCoord2f(0.f, 1.f);
-    glVertex2f(0.f, .5f);
-    glTexCoord2f(1.f, 1.f);
-    glVertex2f(.5f, .5f);
-    glTexCoord2f(1.f, 0.f);
-    glVertex2f(.5f, 0.f);
-    glEnd();
-    /* End of the workaround for the crappy open source drivers for Intel chips
-     */
-    __glcFree(buffer);
+  return GL_TRUE;
+}
+
+
+
+/* This function gets some room in the texture atlas for a new glyph 'inGlyph'
+ * which bitmap is inWidth x inHeight texels large. The texture of the page
+ * where the glyph is stored is bound to GL_TEXTURE_2D.
+ * New pages are added to the atlas as long as the texture memory budget
+ * (GLC_TEXTURE_BUDGET_QSO) is not exhausted. Once it is, areas are released
+ * in the least recently used page.
+ */
+static GLboolean __glcTextureAtlasGetPosition(__GLCcontext* inContext,
+					      __GLCglyph* inGlyph,
+					      const GLint inWidth,
+					      const GLint inHeight)
+{
+  __GLCatlasElement* atlasNode = NULL;
+  __GLCatlasPage* pages = NULL;
+  int pageCount = 0;
+  int i = 0;
+
+  /* Test if the atlas already exists. If not, create it. */
+  if (!inContext->atlasPages) {
+    inContext->atlasPages = __glcArrayCreate(sizeof(__GLCatlasPage));
+    if (!inContext->atlasPages)
+      return GL_FALSE;
+  }
+
+  if (!inContext->atlasFreeSlots) {
+    inContext->atlasFreeSlots = __glcArrayCreate(sizeof(int));
+    if (!inContext->atlasFreeSlots)
+      return GL_FALSE;
+  }
+
+  if (!inContext->atlasVertices) {
+    inContext->atlasVertices = __glcArrayCreate(20 * sizeof(GLfloat));
+    if (!inContext->atlasVertices)
+      return GL_FALSE;
+  }
+
+  if (!inContext->atlasStream) {
+    inContext->atlasStream = __glcArrayCreate(20 * sizeof(GLfloat));
+    if (!inContext->atlasStream)
+      return GL_FALSE;
+  }
+
+  if (!inContext->atlasBatches) {
+    inContext->atlasBatches = __glcArrayCreate(sizeof(__GLCatlasBatch));
+    if (!inContext->atlasBatches)
+      return GL_FALSE;
+  }
 
-    if (inContext->enableState.mipmap)
-      glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER,
-		      GL_LINEAR_MIPMAP_LINEAR);
-    else
-      glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER,
-		      GL_LINEAR);
+  if (!GLC_ARRAY_LENGTH(inContext->atlasPages)) {
+    if (!__glcTextureAtlasCreatePage(inContext))
+      return GL_FALSE;
   }
 
   /* At this stage, we want to get a free area in the texture atlas in order to
-   * store a new glyph. Two situations may occur : the atlas is full or not
+   * store a new glyph. We first try to re-use an area that has been released,
+   * then to get some room from the shelves of the existing pages.
    */
-  if (inContext->atlasCount == inContext->atlasWidth * inContext->atlasHeight) {
-    /* The texture atlas is full. We must release an area to re-use it.
-     * We get the glyph that has not been used for the longer time (that is the
-     * tail element of atlasList).
-     */
-    atlasNode = (__GLCatlasElement*)inContext->atlasList.tail;
-    assert(atlasNode);
+  pages = (__GLCatlasPage*)GLC_ARRAY_DATA(inContext->atlasPages);
+  pageCount = GLC_ARRAY_LENGTH(inContext->atlasPages);
 
-    if (atlasNode->glyph) {
-      /* Release the texture area of the glyph */
-      __glcGlyphDestroyTexture(atlasNode->glyph, inContext);
+  for (i = 0; (i < pageCount) && !atlasNode; i++)
+    atlasNode = __glcTextureAtlasGetReleasedArea(pages + i, inWidth, inHeight);
+
+  for (i = 0; (i < pageCount) && !atlasNode; i++) {
+    if (!__glcTextureAtlasGetNewArea(inContext, i, inWidth, inHeight,
+				     &atlasNode))
+      return GL_FALSE;
+  }
+
+  /* All the pages are full : create a new page if the budget allows it */
+  if (!atlasNode && ((pageCount + 1) * GLC_ATLAS_PAGE_MEMORY(inContext)
+		     <= inContext->renderState.textureBudget)) {
+    /* If the page can not be created, the existing pages are used */
+    if (__glcTextureAtlasCreatePage(inContext)) {
+      if (!__glcTextureAtlasGetNewArea(inContext, pageCount, inWidth,
+				       inHeight, &atlasNode))
+	return GL_FALSE;
     }
-    /* Put the texture area at the head of the list otherwise we will use the
-     * same texture element over and over again each time that we need to
-     * release a texture area.
-     */
-    FT_List_Up(&inContext->atlasList, (FT_ListNode)atlasNode);
+
+    pages = (__GLCatlasPage*)GLC_ARRAY_DATA(inContext->atlasPages);
+    pageCount = GLC_ARRAY_LENGTH(inContext->atlasPages);
   }
-  else {
-    /* The texture atlas is not full. We create a new texture area and we store
-     * its definition in atlas list.
-     */
-    atlasNode = (__GLCatlasElement*)__glcMalloc(sizeof(__GLCatlasElement));
-    if (!atlasNode) {
-      __glcRaiseError(GLC_RESOURCE_ERROR);
-      return GL_FALSE;
+
+  /* The texture memory budget is exhausted : an area is released in the page
+   * that has not been used for the longest time.
+   */
+  if (!atlasNode) {
+    int lruPage = 0;
+
+    for (i = 1; i < pageCount; i++) {
+      if (pages[i].lastUsed < pages[lruPage].lastUsed)
+	lruPage = i;
     }
 
-    atlasNode->node.data = atlasNode;
-    atlasNode->position = inContext->atlasCount++;
-    FT_List_Insert(&inContext->atlasList, (FT_ListNode)atlasNode);
+    atlasNode = __glcTextureAtlasEvict(inContext, lruPage, inWidth, inHeight);
+
+    /* If the page has been flushed, there is necessarily some room left */
+    if (!atlasNode) {
+      if (!__glcTextureAtlasGetNewArea(inContext, lruPage, inWidth, inHeight,
+				       &atlasNode))
+	return GL_FALSE;
+      assert(atlasNode);
+    }
   }
 
   /* Update the texture element */
   atlasNode->glyph = inGlyph;
   inGlyph->textureObject = atlasNode;
+  pages[atlasNode->page].lastUsed = inContext->atlasStamp;
+  glBindTexture(GL_TEXTURE_2D, pages[atlasNode->page].id);
 
   if (GLEW_ARB_vertex_buffer_object) {
     /* Create a VBO, if none exists yet */
@@ -334,38 +684,381 @@ static GLboolean __glcTextureGetImmediate(__GLCcontext* inContext,
 
 
 
+/* This function uploads the vertex stream of the string being rendered to the
+ * VBO of the texture atlas and returns the offset (in bytes) of the stream in
+ * the VBO.
+ * Here the GL command glBufferSubData() is used unless GLC_BUFFER_SUB_DATA_QSO
+ * is disabled, since it seems to be buggy on some GL drivers (the DRI Intel
+ * specifically). In such a case, the VBO is re-allocated for each upload.
+ * Otherwise the streams are appended one after the other to the VBO so that
+ * the upload does not overwrite the quads that the GPU may still be reading
+ * for the previous strings. When the VBO is full, its storage is orphaned by
+ * glBufferData() : the driver then gives the VBO a new storage and the upload
+ * restarts from its beginning without waiting for the GPU.
+ */
+static GLintptrARB __glcTextureAtlasUploadStream(__GLCcontext* inContext)
+{
+  __GLCarray* stream = inContext->atlasStream;
+  int offset = 0;
+
+  glBindBufferARB(GL_ARRAY_BUFFER_ARB, inContext->atlas.bufferObjectID);
+
+  if (!inContext->enableState.bufferSubData) {
+    glBufferDataARB(GL_ARRAY_BUFFER_ARB, GLC_ARRAY_SIZE(stream),
+		    GLC_ARRAY_DATA(stream), GL_STREAM_DRAW_ARB);
+    inContext->atlasBufferCount = GLC_ARRAY_LENGTH(stream);
+    inContext->atlasBufferOffset = 0;
+    return 0;
+  }
+
+  if (inContext->atlasBufferCount < GLC_ARRAY_LENGTH(stream)) {
+    /* The VBO is too small : its size is extended to the room allocated for
+     * the stream so that it is not re-allocated for each string.
+     */
+    inContext->atlasBufferCount = stream->allocated;
+    inContext->atlasBufferOffset = inContext->atlasBufferCount;
+  }
+
+  if (inContext->atlasBufferOffset + GLC_ARRAY_LENGTH(stream)
+      > inContext->atlasBufferCount) {
+    glBufferDataARB(GL_ARRAY_BUFFER_ARB,
+		    inContext->atlasBufferCount * stream->elementSize, NULL,
+		    GL_STREAM_DRAW_ARB);
+    inContext->atlasBufferOffset = 0;
+  }
+
+  offset = inContext->atlasBufferOffset;
+  glBufferSubDataARB(GL_ARRAY_BUFFER_ARB,
+		     (GLintptrARB)offset * stream->elementSize,
+		     GLC_ARRAY_SIZE(stream), GLC_ARRAY_DATA(stream));
+  inContext->atlasBufferOffset += GLC_ARRAY_LENGTH(stream);
+
+  return (GLintptrARB)offset * stream->elementSize;
+}
+
+
+
+/* This function appends to the vertex stream 'inStream' the quads of the
+ * glyphes 'inChars' of a string which lie in the page 'inPage' of the texture
+ * atlas. The quads are translated to the pen position of each glyph (the
+ * advances and the kerning are thus baked in the vertices), the pen starting
+ * at 'inOrigin'. The pen position at the end of the string, relatively to its
+ * origin, is returned in 'outPen'.
+ * The function returns the index of the next page used by the string or -1 if
+ * there is none. If a memory allocation failed, 'outFailed' is set to GL_TRUE
+ * and some quads may be missing from the stream.
+ */
+static int __glcTextureAtlasBuildPage(__GLCcontext* inContext,
+				      const __GLCcharacter* inChars,
+				      const int inLength,
+				      const GLboolean inIsRightToLeft,
+				      const GLfloat* inOrigin, const int inPage,
+				      __GLCarray* inStream, GLfloat* outPen,
+				      GLboolean* outFailed)
+{
+  int nextPage = -1;
+  int i = 0;
+
+  outPen[0] = 0.f;
+  outPen[1] = 0.f;
+
+  for (i = 0; i < inLength; i++) {
+    const __GLCatlasElement* atlasNode = inChars[i].glyph->textureObject;
+
+    if (inIsRightToLeft) {
+      outPen[0] -= inChars[i].advance[0];
+      outPen[1] += inChars[i].advance[1];
+    }
+
+    if (inChars[i].code != 32) {
+      if (atlasNode->page == inPage) {
+	GLfloat* quad = (GLfloat*)__glcArrayInsertCell(inStream,
+						       GLC_ARRAY_LENGTH(inStream),
+						       1);
+	int k = 0;
+
+	if (quad) {
+	  memcpy(quad, GLC_ARRAY_DATA(inContext->atlasVertices)
+		 + atlasNode->position * inStream->elementSize,
+		 inStream->elementSize);
+	  for (k = 0; k < 20; k += 5) {
+	    quad[k + 2] += inOrigin[0] + outPen[0];
+	    quad[k + 3] += inOrigin[1] + outPen[1];
+	  }
+	}
+	else
+	  *outFailed = GL_TRUE;
+      }
+      else if ((atlasNode->page > inPage)
+	       && ((nextPage < 0) || (atlasNode->page < nextPage)))
+	nextPage = atlasNode->page;
+    }
+
+    if (!inIsRightToLeft) {
+      outPen[0] += inChars[i].advance[0];
+      outPen[1] += inChars[i].advance[1];
+    }
+  }
+
+  return nextPage;
+}
+
+
+
+/* This function copies the quads of the glyphes 'inChars' of a string, which
+ * are all stored in the texture atlas, to the vertex stream 'inStream'. The
+ * quads are sorted by page : for each page of the atlas used by the string, a
+ * batch is appended to 'inBatches'. The pen position at the end of the string
+ * is returned in 'outPen'.
+ * The function returns GL_FALSE if a memory allocation failed, in which case
+ * some quads may be missing from the stream.
+ */
+GLboolean __glcTextureAtlasBuildStream(__GLCcontext* inContext,
+				       const __GLCcharacter* inChars,
+				       const int inLength,
+				       const GLboolean inIsRightToLeft,
+				       __GLCarray* inStream,
+				       __GLCarray* inBatches, GLfloat* outPen)
+{
+  __GLCatlasBatch batch = {0, 0, 0, NULL};
+  GLfloat origin[2] = {0.f, 0.f};
+  int nextPage = 0;
+  int start = 0;
+  GLboolean failed = GL_FALSE;
+
+  /* The pages are processed by increasing index */
+  do {
+    batch.page = nextPage;
+    start = GLC_ARRAY_LENGTH(inStream);
+    nextPage = __glcTextureAtlasBuildPage(inContext, inChars, inLength,
+					  inIsRightToLeft, origin, batch.page,
+					  inStream, outPen, &failed);
+
+    if (GLC_ARRAY_LENGTH(inStream) > start) {
+      batch.start = start * 4;
+      batch.count = (GLC_ARRAY_LENGTH(inStream) - start) * 4;
+      if (!__glcArrayAppend(inBatches, &batch))
+	failed = GL_TRUE;
+    }
+  } while ((nextPage >= 0) && !failed);
+
+  return !failed;
+}
+
+
+
+/* This function draws the batches 'inBatches' of the vertex stream of the
+ * context : the stream is uploaded once then each batch is drawn with the
+ * page of the atlas that it uses.
+ */
+static void __glcTextureAtlasDrawBatches(__GLCcontext* inContext,
+					 __GLCarray* inBatches)
+{
+  __GLCarray* stream = inContext->atlasStream;
+  __GLCatlasPage* pages = NULL;
+  __GLCatlasBatch* batches = (__GLCatlasBatch*)GLC_ARRAY_DATA(inBatches);
+  int i = 0;
+
+  pages = (__GLCatlasPage*)GLC_ARRAY_DATA(inContext->atlasPages);
+
+  if (inContext->atlas.bufferObjectID) {
+    GLintptrARB offset = __glcTextureAtlasUploadStream(inContext);
+
+    glInterleavedArrays(GL_T2F_V3F, 0, (const GLvoid*)offset);
+  }
+  else
+    glInterleavedArrays(GL_T2F_V3F, 0, GLC_ARRAY_DATA(stream));
+
+  for (i = 0; i < GLC_ARRAY_LENGTH(inBatches); i++) {
+    if (!i || (batches[i].page != batches[i - 1].page))
+      glBindTexture(GL_TEXTURE_2D, pages[batches[i].page].id);
+    if (batches[i].color)
+      glColor4fv(batches[i].color);
+    glDrawArrays(GL_QUADS, batches[i].start, batches[i].count);
+  }
+}
+
+
+
+/* This function renders the glyphes 'inChars' of a string which are all
+ * stored in the texture atlas : the vertex stream of the string is built by
+ * __glcTextureAtlasBuildStream() then drawn with one call per page of the
+ * atlas. Finally the modelview matrix is translated to the end of the string.
+ */
+void __glcTextureAtlasDrawString(__GLCcontext* inContext,
+				 const __GLCcharacter* inChars,
+				 const int inLength,
+				 const GLboolean inIsRightToLeft)
+{
+  __GLCarray* stream = inContext->atlasStream;
+  GLfloat pen[2] = {0.f, 0.f};
+
+  assert(stream);
+
+  GLC_ARRAY_LENGTH(stream) = 0;
+  GLC_ARRAY_LENGTH(inContext->atlasBatches) = 0;
+
+  /* If a memory allocation failed, the glyphes that could be stored in the
+   * stream are drawn anyway.
+   */
+  if (!__glcTextureAtlasBuildStream(inContext, inChars, inLength,
+				    inIsRightToLeft, stream,
+				    inContext->atlasBatches, pen))
+    __glcRaiseError(GLC_RESOURCE_ERROR);
+
+  if (GLC_ARRAY_LENGTH(stream))
+    __glcTextureAtlasDrawBatches(inContext, inContext->atlasBatches);
+
+  /* Move the pen to the end of the string */
+  if (inLength)
+    __glcTranslate(inContext, pen[0], pen[1]);
+}
+
+
+
+/* This function renders the batch of strings 'inStrings' which glyphes are
+ * all stored in the texture atlas ('inChars' stores the characters of all the
+ * strings). The quads of all the strings are translated to the origin of their
+ * string and gathered in a single vertex stream where they are sorted by page
+ * so that the stream is uploaded once and drawn with one call per page of the
+ * atlas. If the strings have their own color, the quads of each string are
+ * drawn by a separate call.
+ */
+void __glcTextureAtlasDrawStrings(__GLCcontext* inContext,
+				  const __GLCcharacter* inChars,
+				  const __GLCatlasString* inStrings,
+				  const int inCount)
+{
+  __GLCarray* stream = inContext->atlasStream;
+  __GLCarray* batches = inContext->atlasBatches;
+  __GLCatlasBatch batch = {0, 0, 0, NULL};
+  GLfloat pen[2] = {0.f, 0.f};
+  int nextPage = 0;
+  int start = 0;
+  int i = 0;
+  GLboolean failed = GL_FALSE;
+
+  assert(stream);
+
+  GLC_ARRAY_LENGTH(stream) = 0;
+  GLC_ARRAY_LENGTH(batches) = 0;
+
+  /* The pages are processed by increasing index and, for each page, the quads
+   * of all the strings are appended to the stream.
+   */
+  do {
+    batch.page = nextPage;
+    nextPage = -1;
+
+    for (i = 0; (i < inCount) && !failed; i++) {
+      int page = 0;
+
+      start = GLC_ARRAY_LENGTH(stream);
+      page = __glcTextureAtlasBuildPage(inContext,
+					inChars + inStrings[i].first,
+					inStrings[i].length,
+					inStrings[i].isRightToLeft,
+					inStrings[i].origin, batch.page,
+					stream, pen, &failed);
+      if ((page >= 0) && ((nextPage < 0) || (page < nextPage)))
+	nextPage = page;
+
+      if (GLC_ARRAY_LENGTH(stream) == start)
+	continue;
+
+      /* The quads of the same page are merged in a single batch unless they
+       * must be drawn with different colors.
+       */
+      if (GLC_ARRAY_LENGTH(batches)) {
+	__GLCatlasBatch* last = (__GLCatlasBatch*)GLC_ARRAY_DATA(batches)
+	  + GLC_ARRAY_LENGTH(batches) - 1;
+
+	if ((last->page == batch.page) && !last->color
+	    && !inStrings[i].color) {
+	  last->count += (GLC_ARRAY_LENGTH(stream) - start) * 4;
+	  continue;
+	}
+      }
+
+      batch.start = start * 4;
+      batch.count = (GLC_ARRAY_LENGTH(stream) - start) * 4;
+      batch.color = inStrings[i].color;
+      if (!__glcArrayAppend(batches, &batch))
+	failed = GL_TRUE;
+    }
+  } while ((nextPage >= 0) && !failed);
+
+  /* If a memory allocation failed, the glyphes that could be stored in the
+   * stream are drawn anyway.
+   */
+  if (failed)
+    __glcRaiseError(GLC_RESOURCE_ERROR);
+
+  if (GLC_ARRAY_LENGTH(stream))
+    __glcTextureAtlasDrawBatches(inContext, batches);
+}
+
+
+
 /* Internal function that renders glyph in textures :
  * 'inCode' must be given in UCS-4 format
+ * If 'inDraw' is GL_FALSE, the glyph is stored in the texture atlas but it is
+ * not drawn : it is then required that GL objects are stored in VBOs.
  */
 void __glcRenderCharTexture(const __GLCfont* inFont, __GLCcontext* inContext,
 			    const GLfloat inScaleX, const GLfloat inScaleY,
-			    __GLCglyph* inGlyph)
+			    __GLCglyph* inGlyph, const GLboolean inDraw)
 {
   GLint level = 0;
   GLint texX = 0, texY = 0;
   GLint pixWidth = 0, pixHeight = 0;
+  GLint areaWidth = 0, areaHeight = 0;
   void* pixBuffer = NULL;
   GLint pixBoundingBox[4] = {0, 0, 0, 0};
-  int minSize = (GLEW_VERSION_1_2 || GLEW_SGIS_texture_lod) ? 2 : 1;
   GLfloat texWidth = 0.f, texHeight = 0.f;
 
+  assert(inDraw
+	 || (inContext->enableState.glObjects && GLEW_ARB_vertex_buffer_object));
+
   if (inContext->enableState.glObjects) {
     __GLCatlasElement* atlasNode = NULL;
 
-    if (!__glcTextureAtlasGetPosition(inContext, inGlyph))
+    /* Compute the size of the pixmap where the glyph will be rendered */
+    __glcFontGetBitmapSize(inFont, &pixWidth, &pixHeight, inScaleX, inScaleY, 0,
+			   pixBoundingBox, inContext);
+
+    if (!__glcTextureAtlasGetPosition(inContext, inGlyph, pixWidth, pixHeight))
       return;
 
-    /* Compute the size of the pixmap where the glyph will be rendered */
     atlasNode = inGlyph->textureObject;
 
-    __glcFontGetBitmapSize(inFont, &pixWidth, &pixHeight, inScaleX, inScaleY, 0,
-			   pixBoundingBox, inContext);
+    /* The area of the atlas may be larger than the pixmap if it has been
+     * released by another glyph. In such a case, the glyph is centered in the
+     * area and its bounding box is enlarged accordingly.
+     */
+    if ((atlasNode->width != pixWidth) || (atlasNode->height != pixHeight)) {
+      GLfloat texelX = (pixBoundingBox[2] - pixBoundingBox[0])
+	/ (GLfloat)(pixWidth - 1);
+      GLfloat texelY = (pixBoundingBox[3] - pixBoundingBox[1])
+	/ (GLfloat)(pixHeight - 1);
+
+      pixBoundingBox[0] -= (GLint)((atlasNode->width - pixWidth) * texelX
+				   * .5f);
+      pixBoundingBox[1] -= (GLint)((atlasNode->height - pixHeight) * texelY
+				   * .5f);
+      pixBoundingBox[2] = pixBoundingBox[0]
+	+ (GLint)((atlasNode->width - 1) * texelX);
+      pixBoundingBox[3] = pixBoundingBox[1]
+	+ (GLint)((atlasNode->height - 1) * texelY);
+
+      pixWidth = atlasNode->width;
+      pixHeight = atlasNode->height;
+    }
 
     texWidth = inContext->atlas.width;
     texHeight = inContext->atlas.height;
-    texY = (atlasNode->position / inContext->atlasWidth);
-    texX = (atlasNode->position - texY*inContext->atlasWidth)*GLC_TEXTURE_SIZE;
-    texY *= GLC_TEXTURE_SIZE;
+    texX = atlasNode->x;
+    texY = atlasNode->y;
   }
   else {
     int factor = 0;
@@ -401,6 +1094,9 @@ void __glcRenderCharTexture(const __GLCfont* inFont, __GLCcontext* inContext,
   glPixelStorei(GL_UNPACK_SKIP_ROWS, 0);
   glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
 
+  areaWidth = pixWidth;
+  areaHeight = pixHeight;
+
   /* Iterate on the powers of 2 in order to build the mipmap */
   do {
     if (GLEW_ARB_pixel_buffer_object && !inContext->enableState.glObjects) {
@@ -443,13 +1139,14 @@ void __glcRenderCharTexture(const __GLCfont* inFont, __GLCcontext* inContext,
     level++; /* Next level of mipmap */
     pixWidth >>= 1;
     pixHeight >>= 1;
-  } while ((pixWidth > minSize) && (pixHeight > minSize));
+  } while (level <= GLC_ATLAS_MAX_LEVEL);
 
-  /* Finish to build the mipmap if necessary */
+  /* Finish to build the mipmap if necessary. If the OpenGL driver supports
+   * the extension GL_EXT_texture_lod, the maximum level of the mipmap has been
+   * set when the atlas has been created.
+   */
   if (inContext->enableState.mipmap && inContext->enableState.glObjects) {
-    if (GLEW_VERSION_1_2 || GLEW_SGIS_texture_lod)
-      glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, level - 1);
-    else {
+    if (!(GLEW_VERSION_1_2 || GLEW_SGIS_texture_lod)) {
       /* The OpenGL driver does not support the extension GL_EXT_texture_lod 
        * We must finish the pixmap until the mipmap level is 1x1.
        * Here the smaller mipmap levels will be transparent, no glyph will be
@@ -458,18 +1155,23 @@ void __glcRenderCharTexture(const __GLCfont* inFont, __GLCcontext* inContext,
        * Here we do not take the GL_ARB_pixel_buffer_object into account
        * because there are few chances that a gfx card that supports PBO, does
        * not support texture levels.
+       * Beyond GLC_ATLAS_MAX_LEVEL, a texel may be shared by the glyph and its
+       * neighbours in the atlas : only the texels that lie entirely inside the
+       * area of the glyph are cleared.
        */
       assert(!GLEW_ARB_pixel_buffer_object);
-      memset(pixBuffer, 0, pixWidth * pixHeight);
-      while ((pixWidth > 0) || (pixHeight > 0)) {
-	glTexSubImage2D(GL_TEXTURE_2D, level, texX >> level, texY >> level,
-		     pixWidth ? pixWidth : 1,
-		     pixHeight ? pixHeight : 1, GL_ALPHA,
-		     GL_UNSIGNED_BYTE, pixBuffer);
+      memset(pixBuffer, 0, areaWidth * areaHeight);
+      while ((areaWidth >> level) || (areaHeight >> level)) {
+	GLint x0 = (texX + (1 << level) - 1) >> level;
+	GLint y0 = (texY + (1 << level) - 1) >> level;
+	GLint x1 = (texX + areaWidth) >> level;
+	GLint y1 = (texY + areaHeight) >> level;
+
+	if ((x1 > x0) && (y1 > y0))
+	  glTexSubImage2D(GL_TEXTURE_2D, level, x0, y0, x1 - x0, y1 - y0,
+			  GL_ALPHA, GL_UNSIGNED_BYTE, pixBuffer);
 
 	level++;
-	pixWidth >>= 1;
-	pixHeight >>= 1;
       }
     }
   }
@@ -484,55 +1186,25 @@ void __glcRenderCharTexture(const __GLCfont* inFont, __GLCcontext* inContext,
    */
   if (inContext->enableState.glObjects) {
     if (GLEW_ARB_vertex_buffer_object) {
-      GLfloat* buffer = NULL;
-      GLfloat* data = NULL;
+      GLfloat data[20];
       __GLCatlasElement* atlasNode = inGlyph->textureObject;
+      __GLCarray* vertices = inContext->atlasVertices;
 
-      buffer = (GLfloat*)__glcMalloc(inContext->atlasWidth
-				     * inContext->atlasHeight * 20
-				     * sizeof(GLfloat));
-      if (!buffer) {
-	__glcRaiseError(GLC_RESOURCE_ERROR);
-	return;
-      }
-
-      /* The display list ID is used as a flag to declare that the VBO has been
-       * initialized and can be used.
-       */
-      inGlyph->glObject[1] = 0xffffffff;
-
-      /* Here we do not use the GL command glBufferSubData() since it seems to
-       * be buggy on some GL drivers (the DRI Intel specifically).
-       * Instead, we use a workaround: the current values of the VBO are stored
-       * in memory and new values are appended to them. Then, the content of
-       * the resulting array replaces all the values previously stored in the
-       * VBO.
+      /* Quads are made of 4 vertices made of 3D coordinates plus 2D texture
+       * coordinates : 4 * (3 + 2) = 20 GLfloat.
        */
-      if (inContext->atlasCount > 1) {
-	data = (GLfloat*)glMapBufferARB(GL_ARRAY_BUFFER_ARB, GL_READ_ONLY);
-	if (!data) {
-	  __glcRaiseError(GLC_RESOURCE_ERROR);
-	  __glcFree(buffer);
-	  return;
-	}
-	memcpy(buffer, data, inContext->atlasCount * 20 * sizeof(GLfloat));
-	glUnmapBufferARB(GL_ARRAY_BUFFER_ARB);
-      }
-
-      data = buffer + atlasNode->position * 20;
-
       data[0] = texX / texWidth;
       data[1] = texY / texHeight;
       data[2] = pixBoundingBox[0] / 64. / GLC_TEXTURE_SIZE;
       data[3] = pixBoundingBox[1] / 64. / GLC_TEXTURE_SIZE;
       data[4] = 0.f;
-      data[5] = (texX + GLC_TEXTURE_SIZE - 1) / texWidth;
+      data[5] = (texX + atlasNode->width - 1) / texWidth;
       data[6] = data[1];
       data[7] = pixBoundingBox[2] / 64.	/ GLC_TEXTURE_SIZE;
       data[8] = data[3];
       data[9] = 0.f;
       data[10] = data[5];
-      data[11] = (texY + GLC_TEXTURE_SIZE - 1) / texHeight;
+      data[11] = (texY + atlasNode->height - 1) / texHeight;
       data[12] = data[7];
       data[13] = pixBoundingBox[3] / 64. / GLC_TEXTURE_SIZE;
       data[14] = 0.f;
@@ -542,19 +1214,38 @@ void __glcRenderCharTexture(const __GLCfont* inFont, __GLCcontext* inContext,
       data[18] = data[13];
       data[19] = 0.f;
 
-      /* Size of the buffer data is equal to the number of glyphes than can be
-       * stored in the texture times 20 GLfloat (4 vertices made of 3D
-       * coordinates plus 2D texture coordinates : 4 * (3 + 2) = 20)
+      /* The quad is stored in memory. It is copied to the VBO by
+       * __glcTextureAtlasDrawString() each time a string uses the glyph.
+       */
+      /* If some quads could not be stored (because of a memory allocation
+       * failure) their slots are filled with dummy values.
        */
-      glBufferDataARB(GL_ARRAY_BUFFER_ARB,
-		      inContext->atlasWidth * inContext->atlasHeight
-		      * 20 * sizeof(GLfloat), buffer, GL_STATIC_DRAW_ARB);
+      while (GLC_ARRAY_LENGTH(vertices) < atlasNode->position) {
+	if (!__glcArrayAppend(vertices, data))
+	  return;
+      }
 
-      __glcFree(buffer);
+      if (GLC_ARRAY_LENGTH(vertices) == atlasNode->position) {
+	if (!__glcArrayAppend(vertices, data))
+	  return;
+      }
+      else
+	memcpy(GLC_ARRAY_DATA(vertices) + atlasNode->position * sizeof(data),
+	       data, sizeof(data));
 
-      /* Do the actual GL rendering */
-      glInterleavedArrays(GL_T2F_V3F, 0, NULL);
-      glDrawArrays(GL_QUADS, atlasNode->position * 4, 4);
+      /* The display list ID is used as a flag to declare that the VBO has been
+       * initialized and can be used.
+       */
+      inGlyph->glObject[1] = 0xffffffff;
+
+      /* Do the actual GL rendering : the quad is sourced from the client
+       * memory.
+       */
+      if (inDraw) {
+	glBindBufferARB(GL_ARRAY_BUFFER_ARB, 0);
+	glInterleavedArrays(GL_T2F_V3F, 0, data);
+	glDrawArrays(GL_QUADS, 0, 4);
+      }
 
       return;
     }
@@ -567,6 +1258,10 @@ void __glcRenderCharTexture(const __GLCfont* inFont, __GLCcontext* inContext,
 
       /* Create the display list */
       glNewList(inGlyph->glObject[1], GL_COMPILE);
+      /* The glyph may be drawn while another page of the atlas is bound */
+      glBindTexture(GL_TEXTURE_2D,
+		    ((__GLCatlasPage*)GLC_ARRAY_DATA(inContext->atlasPages)
+		     + inGlyph->textureObject->page)->id);
       glScalef(1. / (64. * inScaleX), 1. / (64. * inScaleY) , 1.);
 
       /* Modify the bouding box dimensions to compensate the glScalef() */
@@ -575,8 +1270,8 @@ void __glcRenderCharTexture(const __GLCfont* inFont, __GLCcontext* inContext,
       pixBoundingBox[2] *= inScaleX / GLC_TEXTURE_SIZE;
       pixBoundingBox[3] *= inScaleY / GLC_TEXTURE_SIZE;
 
-      pixWidth = GLC_TEXTURE_SIZE;
-      pixHeight = GLC_TEXTURE_SIZE;
+      pixWidth = inGlyph->textureObject->width;
+      pixHeight = inGlyph->textureObject->height;
     }
   }
 
@@ -29,15 +29,97 @@
 
 #define GLC_TEXTURE_SIZE        64
 
+/* The areas of the texture atlas are aligned on GLC_ATLAS_GRANULARITY texels
+ * so that the first GLC_ATLAS_MAX_LEVEL levels of the mipmap of a glyph do not
+ * overlap the neighbouring glyphs.
+ */
+#define GLC_ATLAS_GRANULARITY   8
+#define GLC_ATLAS_MAX_LEVEL     3
+
+/* Amount of texture memory used by a page of the atlas (mipmap included) */
+#define GLC_ATLAS_PAGE_MEMORY(ctx) \
+  ((ctx)->atlas.width * (ctx)->atlas.height * 4 / 3)
+
+/* Default value of GLC_TEXTURE_BUDGET_QSO */
+#define GLC_ATLAS_DEFAULT_BUDGET (8 << 20)
+
+typedef struct __GLCatlasShelfRec __GLCatlasShelf;
+typedef struct __GLCatlasPageRec __GLCatlasPage;
+typedef struct __GLCatlasBatchRec __GLCatlasBatch;
+typedef struct __GLCatlasStringRec __GLCatlasString;
+
 struct __GLCatlasElementRec {
   FT_ListNodeRec node;
 
-  int position;
+  int page;		/* Index of the page where the area is located */
+  int position;		/* Index of the quad in the VBO of the atlas */
+  int x, y;		/* Location of the area in the atlas */
+  int width, height;	/* Dimensions of the area */
   __GLCglyph* glyph;
 };
 
+/* The texture atlas is divided in horizontal shelves : each shelf is filled
+ * from the left to the right with glyphes which height is lower or equal to the
+ * shelf height.
+ */
+struct __GLCatlasShelfRec {
+  int y;		/* Vertical location of the shelf */
+  int height;		/* Height of the shelf */
+  int fill;		/* Width of the shelf that is already used */
+};
+
+/* When a single texture can not store all the glyphes that are used, the
+ * atlas is extended with additional textures (the pages). Each page manages
+ * its own areas in a LRU list : the most recently used areas are stored at
+ * the head of the list.
+ */
+struct __GLCatlasPageRec {
+  GLuint id;		/* Texture object of the page */
+  FT_ListRec areaList;	/* Areas of the page */
+  __GLCarray* shelves;	/* Shelves of the page */
+  GLuint lastUsed;	/* Stamp of the last string that used the page */
+};
+
+/* A range of vertices of a vertex stream which quads all lie in the same page
+ * of the atlas.
+ */
+struct __GLCatlasBatchRec {
+  int page;		/* Index of the page */
+  int start;		/* Index of the first vertex */
+  int count;		/* Number of vertices */
+  const GLfloat* color;	/* Color of the quads (NULL for the current color) */
+};
+
+/* A string of a batch of strings that is drawn by
+ * __glcTextureAtlasDrawStrings().
+ */
+struct __GLCatlasStringRec {
+  int first;		/* Index of the first character of the string */
+  int length;		/* Number of characters */
+  GLboolean isRightToLeft;
+  GLfloat origin[2];	/* Origin of the string */
+  const GLfloat* color;	/* Color of the string (NULL for the current color) */
+};
+
 void __glcReleaseAtlasElement(__GLCatlasElement* This, __GLCcontext* inContext);
+void __glcTextureAtlasUseElement(__GLCatlasElement* This,
+				 __GLCcontext* inContext);
+GLboolean __glcTextureAtlasBuildStream(__GLCcontext* inContext,
+				       const __GLCcharacter* inChars,
+				       const int inLength,
+				       const GLboolean inIsRightToLeft,
+				       __GLCarray* inStream,
+				       __GLCarray* inBatches, GLfloat* outPen);
+void __glcTextureAtlasDrawString(__GLCcontext* inContext,
+				 const __GLCcharacter* inChars,
+				 const int inLength,
+				 const GLboolean inIsRightToLeft);
+void __glcTextureAtlasDrawStrings(__GLCcontext* inContext,
+				  const __GLCcharacter* inChars,
+				  const __GLCatlasString* inStrings,
+				  const int inCount);
+void __glcTextureAtlasDestroy(__GLCcontext* inContext);
 void __glcRenderCharTexture(const __GLCfont* inFont, __GLCcontext* inContext,
 			    const GLfloat inScaleX, const GLfloat inScaleY,
-			    __GLCglyph* inGlyph);
+			    __GLCglyph* inGlyph, const GLboolean inDraw);
 #endif
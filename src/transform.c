@@ -290,3 +290,51 @@ void APIENTRY glcPopMatrixQSO(void)
   ctx->bitmapMatrixStackDepth--;
   return;
 }
+
+
+
+/** \ingroup transform
+ *  This command stores the viewport, the modelview matrix and the projection
+ *  matrix that GLC uses to compute the size of the glyphes when
+ *  \b GLC_USER_TRANSFORM_QSO is enabled. The matrices are stored in column
+ *  major order like the ones returned by \c glGetFloatv.
+ *
+ *  When \b GLC_USER_TRANSFORM_QSO is enabled, GLC does not query the viewport
+ *  nor the matrices from GL and the scale of the glyphes is computed only once
+ *  per string. The application must then call glcLoadTransformQSO() each time
+ *  it modifies the GL matrices or the viewport, and the matrices are assumed
+ *  not to change while a string is rendered. The translations that GLC applies
+ *  to the modelview matrix when it moves the pen are tracked by GLC itself.
+ *
+ *  The command raises \b GLC_PARAMETER_ERROR if any of the arguments is
+ *  \b NULL.
+ *  \param inViewport The 4 values of the viewport (x, y, width, height).
+ *  \param inModelview The 16 values of the modelview matrix.
+ *  \param inProjection The 16 values of the projection matrix.
+ *  \sa glcEnable() with argument \b GLC_USER_TRANSFORM_QSO
+ */
+void APIENTRY glcLoadTransformQSO(const GLint* inViewport,
+				  const GLfloat* inModelview,
+				  const GLfloat* inProjection)
+{
+  __GLCcontext *ctx = NULL;
+
+  GLC_INIT_THREAD();
+
+  if (!inViewport || !inModelview || !inProjection) {
+    __glcRaiseError(GLC_PARAMETER_ERROR);
+    return;
+  }
+
+  /* Check if the current thread owns a context state */
+  ctx = GLC_GET_CURRENT_CONTEXT();
+  if (!ctx) {
+    __glcRaiseError(GLC_STATE_ERROR);
+    return;
+  }
+
+  memcpy(ctx->userViewport, inViewport, 4 * sizeof(GLint));
+  memcpy(ctx->userModelview, inModelview, 16 * sizeof(GLfloat));
+  memcpy(ctx->userProjection, inProjection, 16 * sizeof(GLfloat));
+  ctx->isScaleCached = GL_FALSE;
+}
@@ -0,0 +1,187 @@
+/* QuesoGLC
+ * A free implementation of the OpenGL Character Renderer (GLC)
+ * Copyright (c) 2002, 2004-2009, Bertrand Coconnier
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+/* $Id$ */
+
+/** \file
+ * This test checks that the contexts which share the font database see the
+ * same masters with the same IDs, and that the catalogs of a context can be
+ * modified without changing the catalogs nor the masters of the other
+ * contexts.
+ */
+
+#include "GL/glc.h"
+#if defined __APPLE__ && defined __MACH__
+#include <GLUT/glut.h>
+#else
+#include <GL/glut.h>
+#endif
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static GLboolean checkError(GLCenum expected)
+{
+  GLCenum err = glcGetError();
+
+  if (err != expected) {
+    printf("Unexpected error 0x%X (expected 0x%X)\n", (int)err, (int)expected);
+    return GL_FALSE;
+  }
+
+  return GL_TRUE;
+}
+
+/* Check that the context 'ctx' has 'catalogCount' catalogs and 'masterCount'
+ * masters.
+ */
+static GLboolean checkCounts(GLint ctx, GLint catalogCount, GLint masterCount)
+{
+  glcContext(ctx);
+  if (!checkError(GLC_NONE))
+    return GL_FALSE;
+
+  if (glcGeti(GLC_CATALOG_COUNT) != catalogCount) {
+    printf("Context %d: unexpected GLC_CATALOG_COUNT %d (expected %d)\n",
+	   (int)ctx, (int)glcGeti(GLC_CATALOG_COUNT), (int)catalogCount);
+    return GL_FALSE;
+  }
+
+  if (glcGeti(GLC_MASTER_COUNT) != masterCount) {
+    printf("Context %d: unexpected GLC_MASTER_COUNT %d (expected %d)\n",
+	   (int)ctx, (int)glcGeti(GLC_MASTER_COUNT), (int)masterCount);
+    return GL_FALSE;
+  }
+
+  return checkError(GLC_NONE);
+}
+
+int main(int argc, char **argv)
+{
+  GLint ctx1 = 0;
+  GLint ctx2 = 0;
+  GLint ctx3 = 0;
+  GLint catalogCount = 0;
+  GLint masterCount = 0;
+  GLint i = 0;
+
+  glutInit(&argc, argv);
+  glutInitDisplayMode(GLUT_SINGLE | GLUT_RGB);
+  glutCreateWindow("test19");
+
+  ctx1 = glcGenContext();
+  ctx2 = glcGenContext();
+  if (!checkError(GLC_NONE))
+    return -1;
+
+  glcContext(ctx1);
+  glcStringType(GLC_UTF8_QSO);
+  catalogCount = glcGeti(GLC_CATALOG_COUNT);
+  masterCount = glcGeti(GLC_MASTER_COUNT);
+  if (!checkError(GLC_NONE))
+    return -1;
+
+  if (!checkCounts(ctx2, catalogCount, masterCount))
+    return -1;
+
+  /* The masters must have the same IDs in both contexts */
+  glcStringType(GLC_UTF8_QSO);
+  for (i = 0; i < masterCount; i++) {
+    char* family = NULL;
+
+    glcContext(ctx1);
+    family = strdup((const char*)glcGetMasterc(i, GLC_FAMILY));
+    if (!family) {
+      printf("Failed to duplicate the family of master #%d\n", (int)i);
+      return -1;
+    }
+
+    glcContext(ctx2);
+    if (strcmp(family, (const char*)glcGetMasterc(i, GLC_FAMILY))) {
+      printf("Master #%d: family %s in context %d, %s in context %d\n",
+	     (int)i, family, (int)ctx1,
+	     (const char*)glcGetMasterc(i, GLC_FAMILY), (int)ctx2);
+      free(family);
+      return -1;
+    }
+    free(family);
+  }
+
+  if (!checkError(GLC_NONE))
+    return -1;
+
+  /* Modify the catalogs of the second context */
+  glcContext(ctx2);
+  glcAppendCatalog(".");
+  if (!checkError(GLC_NONE))
+    return -1;
+
+  if (glcGeti(GLC_CATALOG_COUNT) != catalogCount + 1) {
+    printf("Context %d: the catalog has not been appended\n", (int)ctx2);
+    return -1;
+  }
+
+  /* The first context must not be affected */
+  if (!checkCounts(ctx1, catalogCount, masterCount))
+    return -1;
+
+  /* A new context must not be affected either */
+  ctx3 = glcGenContext();
+  if (!checkError(GLC_NONE))
+    return -1;
+
+  if (!checkCounts(ctx3, catalogCount, masterCount))
+    return -1;
+
+  /* Restore the catalogs of the second context */
+  glcContext(ctx2);
+  glcRemoveCatalog(catalogCount);
+  if (!checkError(GLC_NONE))
+    return -1;
+
+  if (glcGeti(GLC_CATALOG_COUNT) != catalogCount) {
+    printf("Context %d: the catalog has not been removed\n", (int)ctx2);
+    return -1;
+  }
+
+  /* Delete the contexts in an order which is different from their creation
+   * order.
+   */
+  glcContext(0);
+  glcDeleteContext(ctx1);
+  glcDeleteContext(ctx3);
+  glcDeleteContext(ctx2);
+  if (!checkError(GLC_NONE))
+    return -1;
+
+  /* The database is created again when all the contexts have been deleted */
+  ctx1 = glcGenContext();
+  if (!checkError(GLC_NONE))
+    return -1;
+
+  if (!checkCounts(ctx1, catalogCount, masterCount))
+    return -1;
+
+  glcContext(0);
+  glcDeleteContext(ctx1);
+  if (!checkError(GLC_NONE))
+    return -1;
+
+  printf("Test successful!\n");
+  return 0;
+}
@@ -0,0 +1,214 @@
+/* QuesoGLC
+ * A free implementation of the OpenGL Character Renderer (GLC)
+ * Copyright (c) 2002, 2004-2009, Bertrand Coconnier
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+/* $Id$ */
+
+/** \file
+ * This test checks the hinting profiles (GLC_HINTING_PROFILE_QSO) and
+ * benchmarks them : for each profile, a string is measured at several sizes
+ * and the test reports the number of characters measured per second when the
+ * glyphes are loaded by FreeType (cold) and when their metrics are cached
+ * (warm), and how far the width of the string is from its unhinted width.
+ * The test fails if the full auto-hinting profile gives the same widths as
+ * the unhinted or the light auto-hinting profiles.
+ */
+
+#include "GL/glc.h"
+#if defined __APPLE__ && defined __MACH__
+#include <GLUT/glut.h>
+#else
+#include <GL/glut.h>
+#endif
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+#define PROFILE_COUNT	4
+#define SIZE_MIN	6
+#define SIZE_COUNT	43	/* Sizes from 6 to 48 pixels */
+#define LOOP_COUNT	20
+
+static const char* text = "The quick brown fox jumps over the lazy dog";
+
+/* Measure the string at each size and store its widths in 'outWidths' */
+static void measure(const char* inText, GLfloat* outWidths)
+{
+  GLint i = 0;
+
+  for (i = 0; i < SIZE_COUNT; i++) {
+    GLfloat baseline[4] = {0.f, 0.f, 0.f, 0.f};
+
+    glcLoadIdentity();
+    glcScale((GLfloat)(SIZE_MIN + i), (GLfloat)(SIZE_MIN + i));
+    glcMeasureString(GL_FALSE, inText);
+    glcGetStringMetric(GLC_BASELINE, baseline);
+    outWidths[i] = baseline[2] - baseline[0];
+  }
+}
+
+/* Return the number of sizes at which the widths 'inWidths1' and 'inWidths2'
+ * of the string differ.
+ */
+static int countDifferences(const GLfloat* inWidths1, const GLfloat* inWidths2)
+{
+  int count = 0;
+  int i = 0;
+
+  for (i = 0; i < SIZE_COUNT; i++) {
+    if (fabs(inWidths1[i] - inWidths2[i]) > 1E-3)
+      count++;
+  }
+
+  return count;
+}
+
+/* Return the number of characters measured per second */
+static double throughput(const int inCharCount, const int inElapsed)
+{
+  return (inElapsed > 0) ? 1000. * inCharCount / inElapsed : 0.;
+}
+
+static GLboolean checkError(GLCenum expected)
+{
+  GLCenum err = glcGetError();
+
+  if (err != expected) {
+    printf("Unexpected error 0x%X (expected 0x%X)\n", (int)err, (int)expected);
+    return GL_FALSE;
+  }
+
+  return GL_TRUE;
+}
+
+int main(int argc, char **argv)
+{
+  static const GLint profiles[PROFILE_COUNT] = {
+    GLC_HINTING_NONE_QSO, GLC_HINTING_NATIVE_QSO, GLC_HINTING_LIGHT_AUTO_QSO,
+    GLC_HINTING_FULL_AUTO_QSO
+  };
+  static const char* names[PROFILE_COUNT] = {
+    "none", "native", "light auto", "full auto"
+  };
+  GLfloat widths[PROFILE_COUNT][SIZE_COUNT];
+  GLint ctx = 0;
+  GLint i = 0, j = 0, k = 0;
+
+  glutInit(&argc, argv);
+  glutInitDisplayMode(GLUT_SINGLE | GLUT_RGB);
+  glutCreateWindow("test20");
+
+  ctx = glcGenContext();
+  glcContext(ctx);
+  if (!checkError(GLC_NONE))
+    return -1;
+
+  /* The profile must be one of the GLC_HINTING_xxx_QSO values */
+  glcRenderParameteriQSO(GLC_HINTING_PROFILE_QSO, -1);
+  if (!checkError(GLC_PARAMETER_ERROR))
+    return -1;
+
+  glcRenderParameteriQSO(GLC_HINTING_PROFILE_QSO, GLC_HINTING_PROFILE_QSO);
+  if (!checkError(GLC_PARAMETER_ERROR))
+    return -1;
+
+  if (glcGeti(GLC_HINTING_PROFILE_QSO) != GLC_HINTING_FULL_AUTO_QSO) {
+    printf("Unexpected profile 0x%X\n", glcGeti(GLC_HINTING_PROFILE_QSO));
+    return -1;
+  }
+
+  /* The measurements are not stored in the glyphes when GLC_GL_OBJECTS is
+   * disabled, and the glyphes are hinted only if GLC_HINTING_QSO is enabled.
+   */
+  glcDisable(GLC_GL_OBJECTS);
+  glcEnable(GLC_HINTING_QSO);
+  glcRenderStyle(GLC_BITMAP);
+  if (!checkError(GLC_NONE))
+    return -1;
+
+  /* Open the faces beforehand so that the first profile is not penalized */
+  glcScale(100.f, 100.f);
+  glcMeasureString(GL_FALSE, text);
+  if (!checkError(GLC_NONE))
+    return -1;
+
+  printf("%-12s %12s %12s %12s\n", "Profile", "Cold chars/s", "Warm chars/s",
+	 "Width error");
+
+  for (i = 0; i < PROFILE_COUNT; i++) {
+    const int charCount = SIZE_COUNT * strlen(text);
+    GLfloat error = 0.f;
+    int start = 0, cold = 0, warm = 0;
+
+    glcRenderParameteriQSO(GLC_HINTING_PROFILE_QSO, profiles[i]);
+    if (!checkError(GLC_NONE))
+      return -1;
+
+    if (glcGeti(GLC_HINTING_PROFILE_QSO) != profiles[i]) {
+      printf("Profile 0x%X has not been selected\n", (int)profiles[i]);
+      return -1;
+    }
+
+    /* The first loop loads the glyphes with the hinter of the profile, the
+     * following ones retrieve the metrics from the cache.
+     */
+    start = glutGet(GLUT_ELAPSED_TIME);
+    measure(text, widths[i]);
+    cold = glutGet(GLUT_ELAPSED_TIME) - start;
+
+    start = glutGet(GLUT_ELAPSED_TIME);
+    for (k = 1; k < LOOP_COUNT; k++)
+      measure(text, widths[i]);
+    warm = glutGet(GLUT_ELAPSED_TIME) - start;
+
+    if (!checkError(GLC_NONE))
+      return -1;
+
+    /* The quality is estimated by the distance, in pixels, between the width
+     * of the string and its unhinted width.
+     */
+    for (j = 0; j < SIZE_COUNT; j++)
+      error += fabs(widths[i][j] - widths[0][j]);
+
+    printf("%-12s %12.0f %12.0f %12.2f\n", names[i],
+	   throughput(charCount, cold),
+	   throughput((LOOP_COUNT - 1) * charCount, warm), error / SIZE_COUNT);
+  }
+
+  /* The auto-hinter fits the advances to the pixel grid only in the full
+   * profile (the light profile only hints the glyphes vertically), and the
+   * unhinted advances are not fitted at all : the widths of the string must
+   * differ at some sizes.
+   */
+  if (!countDifferences(widths[0], widths[3])) {
+    printf("The widths of the full auto profile are not hinted\n");
+    return -1;
+  }
+
+  if (!countDifferences(widths[2], widths[3])) {
+    printf("The light and full auto profiles give the same widths\n");
+    return -1;
+  }
+
+  glcContext(0);
+  glcDeleteContext(ctx);
+  if (!checkError(GLC_NONE))
+    return -1;
+
+  printf("Test successful!\n");
+  return 0;
+}
@@ -0,0 +1,255 @@
+/* QuesoGLC
+ * A free implementation of the OpenGL Character Renderer (GLC)
+ * Copyright (c) 2002, 2004-2009, Bertrand Coconnier
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+/* $Id$ */
+
+/** \file
+ * This test checks the matrices given by glcLoadTransformQSO() when
+ * GLC_USER_TRANSFORM_QSO is enabled. The outlines of a string are rendered
+ * with the GLC_LINE style in GL feedback mode, GL objects being disabled so
+ * that the curves are subdivided with a tolerance of one pixel : the test
+ * checks that scaling the loaded modelview matrix by 2 increases the number of
+ * lines, that the metrics (which are given in object space) are not modified
+ * and that loading the initial transform back restores the initial values.
+ */
+
+#include "GL/glc.h"
+#if defined __APPLE__ && defined __MACH__
+#include <GLUT/glut.h>
+#else
+#include <GL/glut.h>
+#endif
+#include <stdio.h>
+#include <math.h>
+
+#define FEEDBACK_SIZE	65536
+#define WIDTH		640
+#define HEIGHT		480
+
+static const char* text = "Oo8@S";
+static GLfloat feedback[FEEDBACK_SIZE];
+
+static GLboolean checkError(GLCenum expected)
+{
+  GLCenum err = glcGetError();
+
+  if (err != expected) {
+    printf("Unexpected error 0x%X (expected 0x%X)\n", (int)err, (int)expected);
+    return GL_FALSE;
+  }
+
+  return GL_TRUE;
+}
+
+/* Load the same transform in GL and in GLC : an orthographic projection on the
+ * viewport and a modelview matrix that scales the glyphes to 'inSize' pixels.
+ */
+static void loadTransform(const GLfloat inSize)
+{
+  static const GLint viewport[4] = {0, 0, WIDTH, HEIGHT};
+  GLfloat projection[16] = {2.f / WIDTH, 0.f, 0.f, 0.f,
+			    0.f, 2.f / HEIGHT, 0.f, 0.f,
+			    0.f, 0.f, -1.f, 0.f,
+			    -1.f, -1.f, 0.f, 1.f};
+  GLfloat modelview[16] = {0.f, 0.f, 0.f, 0.f,
+			   0.f, 0.f, 0.f, 0.f,
+			   0.f, 0.f, 1.f, 0.f,
+			   20.f, 200.f, 0.f, 1.f};
+
+  modelview[0] = inSize;
+  modelview[5] = inSize;
+
+  glViewport(viewport[0], viewport[1], viewport[2], viewport[3]);
+  glMatrixMode(GL_PROJECTION);
+  glLoadMatrixf(projection);
+  glMatrixMode(GL_MODELVIEW);
+  glLoadMatrixf(modelview);
+
+  glcLoadTransformQSO(viewport, modelview, projection);
+}
+
+/* Render the string in feedback mode and return the number of lines drawn */
+static GLint countLines(void)
+{
+  GLint size = 0;
+  GLint count = 0;
+  GLint i = 0;
+
+  glFeedbackBuffer(FEEDBACK_SIZE, GL_2D, feedback);
+  glRenderMode(GL_FEEDBACK);
+  glcRenderString(text);
+  size = glRenderMode(GL_RENDER);
+
+  if (size < 0) {
+    printf("The feedback buffer overflowed\n");
+    return -1;
+  }
+
+  while (i < size) {
+    switch((GLint)feedback[i]) {
+    case GL_LINE_TOKEN:
+    case GL_LINE_RESET_TOKEN:
+      count++;
+      i += 5;
+      break;
+    case GL_POINT_TOKEN:
+    case GL_BITMAP_TOKEN:
+    case GL_DRAW_PIXEL_TOKEN:
+    case GL_COPY_PIXEL_TOKEN:
+      i += 3;
+      break;
+    case GL_PASS_THROUGH_TOKEN:
+      i += 2;
+      break;
+    case GL_POLYGON_TOKEN:
+      i += 2 + 2 * (GLint)feedback[i+1];
+      break;
+    default:
+      printf("Unexpected feedback token %g\n", feedback[i]);
+      return -1;
+    }
+  }
+
+  return count;
+}
+
+/* Measure the string and its first character */
+static void measure(GLfloat* outBounds, GLfloat* outCharBounds)
+{
+  glcMeasureString(GL_FALSE, text);
+  glcGetStringMetric(GLC_BOUNDS, outBounds);
+  glcGetCharMetric(text[0], GLC_BOUNDS, outCharBounds);
+}
+
+/* Return GL_TRUE if the bounds 'inBounds1' and 'inBounds2' are equal */
+static GLboolean compareBounds(const GLfloat* inBounds1,
+			       const GLfloat* inBounds2)
+{
+  GLint i = 0;
+
+  for (i = 0; i < 8; i++) {
+    if (fabs(inBounds1[i] - inBounds2[i]) > 1E-5)
+      return GL_FALSE;
+  }
+
+  return GL_TRUE;
+}
+
+int main(int argc, char **argv)
+{
+  static const GLint viewport[4] = {0, 0, WIDTH, HEIGHT};
+  static const GLfloat identity[16] = {1.f, 0.f, 0.f, 0.f,
+				       0.f, 1.f, 0.f, 0.f,
+				       0.f, 0.f, 1.f, 0.f,
+				       0.f, 0.f, 0.f, 1.f};
+  GLfloat bounds[3][8];
+  GLfloat charBounds[3][8];
+  GLint lines[3] = {0, 0, 0};
+  GLint ctx = 0;
+
+  glutInit(&argc, argv);
+  glutInitDisplayMode(GLUT_SINGLE | GLUT_RGB);
+  glutInitWindowSize(WIDTH, HEIGHT);
+  glutCreateWindow("test21");
+
+  ctx = glcGenContext();
+  glcContext(ctx);
+  if (!checkError(GLC_NONE))
+    return -1;
+
+  /* Check the errors of glcLoadTransformQSO() */
+  glcLoadTransformQSO(NULL, identity, identity);
+  if (!checkError(GLC_PARAMETER_ERROR))
+    return -1;
+  glcLoadTransformQSO(viewport, NULL, identity);
+  if (!checkError(GLC_PARAMETER_ERROR))
+    return -1;
+  glcLoadTransformQSO(viewport, identity, NULL);
+  if (!checkError(GLC_PARAMETER_ERROR))
+    return -1;
+
+  if (glcIsEnabled(GLC_USER_TRANSFORM_QSO)) {
+    printf("GLC_USER_TRANSFORM_QSO is enabled by default\n");
+    return -1;
+  }
+
+  glcEnable(GLC_USER_TRANSFORM_QSO);
+  if (!glcIsEnabled(GLC_USER_TRANSFORM_QSO)) {
+    printf("GLC_USER_TRANSFORM_QSO can not be enabled\n");
+    return -1;
+  }
+
+  glcDisable(GLC_GL_OBJECTS);
+  glcRenderStyle(GLC_LINE);
+  if (!checkError(GLC_NONE))
+    return -1;
+
+  /* Baseline : the glyphes are 32 pixels high */
+  loadTransform(32.f);
+  lines[0] = countLines();
+  measure(bounds[0], charBounds[0]);
+  if (!checkError(GLC_NONE))
+    return -1;
+
+  /* The modelview matrix is scaled by 2 */
+  loadTransform(64.f);
+  lines[1] = countLines();
+  measure(bounds[1], charBounds[1]);
+  if (!checkError(GLC_NONE))
+    return -1;
+
+  /* The initial transform is loaded back */
+  loadTransform(32.f);
+  lines[2] = countLines();
+  measure(bounds[2], charBounds[2]);
+  if (!checkError(GLC_NONE))
+    return -1;
+
+  printf("Lines : %d (x1) %d (x2) %d (x1)\n", lines[0], lines[1], lines[2]);
+
+  if ((lines[0] <= 0) || (lines[1] <= lines[0])) {
+    printf("The outlines are not subdivided according to the transform\n");
+    return -1;
+  }
+
+  if (lines[2] != lines[0]) {
+    printf("Loading the initial transform does not restore the outlines\n");
+    return -1;
+  }
+
+  /* The metrics are given in object space : they must not depend on the
+   * transform.
+   */
+  if (!compareBounds(bounds[0], bounds[1])
+      || !compareBounds(bounds[0], bounds[2])) {
+    printf("The bounds of the string depend on the transform\n");
+    return -1;
+  }
+
+  if (!compareBounds(charBounds[0], charBounds[1])
+      || !compareBounds(charBounds[0], charBounds[2])) {
+    printf("The bounds of the character depend on the transform\n");
+    return -1;
+  }
+
+  glcContext(0);
+  glcDeleteContext(ctx);
+
+  printf("Test successful!\n");
+  return 0;
+}
@@ -0,0 +1,291 @@
+/* QuesoGLC
+ * A free implementation of the OpenGL Character Renderer (GLC)
+ * Copyright (c) 2002, 2004-2009, Bertrand Coconnier
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+/* $Id$ */
+
+/** \file
+ * This test checks the text objects (glcGenTextObjectQSO(),
+ * glcCompileStringQSO(), glcCallTextObjectQSO() and glcDeleteTextObjectQSO()).
+ * For each rendering style, the primitives issued by glcCompileStringQSO()
+ * and glcCallTextObjectQSO() are recorded in GL feedback mode : compiling a
+ * string must not draw anything and calling the text object must draw the
+ * same primitives and move the pen as much as glcRenderString(), including
+ * after GLC_KERNING_QSO has been toggled.
+ */
+
+#include "GL/glc.h"
+#if defined __APPLE__ && defined __MACH__
+#include <GLUT/glut.h>
+#else
+#include <GL/glut.h>
+#endif
+#include <stdio.h>
+#include <math.h>
+
+#define FEEDBACK_SIZE	65536
+#define WIDTH		640
+#define HEIGHT		480
+#define STYLE_COUNT	5
+
+static const char* text = "AVATAR Wave";
+static GLfloat feedback[FEEDBACK_SIZE];
+
+static GLboolean checkError(GLCenum expected)
+{
+  GLCenum err = glcGetError();
+
+  if (err != expected) {
+    printf("Unexpected error 0x%X (expected 0x%X)\n", (int)err, (int)expected);
+    return GL_FALSE;
+  }
+
+  return GL_TRUE;
+}
+
+/* Reset the GL matrices and the raster position before a string is drawn */
+static void resetTransform(void)
+{
+  glMatrixMode(GL_PROJECTION);
+  glLoadIdentity();
+  glOrtho(0., WIDTH, 0., HEIGHT, -1., 1.);
+  glMatrixMode(GL_MODELVIEW);
+  glLoadIdentity();
+  glTranslatef(20.f, 200.f, 0.f);
+  glRasterPos2f(0.f, 0.f);
+  glScalef(24.f, 24.f, 1.f);
+}
+
+static void beginFeedback(void)
+{
+  resetTransform();
+  glFeedbackBuffer(FEEDBACK_SIZE, GL_2D, feedback);
+  glRenderMode(GL_FEEDBACK);
+}
+
+/* Leave the feedback mode and return the number of primitives that have been
+ * recorded. The pen position is returned in 'outPen'.
+ */
+static GLint endFeedback(GLfloat* outPen)
+{
+  GLfloat modelview[16];
+  GLint size = glRenderMode(GL_RENDER);
+  GLint count = 0;
+  GLint i = 0;
+
+  glGetFloatv(GL_MODELVIEW_MATRIX, modelview);
+  outPen[0] = modelview[12];
+  outPen[1] = modelview[13];
+
+  if (size < 0) {
+    printf("The feedback buffer overflowed\n");
+    return -1;
+  }
+
+  while (i < size) {
+    switch((GLint)feedback[i]) {
+    case GL_LINE_TOKEN:
+    case GL_LINE_RESET_TOKEN:
+      i += 5;
+      break;
+    case GL_POINT_TOKEN:
+    case GL_BITMAP_TOKEN:
+    case GL_DRAW_PIXEL_TOKEN:
+    case GL_COPY_PIXEL_TOKEN:
+      i += 3;
+      break;
+    case GL_PASS_THROUGH_TOKEN:
+      i += 2;
+      continue;
+    case GL_POLYGON_TOKEN:
+      i += 2 + 2 * (GLint)feedback[i+1];
+      break;
+    default:
+      printf("Unexpected feedback token %g\n", feedback[i]);
+      return -1;
+    }
+    count++;
+  }
+
+  return count;
+}
+
+/* Compile the string in the text object 'inTextObject' and check that the
+ * text object is rendered like glcRenderString() would do.
+ */
+static GLboolean checkTextObject(GLuint inTextObject, const char* inName)
+{
+  GLfloat pen[2][2];
+  GLint count[2] = {0, 0};
+
+  beginFeedback();
+  glcCompileStringQSO(inTextObject, text);
+  count[0] = endFeedback(pen[0]);
+  if (!checkError(GLC_NONE))
+    return GL_FALSE;
+
+  if (count[0]) {
+    printf("%s : glcCompileStringQSO() has drawn %d primitives\n", inName,
+	   count[0]);
+    return GL_FALSE;
+  }
+
+  beginFeedback();
+  glcCallTextObjectQSO(inTextObject);
+  count[0] = endFeedback(pen[0]);
+
+  beginFeedback();
+  glcRenderString(text);
+  count[1] = endFeedback(pen[1]);
+  if (!checkError(GLC_NONE))
+    return GL_FALSE;
+
+  printf("%s : %d primitives (text object) %d primitives (string)\n", inName,
+	 count[0], count[1]);
+
+  if ((count[0] <= 0) || (count[0] != count[1])) {
+    printf("%s : the text object is not rendered like the string\n", inName);
+    return GL_FALSE;
+  }
+
+  if ((fabs(pen[0][0] - pen[1][0]) > 1E-3)
+      || (fabs(pen[0][1] - pen[1][1]) > 1E-3)) {
+    printf("%s : the pen is moved to (%f, %f) instead of (%f, %f)\n", inName,
+	   pen[0][0], pen[0][1], pen[1][0], pen[1][1]);
+    return GL_FALSE;
+  }
+
+  return GL_TRUE;
+}
+
+/* Toggle the kerning and check that the pen is moved by the text object
+ * 'inTextObject' like by glcRenderString() with the new kerning.
+ */
+static GLboolean checkKerning(GLuint inTextObject, const char* inName)
+{
+  GLfloat pen[2][2];
+
+  if (glcIsEnabled(GLC_KERNING_QSO))
+    glcDisable(GLC_KERNING_QSO);
+  else
+    glcEnable(GLC_KERNING_QSO);
+
+  beginFeedback();
+  glcCallTextObjectQSO(inTextObject);
+  endFeedback(pen[0]);
+
+  beginFeedback();
+  glcRenderString(text);
+  endFeedback(pen[1]);
+  if (!checkError(GLC_NONE))
+    return GL_FALSE;
+
+  if ((fabs(pen[0][0] - pen[1][0]) > 1E-3)
+      || (fabs(pen[0][1] - pen[1][1]) > 1E-3)) {
+    printf("%s : the layout is not updated when the kerning changes\n",
+	   inName);
+    return GL_FALSE;
+  }
+
+  return GL_TRUE;
+}
+
+int main(int argc, char **argv)
+{
+  static const GLint styles[STYLE_COUNT] = {
+    GLC_BITMAP, GLC_PIXMAP_QSO, GLC_LINE, GLC_TEXTURE, GLC_TRIANGLE
+  };
+  static const char* names[STYLE_COUNT] = {
+    "GLC_BITMAP", "GLC_PIXMAP_QSO", "GLC_LINE", "GLC_TEXTURE", "GLC_TRIANGLE"
+  };
+  GLuint textObjects[STYLE_COUNT];
+  GLint ctx = 0;
+  GLint i = 0;
+
+  glutInit(&argc, argv);
+  glutInitDisplayMode(GLUT_SINGLE | GLUT_RGB);
+  glutInitWindowSize(WIDTH, HEIGHT);
+  glutCreateWindow("test22");
+  glViewport(0, 0, WIDTH, HEIGHT);
+
+  ctx = glcGenContext();
+  glcContext(ctx);
+  if (!checkError(GLC_NONE))
+    return -1;
+
+  /* Check the IDs that do not name a text object */
+  glcCompileStringQSO(0, text);
+  if (!checkError(GLC_PARAMETER_ERROR))
+    return -1;
+  glcCallTextObjectQSO(1);
+  if (!checkError(GLC_PARAMETER_ERROR))
+    return -1;
+  glcDeleteTextObjectQSO(1);
+  if (!checkError(GLC_PARAMETER_ERROR))
+    return -1;
+
+  for (i = 0; i < STYLE_COUNT; i++) {
+    textObjects[i] = glcGenTextObjectQSO();
+    if (!textObjects[i]) {
+      printf("The text object #%d can not be created\n", i);
+      return -1;
+    }
+    if (!checkError(GLC_NONE))
+      return -1;
+
+    glcRenderStyle(styles[i]);
+    if (!checkTextObject(textObjects[i], names[i]))
+      return -1;
+  }
+
+  /* The kerning is toggled before each text object is rendered : the layout
+   * of the text objects must follow it.
+   */
+  for (i = 0; i < STYLE_COUNT; i++) {
+    glcRenderStyle(styles[i]);
+    if (!checkKerning(textObjects[i], names[i]))
+      return -1;
+  }
+
+  /* A deleted text object can not be used anymore and its ID is recycled */
+  glcDeleteTextObjectQSO(textObjects[2]);
+  if (!checkError(GLC_NONE))
+    return -1;
+  glcDeleteTextObjectQSO(textObjects[2]);
+  if (!checkError(GLC_PARAMETER_ERROR))
+    return -1;
+  glcCompileStringQSO(textObjects[2], text);
+  if (!checkError(GLC_PARAMETER_ERROR))
+    return -1;
+  glcCallTextObjectQSO(textObjects[2]);
+  if (!checkError(GLC_PARAMETER_ERROR))
+    return -1;
+  glcCallTextObjectQSO(textObjects[STYLE_COUNT - 1] + 1);
+  if (!checkError(GLC_PARAMETER_ERROR))
+    return -1;
+
+  if (glcGenTextObjectQSO() != textObjects[2]) {
+    printf("The ID of the deleted text object is not recycled\n");
+    return -1;
+  }
+
+  glcContext(0);
+  glcDeleteContext(ctx);
+
+  printf("Test successful!\n");
+  return 0;
+}
@@ -0,0 +1,253 @@
+/* QuesoGLC
+ * A free implementation of the OpenGL Character Renderer (GLC)
+ * Copyright (c) 2002, 2004-2009, Bertrand Coconnier
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+/* $Id$ */
+
+/** \file
+ * This test checks glcRenderStringToBufferQSO(). The character 'I' is rendered
+ * in a GL_ALPHA buffer : the test checks that the covered pixels match the
+ * bounds of the character given by glcMeasureString() and that the center of
+ * its stem is covered. The same character is then rendered in a GL_RGBA
+ * buffer, in a top-down buffer (negative stride) and with an origin that
+ * makes the glyph be clipped : the results must match the GL_ALPHA buffer.
+ */
+
+#include "GL/glc.h"
+#if defined __APPLE__ && defined __MACH__
+#include <GLUT/glut.h>
+#else
+#include <GL/glut.h>
+#endif
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+#define WIDTH		96
+#define HEIGHT		96
+#define ORIGIN_X	32
+#define ORIGIN_Y	24
+#define SHIFT		8
+#define SIZE		48.f
+
+static const char* text = "I";
+static GLubyte alpha[HEIGHT][WIDTH];
+static GLubyte buffer[HEIGHT][WIDTH];
+static GLubyte rgba[HEIGHT][WIDTH][4];
+
+static GLboolean checkError(GLCenum expected)
+{
+  GLCenum err = glcGetError();
+
+  if (err != expected) {
+    printf("Unexpected error 0x%X (expected 0x%X)\n", (int)err, (int)expected);
+    return GL_FALSE;
+  }
+
+  return GL_TRUE;
+}
+
+/* Compute the box of the pixels of 'inBuffer' that are covered */
+static GLboolean coveredBox(GLubyte inBuffer[HEIGHT][WIDTH], GLint* outBox)
+{
+  GLboolean covered = GL_FALSE;
+  GLint i = 0, j = 0;
+
+  for (j = 0; j < HEIGHT; j++) {
+    for (i = 0; i < WIDTH; i++) {
+      if (!inBuffer[j][i])
+	continue;
+
+      if (!covered || (i < outBox[0]))
+	outBox[0] = i;
+      if (!covered || (j < outBox[1]))
+	outBox[1] = j;
+      if (!covered || (i > outBox[2]))
+	outBox[2] = i;
+      if (!covered || (j > outBox[3]))
+	outBox[3] = j;
+      covered = GL_TRUE;
+    }
+  }
+
+  return covered;
+}
+
+int main(int argc, char **argv)
+{
+  static const GLfloat red[4] = {1.f, 0.f, 0.f, 1.f};
+  GLfloat bounds[8];
+  GLfloat xMin = 0.f, yMin = 0.f, xMax = 0.f, yMax = 0.f;
+  GLint box[4] = {0, 0, 0, 0};
+  GLint ctx = 0;
+  GLint i = 0, j = 0;
+
+  glutInit(&argc, argv);
+  glutInitDisplayMode(GLUT_SINGLE | GLUT_RGB);
+  glutInitWindowSize(WIDTH, HEIGHT);
+  glutCreateWindow("test23");
+
+  ctx = glcGenContext();
+  glcContext(ctx);
+  if (!checkError(GLC_NONE))
+    return -1;
+
+  /* Check the errors of glcRenderStringToBufferQSO() */
+  glcRenderStringToBufferQSO(text, 0.f, 0.f, GL_LUMINANCE, WIDTH, HEIGHT,
+			     WIDTH, alpha, NULL);
+  if (!checkError(GLC_PARAMETER_ERROR))
+    return -1;
+  glcRenderStringToBufferQSO(text, 0.f, 0.f, GL_ALPHA, WIDTH, HEIGHT, WIDTH,
+			     NULL, NULL);
+  if (!checkError(GLC_PARAMETER_ERROR))
+    return -1;
+  glcRenderStringToBufferQSO(text, 0.f, 0.f, GL_ALPHA, -1, HEIGHT, WIDTH,
+			     alpha, NULL);
+  if (!checkError(GLC_PARAMETER_ERROR))
+    return -1;
+  glcRenderStringToBufferQSO(text, 0.f, 0.f, GL_RGBA, WIDTH, HEIGHT, WIDTH,
+			     rgba, NULL);
+  if (!checkError(GLC_PARAMETER_ERROR))
+    return -1;
+
+  /* The bounds are measured in pixels with the GLC_PIXMAP_QSO rendering
+   * style : the bitmap matrix is applied to them.
+   */
+  glcRenderStyle(GLC_PIXMAP_QSO);
+  glcScale(SIZE, SIZE);
+  glcMeasureString(GL_FALSE, text);
+  glcGetStringMetric(GLC_BOUNDS, bounds);
+  if (!checkError(GLC_NONE))
+    return -1;
+
+  xMin = xMax = bounds[0];
+  yMin = yMax = bounds[1];
+  for (i = 1; i < 4; i++) {
+    xMin = (bounds[2*i] < xMin) ? bounds[2*i] : xMin;
+    xMax = (bounds[2*i] > xMax) ? bounds[2*i] : xMax;
+    yMin = (bounds[2*i+1] < yMin) ? bounds[2*i+1] : yMin;
+    yMax = (bounds[2*i+1] > yMax) ? bounds[2*i+1] : yMax;
+  }
+
+  if ((xMax - xMin < 1.f) || (yMax - yMin < SIZE / 2.f)) {
+    printf("Unexpected bounds (%f, %f) (%f, %f)\n", xMin, yMin, xMax, yMax);
+    return -1;
+  }
+
+  /* The style is not changed by glcRenderStringToBufferQSO() */
+  glcRenderStyle(GLC_LINE);
+
+  /* GL_ALPHA buffer */
+  memset(alpha, 0, sizeof(alpha));
+  glcRenderStringToBufferQSO(text, ORIGIN_X, ORIGIN_Y, GL_ALPHA, WIDTH, HEIGHT,
+			     WIDTH, alpha, NULL);
+  if (!checkError(GLC_NONE))
+    return -1;
+
+  if (glcGeti(GLC_RENDER_STYLE) != GLC_LINE) {
+    printf("The rendering style has been modified\n");
+    return -1;
+  }
+
+  if (!coveredBox(alpha, box)) {
+    printf("No pixel has been rendered\n");
+    return -1;
+  }
+
+  printf("Bounds : (%f, %f) (%f, %f)\n", xMin + ORIGIN_X, yMin + ORIGIN_Y,
+	 xMax + ORIGIN_X, yMax + ORIGIN_Y);
+  printf("Pixels : (%d, %d) (%d, %d)\n", box[0], box[1], box[2] + 1,
+	 box[3] + 1);
+
+  /* The covered pixels must match the bounds within a pixel (the glyph is
+   * hinted by FreeType).
+   */
+  if ((fabs(box[0] - (xMin + ORIGIN_X)) > 1.5f)
+      || (fabs(box[1] - (yMin + ORIGIN_Y)) > 1.5f)
+      || (fabs(box[2] + 1 - (xMax + ORIGIN_X)) > 1.5f)
+      || (fabs(box[3] + 1 - (yMax + ORIGIN_Y)) > 1.5f)) {
+    printf("The glyph does not match its bounds\n");
+    return -1;
+  }
+
+  /* The center of the stem of 'I' must be covered */
+  if (alpha[(box[1] + box[3]) / 2][(box[0] + box[2]) / 2] < 192) {
+    printf("The center of the glyph is not covered (%d)\n",
+	   alpha[(box[1] + box[3]) / 2][(box[0] + box[2]) / 2]);
+    return -1;
+  }
+
+  /* GL_RGBA buffer : the red and alpha channels are the coverage */
+  memset(rgba, 0, sizeof(rgba));
+  glcRenderStringToBufferQSO(text, ORIGIN_X, ORIGIN_Y, GL_RGBA, WIDTH, HEIGHT,
+			     WIDTH * 4, rgba, red);
+  if (!checkError(GLC_NONE))
+    return -1;
+
+  for (j = 0; j < HEIGHT; j++) {
+    for (i = 0; i < WIDTH; i++) {
+      if ((rgba[j][i][0] != alpha[j][i]) || rgba[j][i][1] || rgba[j][i][2]
+	  || (rgba[j][i][3] != alpha[j][i])) {
+	printf("GL_RGBA : unexpected pixel at (%d, %d)\n", i, j);
+	return -1;
+      }
+    }
+  }
+
+  /* Top-down buffer : the rows are stored in the reverse order */
+  memset(buffer, 0, sizeof(buffer));
+  glcRenderStringToBufferQSO(text, ORIGIN_X, ORIGIN_Y, GL_ALPHA, WIDTH, HEIGHT,
+			     -WIDTH, buffer[HEIGHT - 1], NULL);
+  if (!checkError(GLC_NONE))
+    return -1;
+
+  for (j = 0; j < HEIGHT; j++) {
+    if (memcmp(buffer[HEIGHT - 1 - j], alpha[j], WIDTH)) {
+      printf("Top-down buffer : unexpected row %d\n", j);
+      return -1;
+    }
+  }
+
+  /* The glyph is clipped by the left and bottom edges of the buffer */
+  memset(buffer, 0, sizeof(buffer));
+  glcRenderStringToBufferQSO(text, box[0] - SHIFT, box[1] - SHIFT, GL_ALPHA,
+			     WIDTH, HEIGHT, WIDTH, buffer, NULL);
+  if (!checkError(GLC_NONE))
+    return -1;
+
+  for (j = 0; j < HEIGHT; j++) {
+    for (i = 0; i < WIDTH; i++) {
+      GLint x = i + ORIGIN_X - box[0] + SHIFT;
+      GLint y = j + ORIGIN_Y - box[1] + SHIFT;
+      GLubyte expected = 0;
+
+      if ((x < WIDTH) && (y < HEIGHT))
+	expected = alpha[y][x];
+
+      if (buffer[j][i] != expected) {
+	printf("Clipped glyph : unexpected pixel at (%d, %d)\n", i, j);
+	return -1;
+      }
+    }
+  }
+
+  glcContext(0);
+  glcDeleteContext(ctx);
+
+  printf("Test successful!\n");
+  return 0;
+}
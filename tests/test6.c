@@ -49,13 +49,20 @@ GLEWAPI GLEWContext* glewGetContext(void);
 #endif
 
 static GLCchar* __glcExtensions1 = (GLCchar*) "GLC_QSO_attrib_stack"
-  " GLC_QSO_extrude GLC_QSO_hinting GLC_QSO_kerning GLC_QSO_matrix_stack"
-  " GLC_QSO_render_parameter GLC_QSO_render_pixmap GLC_QSO_utf8"
+  " GLC_QSO_bitmap_cache GLC_QSO_composite_pixmap GLC_QSO_embedded_bitmap"
+  " GLC_QSO_extrude GLC_QSO_hinting GLC_QSO_hinting_profile GLC_QSO_kerning"
+  " GLC_QSO_matrix_stack GLC_QSO_render_buffer GLC_QSO_render_parameter"
+  " GLC_QSO_render_pixmap GLC_QSO_render_strings GLC_QSO_text_object"
+  " GLC_QSO_texture_budget GLC_QSO_user_transform GLC_QSO_utf8"
   " GLC_SGI_full_name";
 static GLCchar* __glcExtensions2 = (GLCchar*) "GLC_QSO_attrib_stack"
-  " GLC_QSO_buffer_object GLC_QSO_extrude GLC_QSO_hinting GLC_QSO_kerning"
-  " GLC_QSO_matrix_stack GLC_QSO_render_parameter GLC_QSO_render_pixmap"
-  " GLC_QSO_utf8 GLC_SGI_full_name";
+  " GLC_QSO_bitmap_cache GLC_QSO_buffer_object GLC_QSO_buffer_sub_data"
+  " GLC_QSO_composite_pixmap GLC_QSO_embedded_bitmap GLC_QSO_extrude"
+  " GLC_QSO_hinting GLC_QSO_hinting_profile GLC_QSO_kerning"
+  " GLC_QSO_matrix_stack GLC_QSO_render_buffer GLC_QSO_render_parameter"
+  " GLC_QSO_render_pixmap GLC_QSO_render_strings GLC_QSO_text_object"
+  " GLC_QSO_texture_budget GLC_QSO_user_transform GLC_QSO_utf8"
+  " GLC_SGI_full_name";
 static GLCchar* __glcRelease = (GLCchar*) QUESOGLC_VERSION;
 static GLCchar* __glcVendor = (GLCchar*) "The QuesoGLC Project";
 
@@ -341,6 +348,76 @@ int main(int argc, char **argv)
   if (!checkError(GLC_NONE))
     return -1;
 
+  if (!glcIsEnabled(GLC_BUFFER_SUB_DATA_QSO)) {
+    printf("GLC_BUFFER_SUB_DATA_QSO is disabled\n");
+    return -1;
+  }
+
+  if (!checkError(GLC_NONE))
+    return -1;
+
+  if (glcIsEnabled(GLC_COMPOSITE_PIXMAP_QSO)) {
+    printf("GLC_COMPOSITE_PIXMAP_QSO is enabled\n");
+    return -1;
+  }
+
+  if (!checkError(GLC_NONE))
+    return -1;
+
+  if (glcIsEnabled(GLC_USER_TRANSFORM_QSO)) {
+    printf("GLC_USER_TRANSFORM_QSO is enabled\n");
+    return -1;
+  }
+
+  if (!checkError(GLC_NONE))
+    return -1;
+
+  if (glcIsEnabled(GLC_EMBEDDED_BITMAP_QSO)) {
+    printf("GLC_EMBEDDED_BITMAP_QSO is enabled\n");
+    return -1;
+  }
+
+  if (!checkError(GLC_NONE))
+    return -1;
+
+  if (glcGeti(GLC_TEXTURE_BUDGET_QSO) != 8388608) {
+    printf("GLC_TEXTURE_BUDGET_QSO is %d\n", glcGeti(GLC_TEXTURE_BUDGET_QSO));
+    return -1;
+  }
+
+  if (!checkError(GLC_NONE))
+    return -1;
+
+  glcRenderParameteriQSO(GLC_TEXTURE_BUDGET_QSO, -1);
+  if (!checkError(GLC_PARAMETER_ERROR))
+    return -1;
+
+  if (glcGeti(GLC_BITMAP_CACHE_SIZE_QSO) != 1048576) {
+    printf("GLC_BITMAP_CACHE_SIZE_QSO is %d\n",
+	   glcGeti(GLC_BITMAP_CACHE_SIZE_QSO));
+    return -1;
+  }
+
+  if (!checkError(GLC_NONE))
+    return -1;
+
+  glcRenderParameteriQSO(GLC_BITMAP_CACHE_SIZE_QSO, -1);
+  if (!checkError(GLC_PARAMETER_ERROR))
+    return -1;
+
+  if (glcGeti(GLC_HINTING_PROFILE_QSO) != GLC_HINTING_FULL_AUTO_QSO) {
+    printf("GLC_HINTING_PROFILE_QSO is 0x%X\n",
+	   glcGeti(GLC_HINTING_PROFILE_QSO));
+    return -1;
+  }
+
+  if (!checkError(GLC_NONE))
+    return -1;
+
+  glcRenderParameteriQSO(GLC_HINTING_PROFILE_QSO, GLC_BITMAP);
+  if (!checkError(GLC_PARAMETER_ERROR))
+    return -1;
+
   maxStackDepth = glcGeti(GLC_MAX_ATTRIB_STACK_DEPTH_QSO);
   if (!checkError(GLC_NONE))
     return -1;